@@ -6,26 +6,111 @@
  ******************************************************************************/
 
 #pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <new>
+#include <numeric>
+#include <type_traits>
 
 namespace cpplib
 {
 
-// 根据size值确定区块可存储元素个数
-static constexpr size_t block_size(size_t size)
-{ return size < 512 ? 512 / size : 1; }
+// 不大于n的最大的2的幂，n为0时返回1
+constexpr std::size_t floor_pow2(std::size_t n)
+{ return n < 2 ? 1 : 2 * floor_pow2(n / 2); }
+
+// 不大于n的最大的2的幂的指数，n为0时返回0
+constexpr std::size_t floor_log2(std::size_t n)
+{ return n < 2 ? 0 : 1 + floor_log2(n / 2); }
+
+/**
+ * 按字节数指定区块大小的区块策略.
+ * 区块可存储的元素个数为Bytes / sizeof(E)向下取整到2的幂，至少为1，
+ * 这样双端队列的随机访问可以使用移位和掩码代替除法.
+ * Alignment为区块的对齐字节数，为0时使用分配器的默认对齐.
+ */
+template<std::size_t Bytes = 512, std::size_t Alignment = 0>
+struct BlockBytes
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+
+    // 区块可存储的元素个数
+    template<typename E>
+    static constexpr std::size_t block_size() { return floor_pow2(Bytes / sizeof(E)); }
+    // 区块的对齐字节数
+    static constexpr std::size_t alignment = Alignment;
+};
+
+/**
+ * 按元素个数指定区块大小的区块策略.
+ * 区块可存储的元素个数为Count，不要求是2的幂.
+ * Alignment为区块的对齐字节数，为0时使用分配器的默认对齐.
+ */
+template<std::size_t Count, std::size_t Alignment = 0>
+struct BlockElements
+{
+    static_assert(Count > 0, "Count must be positive");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+
+    // 区块可存储的元素个数
+    template<typename E>
+    static constexpr std::size_t block_size() { return Count; }
+    // 区块的对齐字节数
+    static constexpr std::size_t alignment = Alignment;
+};
 
 // 双端队列的随机访问迭代器
-template<typename E, typename Ptr, typename Ref>
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize>
 class DequeIterator;
 
+// 分段遍历双端队列迭代器范围内的每个连续区块范围
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize, typename Function>
+bool for_each_segment(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                      DequeIterator<E, Ptr, Ref, BlockSize> last, Function f);
+// 从后向前分段遍历双端队列迭代器范围内的每个连续区块范围
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize, typename Function>
+bool for_each_segment_backward(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                               DequeIterator<E, Ptr, Ref, BlockSize> last, Function f);
+// 以区块为单位在两个双端队列迭代器范围之间移动元素
+template<typename E, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+move(DequeIterator<E, E*, E&, BlockSize> first, DequeIterator<E, E*, E&, BlockSize> last,
+     DequeIterator<E, E*, E&, BlockSize> destination);
+template<typename E, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+move_backward(DequeIterator<E, E*, E&, BlockSize> first, DequeIterator<E, E*, E&, BlockSize> last,
+              DequeIterator<E, E*, E&, BlockSize> destination);
+// 以区块为单位构造双端队列迭代器范围内的元素
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+uninitialized_copy(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                   DequeIterator<E, Ptr, Ref, BlockSize> last,
+                   DequeIterator<E, E*, E&, BlockSize> destination);
+template<typename ForwardIterator, typename E, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+uninitialized_copy(ForwardIterator first, ForwardIterator last,
+                   DequeIterator<E, E*, E&, BlockSize> destination);
+template<typename E, std::size_t BlockSize>
+void uninitialized_fill(DequeIterator<E, E*, E&, BlockSize> first,
+                        DequeIterator<E, E*, E&, BlockSize> last, const E& value);
+// 以区块为单位比较两个双端队列迭代器范围
+template<typename E, typename Ptr1, typename Ref1, typename Ptr2, typename Ref2,
+         std::size_t BlockSize>
+bool equal(DequeIterator<E, Ptr1, Ref1, BlockSize> first1,
+           DequeIterator<E, Ptr1, Ref1, BlockSize> last1,
+           DequeIterator<E, Ptr2, Ref2, BlockSize> first2);
+
 /**
  * 使用模板实现的双端队列.
  * 由动态连续数组存储双端队列.
+ * 区块的大小和对齐方式由区块策略Policy在编译期确定.
  */
-template<typename E>
+template<typename E, typename Policy = BlockBytes<>>
 class Deque
 {
 public:
@@ -38,9 +123,12 @@ public:
     using size_type       = std::size_t;
     using difference_type = std::ptrdiff_t;
     using allocator_type  = std::allocator<E>;
+    using block_policy    = Policy;
+    // 区块大小
+    static constexpr size_type BLOCK_SIZE = Policy::template block_size<E>();
     // 迭代器定义
-    using iterator               = DequeIterator<E, E*, E&>;
-    using const_iterator         = DequeIterator<E, const E*, const E&>;
+    using iterator               = DequeIterator<E, E*, E&, BLOCK_SIZE>;
+    using const_iterator         = DequeIterator<E, const E*, const E&, BLOCK_SIZE>;
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 private:
@@ -57,14 +145,50 @@ private:
             typename std::iterator_traits<InputIterator>::iterator_category,
             std::input_iterator_tag>;
 
-    static constexpr size_type BLOCK_SIZE = block_size(sizeof(E)); // 区块大小
+    // 重复指向同一个值的前向迭代器，添加多个相同元素时作为迭代器范围使用
+    class RepeatIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = E;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const E*;
+        using reference         = const E&;
+
+        RepeatIterator(const E& value, size_type count) noexcept
+        : value(&value), count(count) {}
+        reference operator*() const noexcept { return *value; }
+        pointer operator->() const noexcept { return value; }
+        RepeatIterator& operator++() noexcept { ++count; return *this; }
+        RepeatIterator operator++(int) noexcept { RepeatIterator tmp(*this); ++count; return tmp; }
+        bool operator==(const RepeatIterator& that) const noexcept { return count == that.count; }
+        bool operator!=(const RepeatIterator& that) const noexcept { return count != that.count; }
+    private:
+        const E* value;  // 重复的值
+        size_type count; // 已经经过的元素个数
+    };
+
+    // 区块对齐字节数，为0时使用分配器的默认对齐
+    static constexpr size_type BLOCK_ALIGNMENT = Policy::alignment == 0 ? 0
+            : Policy::alignment < alignof(E) ? alignof(E)
+            : Policy::alignment < sizeof(void*) ? sizeof(void*) : Policy::alignment;
+    using is_aligned_block = std::integral_constant<bool, (BLOCK_ALIGNMENT > 0)>;
+    // 区块大小为2的幂时，随机访问使用移位和掩码代替除法和取模
+    using is_pow2_block = std::integral_constant<bool, (BLOCK_SIZE & (BLOCK_SIZE - 1)) == 0>;
+    static constexpr size_type BLOCK_SHIFT = floor_log2(BLOCK_SIZE);
+    static constexpr size_type BLOCK_MASK = BLOCK_SIZE - 1;
+
     static constexpr size_type DEFAULT_MAP_SIZE = 10; // 默认映射大小
+    static constexpr size_type DEFAULT_CACHE_SIZE = 4; // 默认缓存区块上限
+    static constexpr size_type GROWTH_STEP = 8; // 增量扩容时每次添加区块复制的映射个数
 public:
-    Deque() { initialize_map(0); }
+    Deque() : cache(nullptr), cache_size(0), cache_limit(DEFAULT_CACHE_SIZE),
+              incremental(false), shadow(nullptr)
+    { initialize_map(0); }
     explicit Deque(size_type count, const E& value = E());
     template<typename InputIterator, typename = enable_if_t<is_input_iterator<InputIterator>::value>>
-    Deque(InputIterator first, InputIterator last);
-    Deque(std::initializer_list<value_type> ilist);
+    Deque(InputIterator first, InputIterator last) : Deque() { insert_back(first, last); }
+    Deque(std::initializer_list<value_type> ilist) : Deque(ilist.begin(), ilist.end()) {}
     Deque(const Deque& that);
     Deque(Deque&& that) noexcept;
     ~Deque();
@@ -93,6 +217,18 @@ public:
     size_type max_size() const noexcept { return size_type(-1); }
     // 收缩双端队列，移除过剩容量
     void shrink_to_fit();
+    // 返回缓存的空闲区块数量
+    size_type block_cache_size() const noexcept { return cache_size; }
+    // 返回空闲区块缓存的上限
+    size_type block_cache_limit() const noexcept { return cache_limit; }
+    // 设置空闲区块缓存的上限，超出上限的空闲区块被释放
+    void set_block_cache_limit(size_type count);
+    // 释放所有缓存的空闲区块
+    void trim_block_cache();
+    // 判断是否增量扩容映射
+    bool incremental_growth() const noexcept { return incremental; }
+    // 设置是否增量扩容映射，关闭时立即完成正在进行的扩容
+    void set_incremental_growth(bool enable);
 
     // 返回const队首引用
     const E& front() const;
@@ -101,7 +237,7 @@ public:
     // 返回指定位置元素的const引用，带边界检查
     const E& at(size_type i) const;
     // 返回指定位置元素的const引用，无边界检查
-    const E& operator[](size_type i) const { return it_begin[i]; }
+    const E& operator[](size_type i) const { return locate(i, is_pow2_block()); }
     // 返回队首引用
     E& front() { return const_cast<E&>(static_cast<const Deque&>(*this).front()); }
     // 返回队尾引用
@@ -111,16 +247,40 @@ public:
     // 返回指定位置元素的引用，无边界检查
     E& operator[](size_type i) { return const_cast<E&>(static_cast<const Deque&>(*this)[i]); }
 
+    // 在队首直接构造元素
+    template<typename... Args>
+    void emplace_front(Args&&... args);
+    // 在队尾直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    // 在迭代器指定的位置直接构造元素
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
     // 添加元素到队首
-    void insert_front(E elem);
+    void insert_front(const E& elem) { emplace_front(elem); }
+    void insert_front(E&& elem) { emplace_front(std::move(elem)); }
+    // 添加迭代器范围内的元素到队首，保持元素原有的顺序
+    template<typename InputIterator, typename = enable_if_t<is_input_iterator<InputIterator>::value>>
+    void insert_front(InputIterator first, InputIterator last)
+    { insert_front(first, last, typename std::iterator_traits<InputIterator>::iterator_category()); }
     // 添加元素到队尾
-    void insert_back(E elem);
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
+    // 添加迭代器范围内的元素到队尾
+    template<typename InputIterator, typename = enable_if_t<is_input_iterator<InputIterator>::value>>
+    void insert_back(InputIterator first, InputIterator last)
+    { insert_back(first, last, typename std::iterator_traits<InputIterator>::iterator_category()); }
     // 添加元素到迭代器指定的位置
-    void insert(const_iterator pos, E elem);
+    void insert(const_iterator pos, E elem) { emplace(pos, std::move(elem)); }
     // 添加指定数量的元素到迭代器指定的位置
-    void insert(const_iterator pos, size_type count, E elem);
+    void insert(const_iterator pos, size_type count, const E& elem);
+    // 添加迭代器范围内的元素到迭代器指定的位置
+    template<typename InputIterator, typename = enable_if_t<is_input_iterator<InputIterator>::value>>
+    void insert(const_iterator pos, InputIterator first, InputIterator last)
+    { insert(pos, first, last, typename std::iterator_traits<InputIterator>::iterator_category()); }
     // 添加初始化列表里的元素到迭代器指定的位置
-    void insert(const_iterator pos, std::initializer_list<E> ilist);
+    void insert(const_iterator pos, std::initializer_list<E> ilist)
+    { insert(pos, ilist.begin(), ilist.end()); }
     // 队首元素出队
     void remove_front();
     // 队尾元素出队
@@ -136,9 +296,54 @@ public:
 private:
     // Note: 将map视为「Vector of blocks」，map的操作类似于Vector
     // 初始化映射
-    void initialize_map(size_type count);
-    // 重新安排映射的容量
-    void reserve_map(size_type new_count, bool at_front);
+    void initialize_map(size_type count, size_type offset = 0);
+    // 保证映射头部或尾部有足够的空闲位置
+    void reserve_map(size_type blocks_to_add, bool at_front);
+    // 在队首之前预留count个元素的区块，返回预留后的队首迭代器
+    iterator reserve_elements_at_front(size_type count);
+    // 在队尾之后预留count个元素的区块，返回预留后的尾迭代器
+    iterator reserve_elements_at_back(size_type count);
+    // 按迭代器类别添加迭代器范围内的元素到队首
+    template<typename InputIterator>
+    void insert_front(InputIterator first, InputIterator last, std::input_iterator_tag);
+    template<typename ForwardIterator>
+    void insert_front(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+    // 按迭代器类别添加迭代器范围内的元素到队尾
+    template<typename InputIterator>
+    void insert_back(InputIterator first, InputIterator last, std::input_iterator_tag);
+    template<typename ForwardIterator>
+    void insert_back(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+    // 按迭代器类别添加迭代器范围内的元素到迭代器指定的位置
+    template<typename InputIterator>
+    void insert(const_iterator pos, InputIterator first, InputIterator last,
+                std::input_iterator_tag);
+    template<typename ForwardIterator>
+    void insert(const_iterator pos, ForwardIterator first, ForwardIterator last,
+                std::forward_iterator_tag);
+    // 在位置i添加n个元素，移动i和size() - i中较少的一侧元素
+    template<typename ForwardIterator>
+    void insert_middle(size_type i, ForwardIterator first, ForwardIterator last, size_type n);
+    // 增量扩容映射，必要时开始迁移到影子映射，并推进迁移
+    void advance_growth();
+    // 复制至多count个区块映射到影子映射，全部复制后切换到影子映射
+    void copy_to_shadow(size_type count);
+    // 立即完成正在进行的增量扩容
+    void finish_growth()
+    { if (shadow != nullptr) copy_to_shadow(copy_end - copy_next); }
+    // 得到映射位置在影子映射中对应的位置
+    map_pointer shadow_block(map_pointer block) const noexcept
+    { return shadow + ((block - map) + shadow_shift); }
+    // 设置映射位置指向的区块，增量扩容时同步写入影子映射，
+    // 影子映射两端只为逐个添加的区块预留空闲位置，批量添加区块前必须先完成扩容
+    void set_map_block(map_pointer block, pointer p) noexcept
+    {
+        *block = p;
+        if (shadow != nullptr)
+        {
+            assert(shadow_block(block) >= shadow && shadow_block(block) < shadow + shadow_size);
+            *shadow_block(block) = p;
+        }
+    }
     // 添加区块到指定区块映射范围
     void insert_block(map_pointer block_begin, map_pointer block_end);
     // 添加区块到区块映射头部
@@ -151,8 +356,36 @@ private:
     void remove_block_at_front();
     // 移除区块映射尾部的区块
     void remove_block_at_back();
+    // 分配一个区块，优先从缓存中获取
+    pointer allocate_block();
+    // 回收一个区块，缓存未满时放入缓存
+    void deallocate_block(pointer block);
+    // 申请一个新区块，区块按区块策略对齐
+    pointer new_block() { return new_block(is_aligned_block()); }
+    pointer new_block(std::false_type)
+    { return allocator_traits::allocate(allocator, BLOCK_SIZE); }
+    pointer new_block(std::true_type);
+    // 释放一个区块
+    void delete_block(pointer block) { delete_block(block, is_aligned_block()); }
+    void delete_block(pointer block, std::false_type)
+    { allocator_traits::deallocate(allocator, block, BLOCK_SIZE); }
+    void delete_block(pointer block, std::true_type) { std::free(block); }
+    // 定位指定位置的元素
+    const E& locate(size_type i, std::true_type) const noexcept;
+    const E& locate(size_type i, std::false_type) const noexcept;
+    // 析构指定迭代器范围内的元素，平凡析构的类型不需要析构
+    void destroy(iterator first, iterator last)
+    { destroy(first, last, std::is_trivially_destructible<E>()); }
+    void destroy(iterator, iterator, std::true_type) noexcept {}
+    void destroy(iterator first, iterator last, std::false_type);
+    // 在未构造的区块上复制另一个区块布局相同的双端队列的元素
+    void copy_blocks(const Deque& that)
+    { copy_blocks(that, std::is_trivially_copyable<E>()); }
+    void copy_blocks(const Deque& that, std::true_type) noexcept;
+    void copy_blocks(const Deque& that, std::false_type)
+    { uninitialized_copy(that.cbegin(), that.cend(), it_begin); }
     // 检查迭代器是否合法
-    bool valid(size_type i) const { return i >= 0 && i < size(); }
+    bool valid(size_type i) const { return i < size(); }
     // // 得到allocator
     // allocator_type allocator const noexcept { return allocator_type(); }
     // // 得到map_allocator
@@ -162,10 +395,22 @@ private:
     map_pointer map;   // 区块映射
     iterator it_begin; // 队首迭代器
     iterator it_end;   // 队尾迭代器
+    map_pointer cache;     // 空闲区块缓存
+    size_type cache_size;  // 缓存的区块个数
+    size_type cache_limit; // 缓存区块个数上限
+    bool incremental;         // 是否增量扩容映射
+    map_pointer shadow;       // 增量扩容的影子映射，未在扩容时为空
+    size_type shadow_size;    // 影子映射大小
+    difference_type shadow_shift; // 映射位置到影子映射位置的偏移
+    map_pointer copy_next;    // 下一个待复制到影子映射的区块映射
+    map_pointer copy_end;     // 待复制区块映射的结束位置（不包含）
     allocator_type allocator;
     map_allocator_type map_allocator;
 };
 
+template<typename E, typename Policy>
+constexpr typename Deque<E, Policy>::size_type Deque<E, Policy>::BLOCK_SIZE;
+
 /**
  * 双端队列构造函数.
  * 创建并用指定值初始化指定容量的双端队列.
@@ -173,36 +418,29 @@ private:
  * @param count: 指定双端队列容量
  * @param value: 用于初始化双端队列的值，不指定时是默认构造的值
  */
-template<typename E>
-Deque<E>::Deque(size_type count, const E& value)
+template<typename E, typename Policy>
+Deque<E, Policy>::Deque(size_type count, const E& value)
+: cache(nullptr), cache_size(0), cache_limit(DEFAULT_CACHE_SIZE),
+  incremental(false), shadow(nullptr)
 {
     initialize_map(count);
     uninitialized_fill(it_begin, it_end, value);
 }
 
-/**
- * 双端队列构造函数，由初始化列表初始化双端队列.
- *
- * @param ilist: 初始化列表
- */
-template<typename E>
-Deque<E>::Deque(std::initializer_list<value_type> ilist)
-{
-
-}
-
 /**
  * 双端队列复制构造函数.
  * 复制另一个双端队列作为初始化的值.
  *
  * @param that: 被复制的双端队列
  */
-template<typename E>
-Deque<E>::Deque(const Deque& that)
+template<typename E, typename Policy>
+Deque<E, Policy>::Deque(const Deque& that)
+: cache(nullptr), cache_size(0), cache_limit(that.cache_limit),
+  incremental(that.incremental), shadow(nullptr)
 {
-    // 初始化满足that大小的映射
-    initialize_map(that.size());
-    uninitialized_copy(that.it_begin, that.it_end, it_begin);
+    // 初始化满足that大小的映射，队首在区块内的偏移与that相同
+    initialize_map(that.size(), that.it_begin.current - that.it_begin.head);
+    copy_blocks(that);
 }
 
 /**
@@ -211,39 +449,45 @@ Deque<E>::Deque(const Deque& that)
  *
  * @param that: 被移动的双端队列
  */
-template<typename E>
-Deque<E>::Deque(Deque&& that) noexcept
+template<typename E, typename Policy>
+Deque<E, Policy>::Deque(Deque&& that) noexcept
 {
     M = that.M;
     map = that.map;
     it_begin = that.it_begin;
     it_end = that.it_end;
+    cache = that.cache;
+    cache_size = that.cache_size;
+    cache_limit = that.cache_limit;
+    incremental = that.incremental;
+    shadow = that.shadow;
+    shadow_size = that.shadow_size;
+    shadow_shift = that.shadow_shift;
+    copy_next = that.copy_next;
+    copy_end = that.copy_end;
     that.map = nullptr; // 指向空指针，退出被析构
+    that.cache = nullptr;
+    that.cache_size = 0;
+    that.shadow = nullptr;
 }
 
 /**
  * 双端队列析构函数函数.
  */
-template<typename E>
-Deque<E>::~Deque()
+template<typename E, typename Policy>
+Deque<E, Policy>::~Deque()
 {
+    // 已被移动的双端队列不持有任何资源
+    if (map == nullptr)
+        return;
     // 析构掉所有区块内的元素
-    if (it_begin.block == it_end.block)
-        for (auto i = it_begin.current; i < it_end.current; ++i)
-            allocator_traits::destroy(allocator, i);
-    else
-    {
-        for (auto i = it_begin.current; i < it_begin.tail; ++i)
-            allocator_traits::destroy(allocator, i);
-        for (map_pointer block = it_begin.block + 1; block < it_end.block; ++block)
-            for (auto i = *block; i < *block + BLOCK_SIZE; ++i)
-                allocator_traits::destroy(allocator, i);
-        for (auto i = it_end.head; i < it_end.current; ++i)
-            allocator_traits::destroy(allocator, i);
-    }
-    // 移除所有的区块
+    destroy(it_begin, it_end);
+    // 移除所有的区块，并释放缓存的空闲区块
     remove_block(it_begin.block, it_end.block + 1);
+    trim_block_cache();
     // 释放映射空间
+    if (shadow != nullptr)
+        map_allocator_traits::deallocate(map_allocator, shadow, shadow_size);
     map_allocator_traits::deallocate(map_allocator, map, M);
 }
 
@@ -254,8 +498,8 @@ Deque<E>::~Deque()
  * @param that: Deque对象that
  * @return 当前Deque对象
  */
-template<typename E>
-Deque<E>& Deque<E>::operator=(Deque<E> that)
+template<typename E, typename Policy>
+Deque<E, Policy>& Deque<E, Policy>::operator=(Deque<E, Policy> that)
 {
     swap(that);
     return *this;
@@ -268,8 +512,8 @@ Deque<E>& Deque<E>::operator=(Deque<E> that)
  * @param ilist: 初始化列表
  * @return 当前Deque对象
  */
-template<typename E>
-Deque<E>& Deque<E>::operator=(std::initializer_list<value_type> ilist)
+template<typename E, typename Policy>
+Deque<E, Policy>& Deque<E, Policy>::operator=(std::initializer_list<value_type> ilist)
 {
     Deque tmp(ilist);
     // *this与tmp互相交换，退出时tmp被析构
@@ -280,12 +524,14 @@ Deque<E>& Deque<E>::operator=(std::initializer_list<value_type> ilist)
 /**
  * 收缩双端队列，移除过剩容量.
  */
-template<typename E>
-void Deque<E>::shrink_to_fit()
+template<typename E, typename Policy>
+void Deque<E, Policy>::shrink_to_fit()
 {
     // Note: g++在头尾区块的剩余容量之和大于一个区块时会选择收缩
     //       一个区块的容量，这个操作的代价很高昂.
-    //       因此这里选择仅释放多余的映射容量，不负责调整区块.
+    //       因此这里选择仅释放多余的映射容量和缓存的空闲区块，不负责调整区块.
+    finish_growth();
+    trim_block_cache();
     size_type new_count = it_end.block + 1 - it_begin.block + 2;
 
     map_pointer new_map = map_allocator_traits::allocate(map_allocator, new_count);
@@ -298,14 +544,76 @@ void Deque<E>::shrink_to_fit()
     it_end.set_block(map + M - 2);
 }
 
+/**
+ * 设置空闲区块缓存的上限.
+ * 超出新上限的空闲区块被立即释放，上限为0时关闭区块缓存.
+ *
+ * @param count: 缓存区块个数上限
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::set_block_cache_limit(size_type count)
+{
+    if (count < cache_size)
+    {
+        for (size_type i = count; i < cache_size; ++i)
+            delete_block(cache[i]);
+        cache_size = count;
+    }
+    if (cache != nullptr)
+    {
+        // 缓存数组按新上限重新分配
+        map_pointer new_cache = nullptr;
+        if (count > 0)
+        {
+            new_cache = map_allocator_traits::allocate(map_allocator, count);
+            std::copy(cache, cache + cache_size, new_cache);
+        }
+        map_allocator_traits::deallocate(map_allocator, cache, cache_limit);
+        cache = new_cache;
+    }
+    cache_limit = count;
+}
+
+/**
+ * 释放所有缓存的空闲区块.
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::trim_block_cache()
+{
+    if (cache == nullptr)
+        return;
+    for (size_type i = 0; i < cache_size; ++i)
+        delete_block(cache[i]);
+    map_allocator_traits::deallocate(map_allocator, cache, cache_limit);
+    cache = nullptr;
+    cache_size = 0;
+}
+
+/**
+ * 设置是否增量扩容映射.
+ * 增量扩容时，映射的扩容分摊到之后的多次添加区块中完成，
+ * 每次添加区块至多复制GROWTH_STEP个区块映射，
+ * 因此每次添加和移除元素的最坏情况都是O(1)的，代价是扩容期间额外占用一个影子映射.
+ * 关闭增量扩容时，立即完成正在进行的扩容.
+ *
+ * @param enable: 是否增量扩容映射
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::set_incremental_growth(bool enable)
+{
+    if (!enable)
+        finish_growth();
+    incremental = enable;
+}
+
 /**
  * 返回const队首引用.
  *
  * @return const队首引用
  * @throws std::out_of_range: 双端队列空
  */
-template<typename E>
-const E& Deque<E>::front() const
+template<typename E, typename Policy>
+const E& Deque<E, Policy>::front() const
 {
     if (empty())
         throw std::out_of_range("Deque::front");
@@ -318,8 +626,8 @@ const E& Deque<E>::front() const
  * @return const队尾引用
  * @throws std::out_of_range: 双端队列空
  */
-template<typename E>
-const E& Deque<E>::back() const
+template<typename E, typename Policy>
+const E& Deque<E, Policy>::back() const
 {
     if (empty())
         throw std::out_of_range("Deque::back");
@@ -332,8 +640,8 @@ const E& Deque<E>::back() const
  * @return 指定位置元素的const引用
  * @throws std::out_of_range: 索引不合法
  */
-template<typename E>
-const E& Deque<E>::at(size_type i) const
+template<typename E, typename Policy>
+const E& Deque<E, Policy>::at(size_type i) const
 {
     if (!valid(i))
         throw std::out_of_range("Deque::at");
@@ -341,104 +649,385 @@ const E& Deque<E>::at(size_type i) const
 }
 
 /**
- * 添加元素到队首.
- * 当双端队列达到最大容量，扩容双端队列到两倍容量后，再将元素入队.
+ * 定位双端队列指定位置的元素，区块大小为2的幂.
+ * 元素相对于队首区块头部的偏移由队首迭代器缓存的区块头部得到，
+ * 偏移的高位是区块序号，低位是区块内的位置，不需要构造临时迭代器和分支.
  *
- * @param elem: 要添加的元素
+ * @param i: 元素的索引
+ * @return 指定位置元素的const引用
+ */
+template<typename E, typename Policy>
+const E& Deque<E, Policy>::locate(size_type i, std::true_type) const noexcept
+{
+    size_type offset = i + (it_begin.current - it_begin.head);
+    return it_begin.block[offset >> BLOCK_SHIFT][offset & BLOCK_MASK];
+}
+
+/**
+ * 定位双端队列指定位置的元素，区块大小不是2的幂.
+ *
+ * @param i: 元素的索引
+ * @return 指定位置元素的const引用
  */
-template<typename E>
-void Deque<E>::insert_front(E elem)
+template<typename E, typename Policy>
+const E& Deque<E, Policy>::locate(size_type i, std::false_type) const noexcept
+{
+    size_type offset = i + (it_begin.current - it_begin.head);
+    return it_begin.block[offset / BLOCK_SIZE][offset % BLOCK_SIZE];
+}
+
+/**
+ * 在队首直接构造元素.
+ * 头迭代器区块满时，先添加新区块到区块映射头部，构造失败时移除该区块.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename Policy>
+template<typename... Args>
+void Deque<E, Policy>::emplace_front(Args&&... args)
 {
-    // 头迭代器区块满，则添加新区块到区块映射头部
     if (it_begin.current == it_begin.head)
         insert_block_at_front();
+    try
+    {
+        allocator_traits::construct(allocator, it_begin.current - 1, std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        if (it_begin.current == it_begin.tail)
+            remove_block_at_front();
+        throw;
+    }
     --it_begin.current;
-    allocator_traits::construct(allocator, it_begin.current, std::move(elem));
 }
 
 /**
- * 添加元素到队尾.
- * 当双端队列达到最大容量，扩容双端队列到两倍容量后，再将元素入队.
+ * 在队尾直接构造元素.
+ * 尾迭代器区块满时，添加新区块到区块映射尾部，添加失败时析构该元素.
  *
- * @param elem: 要添加的元素
+ * @param args: 用于构造元素的参数
  */
-template<typename E>
-void Deque<E>::insert_back(E elem)
+template<typename E, typename Policy>
+template<typename... Args>
+void Deque<E, Policy>::emplace_back(Args&&... args)
 {
-    allocator_traits::construct(allocator, it_end.current, std::move(elem));
-    ++it_end.current;
-    // 尾迭代器区块满，则添加新区块到区块映射尾部
-    if (it_end.current == it_end.tail)
+    allocator_traits::construct(allocator, it_end.current, std::forward<Args>(args)...);
+    if (it_end.current + 1 != it_end.tail)
+    {
+        ++it_end.current;
+        return;
+    }
+    try
+    {
         insert_block_at_back();
+    }
+    catch(...)
+    {
+        allocator_traits::destroy(allocator, it_end.current);
+        throw;
+    }
 }
 
 /**
- * 添加元素到双端队列迭代器指定的位置.
+ * 在迭代器指定的位置直接构造元素.
+ * 插入位置位于前半部分时前部元素前移，否则后部元素后移，
+ * 移动的元素个数为min(i, n - i).
  *
  * @param pos: 指向添加位置的迭代器
- * @param elem: 要添加的元素
+ * @param args: 用于构造元素的参数
+ * @return 指向新元素的迭代器
  */
-template<typename E>
-void Deque<E>::insert(const_iterator pos, E elem)
+template<typename E, typename Policy>
+template<typename... Args>
+typename Deque<E, Policy>::iterator
+Deque<E, Policy>::emplace(const_iterator pos, Args&&... args)
 {
-    if      (pos == it_begin) insert_front(std::move(elem));
-    else if (pos == it_end)   insert_back(std::move(elem));
+    size_type i = pos - cbegin();
+
+    if (i == 0)
+    {
+        emplace_front(std::forward<Args>(args)...);
+        return it_begin;
+    }
+    if (i == size())
+    {
+        emplace_back(std::forward<Args>(args)...);
+        return std::prev(it_end);
+    }
+    E elem(std::forward<Args>(args)...);
+    // 插入位置位于前半部分，则元素前移
+    if (i < (size() >> 1))
+    {
+        // 用头部添加的方式预先安排好区块分配，并前移头部元素
+        emplace_front(std::move(front()));
+        move(it_begin + 2, it_begin + (i + 1), it_begin + 1);
+    }
+    // 插入位置位于后半部分，则元素后移
     else
     {
-        // 插入位置位于前半部分，则元素前移
-        if (pos - it_begin < (size() >> 1))
-        {
-            // 用头部添加的方式预先安排好区块分配，并前移头部元素
-            insert_front(front());
-            std::copy(std::next(it_begin, 2), pos, std::next(it_begin));
-            // 这时pos指向和原迭代器偏移相同的位置
-            pos = std::prev(pos);
-        }
-        // 插入位置位于后半部分，则元素后移
-        else
-        {
-            // 用尾部添加的方式预先安排好区块分配，并后移尾部元素
-            insert_back(back());
-            std::copy_backward(pos, std::prev(it_end, 2), std::prev(it_end));
-        }
-        *pos = std::move(elem);
+        // 用尾部添加的方式预先安排好区块分配，并后移尾部元素
+        emplace_back(std::move(back()));
+        move_backward(it_begin + i, it_end - 2, it_end - 1);
     }
+    iterator position = it_begin + i;
+    *position = std::move(elem);
+    return position;
 }
 
 /**
- * 添加指定数量的元素到迭代器指定的位置.
+ * 添加迭代器范围内的元素到队首，单遍迭代器.
+ * 单遍迭代器无法预先得到元素个数，先移动到临时双端队列中再整体添加.
  *
- * @param pos: 指向添加位置的迭代器
- * @param count: 添加的元素数量
- * @param elem: 要添加的元素
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
  */
-template<typename E>
-void Deque<E>::insert(const_iterator pos, size_type count, E elem)
+template<typename E, typename Policy>
+template<typename InputIterator>
+void Deque<E, Policy>::insert_front(InputIterator first, InputIterator last,
+                                    std::input_iterator_tag)
 {
-    if (pos == it_begin)
-    {
+    Deque tmp(first, last);
+    insert_front(std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()),
+                 std::forward_iterator_tag());
+}
+
+/**
+ * 添加迭代器范围内的元素到队首，前向迭代器.
+ * 一次预留所有需要的区块，然后在区块上直接构造元素.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ */
+template<typename E, typename Policy>
+template<typename ForwardIterator>
+void Deque<E, Policy>::insert_front(ForwardIterator first, ForwardIterator last,
+                                    std::forward_iterator_tag)
+{
+    iterator new_begin = reserve_elements_at_front(std::distance(first, last));
 
+    try
+    {
+        uninitialized_copy(first, last, new_begin);
     }
-    else if (pos == it_end)
+    catch(...)
     {
+        remove_block(new_begin.block, it_begin.block);
+        throw;
+    }
+    it_begin = new_begin;
+}
+
+/**
+ * 添加迭代器范围内的元素到队尾，单遍迭代器.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ */
+template<typename E, typename Policy>
+template<typename InputIterator>
+void Deque<E, Policy>::insert_back(InputIterator first, InputIterator last,
+                                   std::input_iterator_tag)
+{
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+/**
+ * 添加迭代器范围内的元素到队尾，前向迭代器.
+ * 一次预留所有需要的区块，然后在区块上直接构造元素.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ */
+template<typename E, typename Policy>
+template<typename ForwardIterator>
+void Deque<E, Policy>::insert_back(ForwardIterator first, ForwardIterator last,
+                                   std::forward_iterator_tag)
+{
+    iterator new_end = reserve_elements_at_back(std::distance(first, last));
 
+    try
+    {
+        uninitialized_copy(first, last, it_end);
     }
-    else
+    catch(...)
     {
+        remove_block(it_end.block + 1, new_end.block + 1);
+        throw;
+    }
+    it_end = new_end;
+}
 
+/**
+ * 添加指定数量的元素到迭代器指定的位置.
+ *
+ * @param pos: 指向添加位置的迭代器
+ * @param count: 添加的元素数量
+ * @param elem: 要添加的元素
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::insert(const_iterator pos, size_type count, const E& elem)
+{
+    // elem可能引用双端队列内会被移动的元素，先复制一份
+    E value(elem);
+    insert(pos, RepeatIterator(value, 0), RepeatIterator(value, count),
+           std::forward_iterator_tag());
+}
+
+/**
+ * 添加迭代器范围内的元素到迭代器指定的位置，单遍迭代器.
+ * 先移动到临时双端队列中得到元素个数，再整体添加.
+ *
+ * @param pos: 指向添加位置的迭代器
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ */
+template<typename E, typename Policy>
+template<typename InputIterator>
+void Deque<E, Policy>::insert(const_iterator pos, InputIterator first, InputIterator last,
+                              std::input_iterator_tag)
+{
+    if (pos == cend())
+        insert_back(first, last, std::input_iterator_tag());
+    else
+    {
+        Deque tmp(first, last);
+        insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()),
+               std::forward_iterator_tag());
     }
 }
 
 /**
- * 添加初始化列表里的元素到迭代器指定的位置.
+ * 添加迭代器范围内的元素到迭代器指定的位置，前向迭代器.
+ * 在两端添加时直接在预留的区块上构造，否则移动较少的一侧.
  *
  * @param pos: 指向添加位置的迭代器
- * @param ilist: 初始化列表
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
  */
-template<typename E>
-void Deque<E>::insert(const_iterator pos, std::initializer_list<E> ilist)
+template<typename E, typename Policy>
+template<typename ForwardIterator>
+void Deque<E, Policy>::insert(const_iterator pos, ForwardIterator first, ForwardIterator last,
+                              std::forward_iterator_tag)
 {
+    if (pos == cbegin())
+        insert_front(first, last, std::forward_iterator_tag());
+    else if (pos == cend())
+        insert_back(first, last, std::forward_iterator_tag());
+    else
+        insert_middle(pos - cbegin(), first, last, std::distance(first, last));
+}
 
+/**
+ * 在位置i添加[first, last)范围内的n个元素.
+ * 位置i之前的元素较少时，在队首预留n个位置，前部的i个元素前移n个位置；
+ * 否则在队尾预留n个位置，后部的size() - i个元素后移n个位置.
+ * 移动按区块分段进行，移出到预留区块的元素直接移动构造，
+ * 因此代价为O(min(i, size() - i) + n).
+ *
+ * @param i: 添加位置的索引
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ * @param n: 添加的元素个数
+ */
+template<typename E, typename Policy>
+template<typename ForwardIterator>
+void Deque<E, Policy>::insert_middle(size_type i, ForwardIterator first, ForwardIterator last,
+                                     size_type n)
+{
+    if (n == 0)
+        return;
+    if (i < size() - i)
+    {
+        iterator new_begin = reserve_elements_at_front(n);
+        iterator old_begin = it_begin;
+        iterator position = it_begin + i;
+        try
+        {
+            // 前部元素多于n个，前n个移动到预留位置，其余前移n个位置
+            if (i >= n)
+            {
+                iterator begin_n = it_begin + n;
+                uninitialized_copy(std::make_move_iterator(it_begin),
+                                   std::make_move_iterator(begin_n), new_begin);
+                it_begin = new_begin;
+                move(begin_n, position, old_begin);
+                std::copy(first, last, position - n);
+            }
+            // 否则前部元素全部移动到预留位置，新元素一部分构造在预留位置
+            else
+            {
+                ForwardIterator mid = first;
+                std::advance(mid, n - i);
+                iterator constructed = uninitialized_copy(std::make_move_iterator(it_begin),
+                                                          std::make_move_iterator(position),
+                                                          new_begin);
+                try
+                {
+                    uninitialized_copy(first, mid, constructed);
+                }
+                catch(...)
+                {
+                    destroy(new_begin, constructed);
+                    throw;
+                }
+                it_begin = new_begin;
+                std::copy(mid, last, old_begin);
+            }
+        }
+        catch(...)
+        {
+            // 预留的区块尚未使用时回收，元素移动构造后的异常只保证基本的异常安全
+            if (it_begin != new_begin)
+                remove_block(new_begin.block, old_begin.block);
+            throw;
+        }
+    }
+    else
+    {
+        size_type elems_after = size() - i;
+        iterator new_end = reserve_elements_at_back(n);
+        iterator old_end = it_end;
+        iterator position = it_begin + i;
+        try
+        {
+            // 后部元素多于n个，后n个移动到预留位置，其余后移n个位置
+            if (elems_after > n)
+            {
+                iterator end_n = it_end - n;
+                uninitialized_copy(std::make_move_iterator(end_n),
+                                   std::make_move_iterator(it_end), it_end);
+                it_end = new_end;
+                move_backward(position, end_n, old_end);
+                std::copy(first, last, position);
+            }
+            // 否则后部元素全部移动到预留位置，新元素一部分构造在预留位置
+            else
+            {
+                ForwardIterator mid = first;
+                std::advance(mid, elems_after);
+                iterator constructed = uninitialized_copy(mid, last, it_end);
+                try
+                {
+                    uninitialized_copy(std::make_move_iterator(position),
+                                       std::make_move_iterator(it_end), constructed);
+                }
+                catch(...)
+                {
+                    destroy(it_end, constructed);
+                    throw;
+                }
+                it_end = new_end;
+                std::copy(first, mid, position);
+            }
+        }
+        catch(...)
+        {
+            if (it_end != new_end)
+                remove_block(old_end.block + 1, new_end.block + 1);
+            throw;
+        }
+    }
 }
 
 /**
@@ -447,8 +1036,8 @@ void Deque<E>::insert(const_iterator pos, std::initializer_list<E> ilist)
  *
  * @throws std::out_of_range: 双端队列空
  */
-template<typename E>
-void Deque<E>::remove_front()
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove_front()
 {
     if (empty())
         throw std::out_of_range("Deque::remove_front");
@@ -464,8 +1053,8 @@ void Deque<E>::remove_front()
  *
  * @throws std::out_of_range: 双端队列空
  */
-template<typename E>
-void Deque<E>::remove_back()
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove_back()
 {
     if (empty())
         throw std::out_of_range("Deque::remove_back");
@@ -479,34 +1068,55 @@ void Deque<E>::remove_back()
  * 移除双端队列迭代器指定位置的元素.
  *
  * @param pos: 指向移除位置的迭代器
+ * @throws std::out_of_range: 迭代器不指向双端队列内的元素
  */
-template<typename E>
-void Deque<E>::remove(const_iterator pos)
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove(const_iterator pos)
 {
-    // 移除位置位于前半部分，则元素前移
-    if (pos - it_begin < difference_type(size() >> 1))
-    {
-        std::copy_backward(it_begin, pos, std::next(it_begin));
-        remove_front();
-    }
-    // 移除位置位于后半部分，则元素后移
-    else
-    {
-        std::copy(std::next(pos), it_end, pos);
-        remove_back();
-    }
+    difference_type i = pos - cbegin();
+
+    if (i < 0 || !valid(size_type(i)))
+        throw std::out_of_range("Deque::remove");
+    remove(pos, std::next(pos));
 }
 
 /**
  * 移除双端队列指定迭代器范围内的所有元素.
+ * 移除范围之前的元素较少时，前部元素后移，否则后部元素前移，
+ * 移动按区块分段进行，移动后变空的区块被回收，
+ * 因此代价为O(min(i, size() - i - n) + n)，i为移除位置，n为移除的元素个数.
  *
  * @param first: 指向头部移除位置的迭代器（包含）
  * @param last: 指向尾部移除位置的迭代器（不包含）
+ * @throws std::out_of_range: 迭代器范围不在双端队列内
  */
-template<typename E>
-void Deque<E>::remove(const_iterator first, const_iterator last)
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove(const_iterator first, const_iterator last)
 {
-
+    difference_type i = first - cbegin();
+    difference_type n = last - first;
+
+    if (i < 0 || n < 0 || size_type(i + n) > size())
+        throw std::out_of_range("Deque::remove");
+    if (n == 0)
+        return;
+    iterator position = it_begin + i;
+    // 移除范围之前的元素较少，则前部元素后移
+    if (size_type(i) < (size() - n) / 2)
+    {
+        iterator new_begin = move_backward(it_begin, position, position + n);
+        destroy(it_begin, new_begin);
+        remove_block(it_begin.block, new_begin.block);
+        it_begin = new_begin;
+    }
+    // 否则后部元素前移
+    else
+    {
+        iterator new_end = move(position + n, it_end, position);
+        destroy(new_end, it_end);
+        remove_block(new_end.block + 1, it_end.block + 1);
+        it_end = new_end;
+    }
 }
 
 /**
@@ -514,43 +1124,41 @@ void Deque<E>::remove(const_iterator first, const_iterator last)
  *
  * @param that: Deque对象that
  */
-template<typename E>
-void Deque<E>::swap(Deque<E>& that)
+template<typename E, typename Policy>
+void Deque<E, Policy>::swap(Deque<E, Policy>& that)
 {
     using std::swap;
     swap(M, that.M);
     swap(map, that.map);
     swap(it_begin, that.it_begin);
     swap(it_end, that.it_end);
+    swap(cache, that.cache);
+    swap(cache_size, that.cache_size);
+    swap(cache_limit, that.cache_limit);
+    swap(incremental, that.incremental);
+    swap(shadow, that.shadow);
+    swap(shadow_size, that.shadow_size);
+    swap(shadow_shift, that.shadow_shift);
+    swap(copy_next, that.copy_next);
+    swap(copy_end, that.copy_end);
 }
 
 /**
  * 清空该双端队列元素.
  */
-template<typename E>
-void Deque<E>::clear()
+template<typename E, typename Policy>
+void Deque<E, Policy>::clear()
 {
+    finish_growth();
     map_pointer central_block = map + M / 2;
+
     // 析构掉所有区块内的元素
-    if (it_begin.block == it_end.block)
-    {
-        for (auto i = it_begin.current; i < it_end.current; ++i)
-            allocator_traits::destroy(allocator, i);
-    }
-    else
-    {
-        for (auto i = it_begin.current; i < it_begin.tail; ++i)
-            allocator_traits::destroy(allocator, i);
-        for (map_pointer block = it_begin.block + 1; block < it_end.block; ++block)
-            for (auto i = *block; i < *block + BLOCK_SIZE; ++i)
-                allocator_traits::destroy(allocator, i);
-        for (auto i = it_end.head; i < it_end.current; ++i)
-            allocator_traits::destroy(allocator, i);
-    }
-    // 移除[it_begin.block, it_end.block)范围的区块空间
+    destroy(it_begin, it_end);
+    // 移除[it_begin.block, it_end.block)范围的区块空间，放入区块缓存
     remove_block(it_begin.block, it_end.block);
     // 最后一个区块映射放到映射中央
-    std::swap(central_block, it_end.block);
+    *central_block = *it_end.block;
+    it_end = iterator(central_block, *central_block);
     it_begin = it_end;
 }
 
@@ -560,12 +1168,13 @@ void Deque<E>::clear()
  * 初始化后的映射指向的区块是未构造的.
  *
  * @param count: 元素容量
+ *        offset: 队首在第一个区块内的偏移，需小于BLOCK_SIZE
  */
-template<typename E>
-void Deque<E>::initialize_map(size_type count)
+template<typename E, typename Policy>
+void Deque<E, Policy>::initialize_map(size_type count, size_type offset)
 {
     // 满足指定容量所需的最少区块数
-    size_type num_blocks = count / BLOCK_SIZE + 1;
+    size_type num_blocks = (offset + count) / BLOCK_SIZE + 1;
     // 映射容量为num_blocks + 2和DEFAULT_MAP_SIZE中的较大值
     M = std::max(num_blocks + 2, size_type(DEFAULT_MAP_SIZE));
     map = map_allocator_traits::allocate(map_allocator, M);
@@ -574,34 +1183,163 @@ void Deque<E>::initialize_map(size_type count)
     map_pointer block_end = block_begin + num_blocks;
     // 分配区块，区块映射位于中央位置，便于向两端扩展
     insert_block(block_begin, block_end);
-    it_begin = iterator(block_begin, *block_begin);
-    it_end = iterator(block_end - 1, *(block_end - 1) + count % BLOCK_SIZE);
+    it_begin = iterator(block_begin, *block_begin + offset);
+    it_end = iterator(block_end - 1, *(block_end - 1) + (offset + count) % BLOCK_SIZE);
 }
 
 /**
- * 重新安排映射的容量.
+ * 保证映射头部或尾部至少有blocks_to_add个空闲位置.
+ * 映射的空闲位置足够时，将区块映射平移回映射中央，否则才扩容映射.
+ * 平移后两端各保留约1/4的映射容量，下一次平移前至少还能添加同样多的区块，
+ * 因此平移的代价均摊到每次添加区块是O(1)的.
  *
- * @param new_count: 新的映射容量
- * @param at_front: 标识是否将新增的容量安排在映射头部
+ * @param blocks_to_add: 需要添加的区块个数
+ * @param at_front: 标识是否在映射头部添加区块
  */
-template<typename E>
-void Deque<E>::reserve_map(size_type new_count, bool at_front)
+template<typename E, typename Policy>
+void Deque<E, Policy>::reserve_map(size_type blocks_to_add, bool at_front)
 {
-    // 如果新的容量小于当前映射容量，则映射不改变
-    if (new_count > M)
+    // 增量扩容来不及完成时，先同步完成扩容
+    finish_growth();
+    if (at_front ? size_type(it_begin.block - map) >= blocks_to_add
+                 : size_type(map + M - 1 - it_end.block) >= blocks_to_add)
+        return;
+
+    size_type old_num_blocks = it_end.block - it_begin.block + 1;
+    size_type new_num_blocks = old_num_blocks + blocks_to_add;
+    map_pointer new_block_begin;
+
+    // 映射至少一半空闲，则平移区块映射到映射中央，映射容量不变
+    if (M >= 2 * new_num_blocks)
     {
+        new_block_begin = map + (M - new_num_blocks) / 2
+                        + (at_front ? blocks_to_add : 0);
+        // 平移前后的范围可能重叠，需按方向选择复制顺序
+        if (new_block_begin < it_begin.block)
+            std::copy(it_begin.block, it_end.block + 1, new_block_begin);
+        else
+            std::copy_backward(it_begin.block, it_end.block + 1,
+                               new_block_begin + old_num_blocks);
+    }
+    // 否则扩容映射，区块映射同样位于新映射的中央
+    else
+    {
+        size_type new_count = M + std::max(M, blocks_to_add) + 2;
         map_pointer new_map = map_allocator_traits::allocate(map_allocator, new_count);
-        // 如果at_front，则将新增容量安排在映射头部，否则头部剩余容量不变
-        map_pointer new_block_begin = new_map + (it_begin.block - map)
-                                     + (at_front ? new_count - M : 0);
+
+        new_block_begin = new_map + (new_count - new_num_blocks) / 2
+                        + (at_front ? blocks_to_add : 0);
         // 复制区块映射指针到新的映射，不改变区块
         std::copy(it_begin.block, it_end.block + 1, new_block_begin);
         map_allocator_traits::deallocate(map_allocator, map, M);
         map = new_map;
         M = new_count;
-        it_begin.set_block(new_block_begin);
-        it_end.set_block(new_block_begin + size() - 1);
     }
+    it_begin.set_block(new_block_begin);
+    it_end.set_block(new_block_begin + old_num_blocks - 1);
+}
+
+/**
+ * 增量扩容映射.
+ * 映射任意一端的空闲位置少于区块数的1/GROWTH_STEP时，
+ * 分配影子映射并开始迁移，区块映射位于影子映射的中央.
+ * 之后每次添加区块复制GROWTH_STEP个区块映射，
+ * 迁移期间对映射的写入同步到影子映射，迁移在映射一端用完之前完成.
+ * 影子映射两端只预留reserved个空闲位置，足够迁移期间逐个添加的区块，
+ * 批量添加区块不调用本函数，而是先完成迁移.
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::advance_growth()
+{
+    if (shadow == nullptr)
+    {
+        size_type num_blocks = it_end.block - it_begin.block + 1;
+        size_type reserved = num_blocks / GROWTH_STEP + 2;
+        if (size_type(it_begin.block - map) >= reserved
+                && size_type(map + M - 1 - it_end.block) >= reserved)
+            return;
+        // 影子映射两端至少保留reserved个空闲位置，容纳迁移期间添加的区块
+        size_type new_num_blocks = num_blocks + 2 * reserved;
+        shadow_size = M >= 2 * new_num_blocks ? M : M + std::max(M, new_num_blocks) + 2;
+        shadow = map_allocator_traits::allocate(map_allocator, shadow_size);
+        shadow_shift = difference_type((shadow_size - num_blocks) / 2)
+                     - (it_begin.block - map);
+        copy_next = it_begin.block;
+        copy_end = it_end.block + 1;
+    }
+    copy_to_shadow(GROWTH_STEP);
+}
+
+/**
+ * 复制至多count个待复制的区块映射到影子映射.
+ * 全部复制完成后，释放原映射并切换到影子映射.
+ *
+ * @param count: 复制的区块映射个数上限
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::copy_to_shadow(size_type count)
+{
+    size_type n = std::min(count, size_type(copy_end - copy_next));
+
+    std::copy(copy_next, copy_next + n, shadow_block(copy_next));
+    copy_next += n;
+    if (copy_next != copy_end)
+        return;
+    it_begin.set_block(shadow_block(it_begin.block));
+    it_end.set_block(shadow_block(it_end.block));
+    map_allocator_traits::deallocate(map_allocator, map, M);
+    map = shadow;
+    M = shadow_size;
+    shadow = nullptr;
+}
+
+/**
+ * 在队首之前预留可容纳count个元素的区块.
+ * 正在增量扩容时先完成扩容，映射头部空闲位置不足时一次平移或扩容映射，预留的区块是未构造的.
+ *
+ * @param count: 预留的元素个数
+ * @return 预留后的队首迭代器，此时尚未更新it_begin
+ */
+template<typename E, typename Policy>
+typename Deque<E, Policy>::iterator
+Deque<E, Policy>::reserve_elements_at_front(size_type count)
+{
+    size_type vacancies = it_begin.current - it_begin.head;
+
+    if (count > vacancies)
+    {
+        size_type blocks_to_add = (count - vacancies + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        // 影子映射只为逐个添加的区块预留了空闲位置，批量添加前先完成增量扩容
+        finish_growth();
+        if (size_type(it_begin.block - map) < blocks_to_add)
+            reserve_map(blocks_to_add, true);
+        insert_block(it_begin.block - blocks_to_add, it_begin.block);
+    }
+    return it_begin - difference_type(count);
+}
+
+/**
+ * 在队尾之后预留可容纳count个元素的区块.
+ * 正在增量扩容时先完成扩容，映射尾部空闲位置不足时一次平移或扩容映射，预留的区块是未构造的.
+ *
+ * @param count: 预留的元素个数
+ * @return 预留后的尾迭代器，此时尚未更新it_end
+ */
+template<typename E, typename Policy>
+typename Deque<E, Policy>::iterator
+Deque<E, Policy>::reserve_elements_at_back(size_type count)
+{
+    size_type blocks_to_add = (it_end.current - it_end.head + count) / BLOCK_SIZE;
+
+    if (blocks_to_add > 0)
+    {
+        // 影子映射只为逐个添加的区块预留了空闲位置，批量添加前先完成增量扩容
+        finish_growth();
+        if (size_type(map + M - 1 - it_end.block) < blocks_to_add)
+            reserve_map(blocks_to_add, false);
+        insert_block(it_end.block + 1, it_end.block + 1 + blocks_to_add);
+    }
+    return it_end + difference_type(count);
 }
 
 /**
@@ -611,19 +1349,20 @@ void Deque<E>::reserve_map(size_type new_count, bool at_front)
  * @param block_begin: 区块起始位置（包含）
  * @param block_end: 区块结束位置（不包含）
  */
-template<typename E>
-void Deque<E>::insert_block(map_pointer block_begin, map_pointer block_end)
+template<typename E, typename Policy>
+void Deque<E, Policy>::insert_block(map_pointer block_begin, map_pointer block_end)
 {
     map_pointer i;
     // Note: commit or rollback
     try
     {
         for (i = block_begin; i < block_end; ++i)
-            *i = allocator_traits::allocate(allocator, BLOCK_SIZE);
+            set_map_block(i, allocate_block());
     }
     catch(...)
     {
         remove_block(block_begin, i);
+        throw;
     }
 }
 
@@ -631,13 +1370,15 @@ void Deque<E>::insert_block(map_pointer block_begin, map_pointer block_end)
  * 添加区块到区块映射头部.
  * 添加的区块是未构造的.
  */
-template<typename E>
-void Deque<E>::insert_block_at_front()
+template<typename E, typename Policy>
+void Deque<E, Policy>::insert_block_at_front()
 {
-    // 头部映射满，则扩容映射到两倍，新增容量安排在头部
+    if (incremental)
+        advance_growth();
+    // 头部映射满，则平移或扩容映射
     if (it_begin.block == map)
-        reserve_map(2 * M, true);
-    *(it_begin.block - 1) = allocator_traits::allocate(allocator, BLOCK_SIZE);
+        reserve_map(1, true);
+    set_map_block(it_begin.block - 1, allocate_block());
     // 重置头迭代器的指向
     it_begin.set_block(it_begin.block - 1);
     it_begin.current = it_begin.tail;
@@ -647,13 +1388,15 @@ void Deque<E>::insert_block_at_front()
  * 添加区块到区块映射尾部.
  * 添加的区块是未构造的.
  */
-template<typename E>
-void Deque<E>::insert_block_at_back()
+template<typename E, typename Policy>
+void Deque<E, Policy>::insert_block_at_back()
 {
-    // 尾部映射满，则扩容映射到两倍，新增容量安排在尾部
+    if (incremental)
+        advance_growth();
+    // 尾部映射满，则平移或扩容映射
     if (it_end.block == map + M - 1)
-        reserve_map(2 * M, false);
-    *(it_end.block + 1) = allocator_traits::allocate(allocator, BLOCK_SIZE);
+        reserve_map(1, false);
+    set_map_block(it_end.block + 1, allocate_block());
     // 重置尾迭代器的指向
     it_end.set_block(it_end.block + 1);
     it_end.current = it_end.head;
@@ -666,22 +1409,22 @@ void Deque<E>::insert_block_at_back()
  * @param block_begin: 区块起始位置（包含）
  * @param block_end: 区块结束位置（不包含）
  */
-template<typename E>
-void Deque<E>::remove_block(map_pointer block_begin, map_pointer block_end)
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove_block(map_pointer block_begin, map_pointer block_end)
 {
     for (map_pointer i = block_begin; i < block_end; ++i)
-        allocator_traits::deallocate(allocator, *i, BLOCK_SIZE);
+        deallocate_block(*i);
 }
 
 /**
  * 移除区块映射头部的区块.
  * 移除前的区块已经析构完成.
  */
-template<typename E>
-void Deque<E>::remove_block_at_front()
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove_block_at_front()
 {
-    // 释放空区块
-    allocator_traits::deallocate(allocator, *it_begin.block, BLOCK_SIZE);
+    // 回收空区块
+    deallocate_block(*it_begin.block);
     // 重置头迭代器的指向
     it_begin.set_block(it_begin.block + 1);
     it_begin.current = it_begin.head;
@@ -691,16 +1434,105 @@ void Deque<E>::remove_block_at_front()
  * 移除区块映射尾部的区块.
  * 移除前的区块已经析构完成.
  */
-template<typename E>
-void Deque<E>::remove_block_at_back()
+template<typename E, typename Policy>
+void Deque<E, Policy>::remove_block_at_back()
 {
-    // 释放空区块
-    allocator_traits::deallocate(allocator, *it_end.block, BLOCK_SIZE);
+    // 回收空区块
+    deallocate_block(*it_end.block);
     // 重置尾迭代器的指向
     it_end.set_block(it_end.block - 1);
     it_end.current = it_end.tail;
 }
 
+/**
+ * 分配一个未构造的区块.
+ * 缓存中有空闲区块时直接复用，否则向分配器申请.
+ *
+ * @return 指向区块头部的指针
+ */
+template<typename E, typename Policy>
+typename Deque<E, Policy>::pointer Deque<E, Policy>::allocate_block()
+{
+    if (cache_size > 0)
+        return cache[--cache_size];
+    return new_block();
+}
+
+/**
+ * 回收一个已经析构完成的区块.
+ * 缓存未达到上限时放入缓存，否则归还给分配器.
+ *
+ * @param block: 指向区块头部的指针
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::deallocate_block(pointer block)
+{
+    if (cache_size < cache_limit)
+    {
+        // 缓存数组在第一次回收区块时分配
+        if (cache == nullptr)
+            cache = map_allocator_traits::allocate(map_allocator, cache_limit);
+        cache[cache_size++] = block;
+    }
+    else
+        delete_block(block);
+}
+
+/**
+ * 申请一个按BLOCK_ALIGNMENT对齐的新区块.
+ * 对齐到缓存行可以避免区块之间的伪共享，对齐到2MiB便于使用大页.
+ *
+ * @return 指向区块头部的指针
+ * @throws std::bad_alloc: 内存不足
+ */
+template<typename E, typename Policy>
+typename Deque<E, Policy>::pointer Deque<E, Policy>::new_block(std::true_type)
+{
+    void* block = nullptr;
+
+    if (posix_memalign(&block, BLOCK_ALIGNMENT, BLOCK_SIZE * sizeof(E)) != 0)
+        throw std::bad_alloc();
+    return static_cast<pointer>(block);
+}
+
+/**
+ * 析构[first, last)范围内的元素，元素不是平凡析构的.
+ * 逐个区块析构，区块内部是连续的指针循环.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::destroy(iterator first, iterator last, std::false_type)
+{
+    for_each_segment(first, last, [this](pointer head, pointer tail) {
+        for (; head != tail; ++head)
+            allocator_traits::destroy(allocator, head);
+        return true;
+    });
+}
+
+/**
+ * 逐个区块复制另一个双端队列的元素，元素是平凡可复制的.
+ * 两个双端队列的区块个数和队首在区块内的偏移相同，
+ * 因此每个区块内的元素范围可以直接用memcpy复制到对应的区块.
+ *
+ * @param that: 被复制的双端队列
+ */
+template<typename E, typename Policy>
+void Deque<E, Policy>::copy_blocks(const Deque& that, std::true_type) noexcept
+{
+    map_pointer source = that.it_begin.block;
+    map_pointer destination = it_begin.block;
+    for (; source <= that.it_end.block; ++source, ++destination)
+    {
+        const E* head = source == that.it_begin.block ? that.it_begin.current : *source;
+        const E* tail = source == that.it_end.block ? that.it_end.current : *source + BLOCK_SIZE;
+        if (head != tail)
+            std::memcpy(*destination + (head - *source), head, (tail - head) * sizeof(E));
+    }
+}
+
 /**
  * ==操作符重载函数，比较两个Deque对象是否相等.
  *
@@ -709,12 +1541,12 @@ void Deque<E>::remove_block_at_back()
  * @return true: 相等
  *         false: 不等
  */
-template<typename E>
-bool operator==(const Deque<E>& lhs, const Deque<E>& rhs)
+template<typename E, typename Policy>
+bool operator==(const Deque<E, Policy>& lhs, const Deque<E, Policy>& rhs)
 {
     if (&lhs == &rhs)             return true;
     if (lhs.size() != rhs.size()) return false;
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    return equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
 /**
@@ -725,8 +1557,8 @@ bool operator==(const Deque<E>& lhs, const Deque<E>& rhs)
  * @return true: 不等
  *         false: 相等
  */
-template<typename E>
-bool operator!=(const Deque<E>& lhs, const Deque<E>& rhs)
+template<typename E, typename Policy>
+bool operator!=(const Deque<E, Policy>& lhs, const Deque<E, Policy>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -738,8 +1570,8 @@ bool operator!=(const Deque<E>& lhs, const Deque<E>& rhs)
  *        deque: 要输出的双端队列
  * @return 输出流对象
  */
-template<typename E>
-std::ostream& operator<<(std::ostream& os, const Deque<E>& deque)
+template<typename E, typename Policy>
+std::ostream& operator<<(std::ostream& os, const Deque<E, Policy>& deque)
 {
     for (auto i : deque)
         os << i << " ";
@@ -752,13 +1584,13 @@ std::ostream& operator<<(std::ostream& os, const Deque<E>& deque)
  * @param lhs: Deque对象lhs
  *        rhs: Deque对象rhs
  */
-template<typename E>
-void swap(Deque<E>& lhs, Deque<E>& rhs)
+template<typename E, typename Policy>
+void swap(Deque<E, Policy>& lhs, Deque<E, Policy>& rhs)
 {
     lhs.swap(rhs);
 }
 
-template<typename E, typename Ptr, typename Ref>
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize>
 class DequeIterator
 {
 public:
@@ -769,12 +1601,12 @@ public:
     using pointer           = Ptr;
     using reference         = Ref;
     // 迭代器定义
-    using iterator          = DequeIterator<E, E*, E&>;
-    using const_iterator    = DequeIterator<E, const E*, const E&>;
+    using iterator          = DequeIterator<E, E*, E&, BlockSize>;
+    using const_iterator    = DequeIterator<E, const E*, const E&, BlockSize>;
 private:
-    using map_pointer       = pointer*;
+    using map_pointer       = E**;
     // 区块大小
-    static constexpr size_t BLOCK_SIZE = block_size(sizeof(E));
+    static constexpr std::size_t BLOCK_SIZE = BlockSize;
 public:
     DequeIterator() noexcept
     : block(nullptr), current(nullptr), head(nullptr), tail(nullptr) {}
@@ -782,8 +1614,7 @@ public:
     : block(block), current(current), head(*block), tail(head + BLOCK_SIZE) {}
     DequeIterator(const iterator& that) noexcept
     : block(that.block), current(that.current), head(that.head), tail(that.tail) {}
-    DequeIterator(const const_iterator& that) noexcept
-    : block(that.block), current(that.current), head(that.head), tail(that.tail) {}
+    DequeIterator& operator=(const DequeIterator& that) noexcept = default;
 
     reference operator*() const noexcept
     { return *current; }
@@ -798,7 +1629,7 @@ public:
         if (current == tail)
         {
             set_block(block + 1);
-            current = 0;
+            current = head;
         }
         return *this;
     }
@@ -823,7 +1654,7 @@ public:
         else
         {
             difference_type block_offset =
-                    offset < 0 ? difference_type((offset + 1) / BLOCK_SIZE) - 1
+                    offset < 0 ? (offset + 1) / difference_type(BLOCK_SIZE) - 1
                                : offset / difference_type(BLOCK_SIZE);
             set_block(block + block_offset);
             current = head + offset - block_offset * difference_type(BLOCK_SIZE);
@@ -832,8 +1663,12 @@ public:
     }
     DequeIterator& operator--() noexcept
     {
+        // 位于当前区块头部，则跳到上一个区块尾部
         if (current == head)
+        {
             set_block(block - 1);
+            current = tail;
+        }
         --current;
         return *this;
     }
@@ -852,7 +1687,7 @@ public:
     { return *this += -n; }
     difference_type operator-(const DequeIterator& that) const noexcept
     {
-        return (block - that.block) * BLOCK_SIZE
+        return (block - that.block) * difference_type(BLOCK_SIZE)
                 + (that.head - that.current)
                 + (current - head);
     }
@@ -872,7 +1707,7 @@ private:
     map_pointer block;  // 映射到当前区块
     pointer current;    // 指向区块当前元素
     pointer head;       // 指向区块头部
-    pointer tail;       // 指向区块头部
+    pointer tail;       // 指向区块尾部
 
     // 跳转到指定区块，current的修改交给调用者
     void set_block(map_pointer new_block)
@@ -882,50 +1717,427 @@ private:
         tail = head + BLOCK_SIZE;
     }
 
-    friend class Deque<E>;
-    friend class DequeIterator<E, E*, E&>;
-    friend class DequeIterator<E, const E*, const E&>;
-
-    friend void uninitialized_fill(iterator& first, iterator& last, const value_type& value);
-    friend void uninitialized_copy(iterator& first, iterator& last, iterator destination);
+    template<typename T, typename Policy>
+    friend class Deque;
+    friend class DequeIterator<E, E*, E&, BlockSize>;
+    friend class DequeIterator<E, const E*, const E&, BlockSize>;
+
+    template<typename T, typename P, typename R, std::size_t S, typename Function>
+    friend bool for_each_segment(DequeIterator<T, P, R, S> first,
+                                 DequeIterator<T, P, R, S> last, Function f);
+    template<typename T, typename P, typename R, std::size_t S, typename Function>
+    friend bool for_each_segment_backward(DequeIterator<T, P, R, S> first,
+                                          DequeIterator<T, P, R, S> last, Function f);
 };
 
-template<typename E, typename Ptr, typename Ref>
-void uninitialized_fill(const DequeIterator<E, E*, E&>& first,
-                        const DequeIterator<E, E*, E&>& last,
-                        const E& value)
+// Note: 双端队列的元素只在区块内部连续，迭代器的每次++都要检查区块边界，
+//       std::copy等算法无法展开成memmove或向量化的循环.
+//       下面的算法先把[first, last)拆分为若干区块内的连续范围[head, tail)，
+//       再在每个范围内使用原生指针调用标准库算法.
+//       双端队列迭代器作为参数时，ADL会优先选择这些更特化的重载.
+
+/**
+ * 分段遍历[first, last)范围.
+ * 对每个区块内的连续范围[head, tail)按顺序调用一次f，
+ * f返回false时停止遍历.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        f: 接受区块内连续范围(head, tail)的函数对象，返回是否继续遍历
+ * @return true: 遍历了所有的范围
+ *         false: f提前停止了遍历
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize, typename Function>
+bool for_each_segment(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                      DequeIterator<E, Ptr, Ref, BlockSize> last, Function f)
+{
+    using map_pointer = typename DequeIterator<E, Ptr, Ref, BlockSize>::map_pointer;
+
+    if (first.block == last.block)
+        return f(first.current, last.current);
+    if (!f(first.current, first.tail))
+        return false;
+    for (map_pointer block = first.block + 1; block < last.block; ++block)
+        if (!f(Ptr(*block), Ptr(*block + BlockSize)))
+            return false;
+    return f(last.head, last.current);
+}
+
+/**
+ * 从后向前分段遍历[first, last)范围.
+ * 对每个区块内的连续范围[head, tail)按从后向前的顺序调用一次f，
+ * f返回false时停止遍历.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        f: 接受区块内连续范围(head, tail)的函数对象，返回是否继续遍历
+ * @return true: 遍历了所有的范围
+ *         false: f提前停止了遍历
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize, typename Function>
+bool for_each_segment_backward(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                               DequeIterator<E, Ptr, Ref, BlockSize> last, Function f)
+{
+    using map_pointer = typename DequeIterator<E, Ptr, Ref, BlockSize>::map_pointer;
+
+    if (first.block == last.block)
+        return f(first.current, last.current);
+    if (!f(last.head, last.current))
+        return false;
+    for (map_pointer block = last.block - 1; block > first.block; --block)
+        if (!f(Ptr(*block), Ptr(*block + BlockSize)))
+            return false;
+    return f(first.current, first.tail);
+}
+
+/**
+ * 复制[first, last)范围内的元素到destination开始的范围.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        destination: 目标范围的起始迭代器
+ * @return 指向目标范围最后一个复制元素之后的迭代器
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize,
+         typename OutputIterator>
+OutputIterator copy(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                    DequeIterator<E, Ptr, Ref, BlockSize> last,
+                    OutputIterator destination)
+{
+    for_each_segment(first, last, [&destination](Ptr head, Ptr tail) {
+        destination = std::copy(head, tail, destination);
+        return true;
+    });
+    return destination;
+}
+
+/**
+ * 复制[first, last)范围内的元素到另一个双端队列的范围.
+ * 源范围和目标范围同时按区块拆分，每一段都是指针之间的复制.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        destination: 目标范围的起始迭代器
+ * @return 指向目标范围最后一个复制元素之后的迭代器
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+copy(DequeIterator<E, Ptr, Ref, BlockSize> first,
+     DequeIterator<E, Ptr, Ref, BlockSize> last,
+     DequeIterator<E, E*, E&, BlockSize> destination)
+{
+    for_each_segment(first, last, [&destination](Ptr head, Ptr tail) {
+        DequeIterator<E, E*, E&, BlockSize> next = destination + (tail - head);
+        for_each_segment(destination, next, [&head](E* dhead, E* dtail) {
+            std::copy(head, head + (dtail - dhead), dhead);
+            head += dtail - dhead;
+            return true;
+        });
+        destination = next;
+        return true;
+    });
+    return destination;
+}
+
+/**
+ * 移动[first, last)范围内的元素到同一类型双端队列中destination开始的范围.
+ * 源范围和目标范围同时按区块拆分，目标范围可以与源范围的后部重叠.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        destination: 目标范围的起始迭代器
+ * @return 指向目标范围最后一个移动元素之后的迭代器
+ */
+template<typename E, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+move(DequeIterator<E, E*, E&, BlockSize> first, DequeIterator<E, E*, E&, BlockSize> last,
+     DequeIterator<E, E*, E&, BlockSize> destination)
+{
+    for_each_segment(first, last, [&destination](E* head, E* tail) {
+        DequeIterator<E, E*, E&, BlockSize> next = destination + (tail - head);
+        for_each_segment(destination, next, [&head](E* dhead, E* dtail) {
+            std::move(head, head + (dtail - dhead), dhead);
+            head += dtail - dhead;
+            return true;
+        });
+        destination = next;
+        return true;
+    });
+    return destination;
+}
+
+/**
+ * 从后向前移动[first, last)范围内的元素到同一类型双端队列中以destination结尾的范围.
+ * 源范围和目标范围同时从后向前按区块拆分，目标范围可以与源范围的前部重叠.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        destination: 目标范围的尾部迭代器（不包含）
+ * @return 指向目标范围第一个移动元素的迭代器
+ */
+template<typename E, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+move_backward(DequeIterator<E, E*, E&, BlockSize> first, DequeIterator<E, E*, E&, BlockSize> last,
+              DequeIterator<E, E*, E&, BlockSize> destination)
+{
+    for_each_segment_backward(first, last, [&destination](E* head, E* tail) {
+        DequeIterator<E, E*, E&, BlockSize> prev = destination - (tail - head);
+        for_each_segment_backward(prev, destination, [&tail](E* dhead, E* dtail) {
+            std::move_backward(tail - (dtail - dhead), tail, dtail);
+            tail -= dtail - dhead;
+            return true;
+        });
+        destination = prev;
+        return true;
+    });
+    return destination;
+}
+
+/**
+ * 用value赋值[first, last)范围内的元素.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        value: 要赋的值
+ */
+template<typename E, std::size_t BlockSize>
+void fill(DequeIterator<E, E*, E&, BlockSize> first,
+          DequeIterator<E, E*, E&, BlockSize> last, const E& value)
+{
+    for_each_segment(first, last, [&value](E* head, E* tail) {
+        std::fill(head, tail, value);
+        return true;
+    });
+}
+
+/**
+ * 比较[first1, last1)范围与first2开始的范围是否相等.
+ *
+ * @param first1: 第一个范围的头部迭代器（包含）
+ *        last1: 第一个范围的尾部迭代器（不包含）
+ *        first2: 第二个范围的起始迭代器
+ * @return true: 相等
+ *         false: 不等
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize,
+         typename ForwardIterator>
+bool equal(DequeIterator<E, Ptr, Ref, BlockSize> first1,
+           DequeIterator<E, Ptr, Ref, BlockSize> last1,
+           ForwardIterator first2)
 {
-    using map_pointer = typename DequeIterator<E, E*, E&>::map_pointer;
-    using BLOCK_SIZE = DequeIterator<E, E*, E&>::BLOCK_SIZE;
+    return for_each_segment(first1, last1, [&first2](Ptr head, Ptr tail) {
+        if (!std::equal(head, tail, first2))
+            return false;
+        std::advance(first2, tail - head);
+        return true;
+    });
+}
 
-    map_pointer block;
+/**
+ * 比较两个双端队列的范围是否相等.
+ * 两个范围同时按区块拆分，每一段都是指针之间的比较.
+ *
+ * @param first1: 第一个范围的头部迭代器（包含）
+ *        last1: 第一个范围的尾部迭代器（不包含）
+ *        first2: 第二个范围的起始迭代器
+ * @return true: 相等
+ *         false: 不等
+ */
+template<typename E, typename Ptr1, typename Ref1, typename Ptr2, typename Ref2,
+         std::size_t BlockSize>
+bool equal(DequeIterator<E, Ptr1, Ref1, BlockSize> first1,
+           DequeIterator<E, Ptr1, Ref1, BlockSize> last1,
+           DequeIterator<E, Ptr2, Ref2, BlockSize> first2)
+{
+    return for_each_segment(first1, last1, [&first2](Ptr1 head, Ptr1 tail) {
+        DequeIterator<E, Ptr2, Ref2, BlockSize> next = first2 + (tail - head);
+        bool same = for_each_segment(first2, next, [&head](Ptr2 head2, Ptr2 tail2) {
+            if (!std::equal(head2, tail2, head))
+                return false;
+            head += tail2 - head2;
+            return true;
+        });
+        first2 = next;
+        return same;
+    });
+}
+
+/**
+ * 查找[first, last)范围内第一个等于value的元素.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        value: 要查找的值
+ * @return 指向第一个等于value的元素的迭代器，不存在时返回last
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize>
+DequeIterator<E, Ptr, Ref, BlockSize>
+find(DequeIterator<E, Ptr, Ref, BlockSize> first,
+     DequeIterator<E, Ptr, Ref, BlockSize> last, const E& value)
+{
+    std::ptrdiff_t offset = 0; // 查找位置相对于first的偏移
+
+    for_each_segment(first, last, [&offset, &value](Ptr head, Ptr tail) {
+        Ptr i = std::find(head, tail, value);
+        offset += i - head;
+        return i == tail;
+    });
+    return first + offset;
+}
+
+/**
+ * 对[first, last)范围内的每个元素按顺序调用f.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        f: 函数对象
+ * @return 函数对象f
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize, typename Function>
+Function for_each(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                  DequeIterator<E, Ptr, Ref, BlockSize> last, Function f)
+{
+    for_each_segment(first, last, [&f](Ptr head, Ptr tail) {
+        for (; head != tail; ++head)
+            f(*head);
+        return true;
+    });
+    return f;
+}
+
+/**
+ * 按顺序累加[first, last)范围内的元素.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        init: 初始值
+ * @return 累加的结果
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize, typename T>
+T accumulate(DequeIterator<E, Ptr, Ref, BlockSize> first,
+             DequeIterator<E, Ptr, Ref, BlockSize> last, T init)
+{
+    for_each_segment(first, last, [&init](Ptr head, Ptr tail) {
+        init = std::accumulate(head, tail, std::move(init));
+        return true;
+    });
+    return init;
+}
+
+/**
+ * 在destination开始的未构造范围上复制构造[first, last)范围内的元素.
+ * 构造过程抛出异常时，析构已经构造的元素后重新抛出.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        destination: 目标范围的起始迭代器
+ * @return 指向目标范围最后一个构造元素之后的迭代器
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+uninitialized_copy(DequeIterator<E, Ptr, Ref, BlockSize> first,
+                   DequeIterator<E, Ptr, Ref, BlockSize> last,
+                   DequeIterator<E, E*, E&, BlockSize> destination)
+{
+    DequeIterator<E, E*, E&, BlockSize> current = destination;
 
     try
     {
-        for (block = first.block + 1; block < last.block; ++block)
-            std::uninitialized_fill(*block, *block + BLOCK_SIZE, value);
-        if (first.block != last.block)
-        {
-            std::uninitialized_fill(first.current, first.tail, value);
-            std::uninitialized_fill(last.head, last.current, value);
-        }
-        else
-            std::uninitialized_fill(first.current, last.current, value);
+        for_each_segment(first, last, [&current](Ptr head, Ptr tail) {
+            DequeIterator<E, E*, E&, BlockSize> next = current + (tail - head);
+            for_each_segment(current, next, [&head, &current](E* dhead, E* dtail) {
+                std::uninitialized_copy(head, head + (dtail - dhead), dhead);
+                head += dtail - dhead;
+                current += dtail - dhead;
+                return true;
+            });
+            return true;
+        });
     }
     catch(...)
     {
-//        destroy(*n, *n + buffer_size());
+        for_each_segment(destination, current, [](E* head, E* tail) {
+            for (; head != tail; ++head)
+                head->~E();
+            return true;
+        });
         throw;
     }
+    return current;
+}
+
+/**
+ * 在destination开始的未构造范围上复制构造[first, last)范围内的元素.
+ * 源范围是任意前向迭代器，目标范围按区块分段，每段调用一次std::uninitialized_copy.
+ * 构造过程抛出异常时，析构已经构造的元素后重新抛出.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        destination: 目标范围的起始迭代器
+ * @return 指向目标范围最后一个构造元素之后的迭代器
+ */
+template<typename ForwardIterator, typename E, std::size_t BlockSize>
+DequeIterator<E, E*, E&, BlockSize>
+uninitialized_copy(ForwardIterator first, ForwardIterator last,
+                   DequeIterator<E, E*, E&, BlockSize> destination)
+{
+    DequeIterator<E, E*, E&, BlockSize> current = destination;
+    DequeIterator<E, E*, E&, BlockSize> result = destination + std::distance(first, last);
 
+    try
+    {
+        for_each_segment(destination, result, [&first, &current](E* head, E* tail) {
+            ForwardIterator next = first;
+            std::advance(next, tail - head);
+            std::uninitialized_copy(first, next, head);
+            first = next;
+            current += tail - head;
+            return true;
+        });
+    }
+    catch(...)
+    {
+        for_each_segment(destination, current, [](E* head, E* tail) {
+            for (; head != tail; ++head)
+                head->~E();
+            return true;
+        });
+        throw;
+    }
+    return result;
 }
 
-template<typename E, typename Ptr, typename Ref>
-void uninitialized_copy(const DequeIterator<E, E*, E&>& first,
-                        const DequeIterator<E, E*, E&>& last,
-                        DequeIterator<E, E*, E&> destination)
+/**
+ * 在[first, last)未构造范围上用value构造元素.
+ * 构造过程抛出异常时，析构已经构造的元素后重新抛出.
+ *
+ * @param first: 头部迭代器（包含）
+ *        last: 尾部迭代器（不包含）
+ *        value: 用于构造的值
+ */
+template<typename E, std::size_t BlockSize>
+void uninitialized_fill(DequeIterator<E, E*, E&, BlockSize> first,
+                        DequeIterator<E, E*, E&, BlockSize> last, const E& value)
 {
+    DequeIterator<E, E*, E&, BlockSize> current = first;
 
+    try
+    {
+        for_each_segment(first, last, [&current, &value](E* head, E* tail) {
+            std::uninitialized_fill(head, tail, value);
+            current += tail - head;
+            return true;
+        });
+    }
+    catch(...)
+    {
+        for_each_segment(first, current, [](E* head, E* tail) {
+            for (; head != tail; ++head)
+                head->~E();
+            return true;
+        });
+        throw;
+    }
 }
 
 } // namespace cpplib
@@ -6,305 +6,428 @@
  ******************************************************************************/
 
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "PoolAllocator.h"
 
 namespace cpplib
 {
 
+// 链表结点的链接部分，哨兵结点只有链接部分
+struct ListNodeBase
+{
+    ListNodeBase* prev;
+    ListNodeBase* next;
+
+    ListNodeBase() noexcept : prev(this), next(this) {}
+};
+
+// 链表结点
+template<typename E>
+struct ListNode : ListNodeBase
+{
+    E elem;
+
+    template<typename... Args>
+    explicit ListNode(Args&&... args) : elem(std::forward<Args>(args)...) {}
+};
+
+// 链表的双向迭代器
+template<typename E, typename Ptr, typename Ref>
+class ListIterator;
+
 /**
  * 使用模板实现的链表.
+ * 由带哨兵结点的双向循环链表存储，哨兵结点是链表对象的成员.
  * 实现了链表的双向迭代器.
+ * 结点由Allocator rebind得到的结点分配器分配，默认的PoolAllocator从每个链表自己的内存池
+ * 按块组分配结点，移除的结点回到空闲链表复用，不再每次调用malloc和free.
+ * 分配器随结点一起移动和交换；复制链表时使用新的分配器，并一次预留所有结点的连续空间.
  */
-template<typename E>
+template<typename E, typename Allocator = PoolAllocator<E>>
 class List
 {
-	using iterator = class ListIterator;
-
-    struct Node
-    {
-        E elem;
-        Node* prev;
-        Node* next;
-        Node() : elem(), prev(this), next(this) {}
-        Node(E elem) : elem(std::move(elem)), prev(this), next(this) {}
-    };
 public:
-    List() : n(0), sentinel(new Node) {}
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+    // 迭代器定义
+    using iterator               = ListIterator<E, E*, E&>;
+    using const_iterator         = ListIterator<E, const E*, const E&>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+private:
+    using Node                  = ListNode<E>;
+    using node_allocator_type   =
+            typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_allocator_traits = typename std::allocator_traits<node_allocator_type>;
+public:
+    List() noexcept : n(0) {}
+    explicit List(const allocator_type& alloc) noexcept : n(0), allocator(alloc) {}
     List(const List& that);
     List(List&& that) noexcept;
-    ~List();
+    ~List() { clear(); }
+    List& operator=(List that);
+    allocator_type get_allocator() const noexcept { return allocator_type(allocator); }
+
+    iterator begin() noexcept { return iterator(sentinel.next); }
+    iterator end()   noexcept { return iterator(&sentinel); }
+    const_iterator begin()  const noexcept { return const_iterator(sentinel.next); }
+    const_iterator end()    const noexcept { return const_iterator(&sentinel); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
 
     // 返回链表元素的数量
-    int size() const { return n; }
+    size_type size() const noexcept { return n; }
     // 判断是否为空链表
-    bool empty() const { return n == 0; }
-    // 添加元素到指定位置
-    void insert(iterator pos, E elem);
+    bool empty() const noexcept { return n == 0; }
+    // 返回链表可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(Node); }
+
+    // 返回链表头部元素的const引用
+    const E& front() const;
+    // 返回链表尾部元素的const引用
+    const E& back() const;
+    // 返回指定位置元素的const引用，带边界检查
+    const E& at(size_type i) const;
+    // 返回链表头部元素的引用
+    E& front() { return const_cast<E&>(static_cast<const List&>(*this).front()); }
+    // 返回链表尾部元素的引用
+    E& back() { return const_cast<E&>(static_cast<const List&>(*this).back()); }
+    // 返回指定位置元素的引用，带边界检查
+    E& at(size_type i) { return const_cast<E&>(static_cast<const List&>(*this).at(i)); }
+
+    // 在链表头部直接构造元素
+    template<typename... Args>
+    void emplace_front(Args&&... args) { emplace(cbegin(), std::forward<Args>(args)...); }
+    // 在链表尾部直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args) { emplace(cend(), std::forward<Args>(args)...); }
+    // 在迭代器指定的位置直接构造元素
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    // 添加元素到迭代器指定的位置
+    void insert(const_iterator pos, E elem) { emplace(pos, std::move(elem)); }
     // 添加元素到链表头部
-    void insert_front(E elem);
+    void insert_front(const E& elem) { emplace_front(elem); }
+    void insert_front(E&& elem) { emplace_front(std::move(elem)); }
     // 添加元素到链表尾部
-    void insert_back(E elem);
-    // 移除指定位置的元素
-    void remove(iterator pos);
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
+    // 移除迭代器指定位置的元素
+    void remove(const_iterator pos);
     // 移除链表头部元素
     void remove_front();
     // 移除链表尾部元素
     void remove_back();
-    // 返回链表头部元素的引用
-    E& front() { return const_cast<E&>(static_cast<const List&>(*this).front()); }
-    // 返回链表头部元素的const引用
-    const E& front() const;
-    // 返回链表尾部元素的引用
-    E& back() { return const_cast<E&>(static_cast<const List&>(*this).back()); }
-    // 返回链表尾部元素的const引用
-    const E& back() const;
-    // 内容与另一个LinkedList对象交换
-    void swap(List& that);
+    // 内容与另一个List对象交换
+    void swap(List& that) noexcept;
     // 清空链表
-    void clear();
+    void clear() noexcept;
+    // 把另一个链表的所有结点转移到pos之前
+    void splice(const_iterator pos, List& that);
+    void splice(const_iterator pos, List&& that) { splice(pos, that); }
+    // 把另一个链表中[first, last)的结点转移到pos之前
+    void splice(const_iterator pos, List& that, const_iterator first, const_iterator last);
+    void splice(const_iterator pos, List&& that, const_iterator first, const_iterator last)
+    { splice(pos, that, first, last); }
+    // 合并另一个有序链表，两个链表都按operator<升序排列
+    void merge(List& that) { merge(that, std::less<E>()); }
+    void merge(List&& that) { merge(that, std::less<E>()); }
+    // 合并另一个有序链表，两个链表都按comp升序排列
+    template<typename Compare>
+    void merge(List& that, Compare comp);
+    template<typename Compare>
+    void merge(List&& that, Compare comp) { merge(that, comp); }
+    // 按operator<稳定排序
+    void sort() { sort(std::less<E>()); }
+    // 按comp稳定排序
+    template<typename Compare>
+    void sort(Compare comp);
 
-    List& operator=(List that);
     List& operator+=(const List& that);
-    template<typename T>
-    friend List<T> operator+(List<T> lhs, const List<T>& rhs);
-    template <typename T>
-    friend bool operator==(const List<T>& lhs, const List<T>& rhs);
-    template <typename T>
-    friend bool operator!=(const List<T>& lhs, const List<T>& rhs);
-    template<typename T>
-    friend std::ostream& operator<<(std::ostream& os, const List<T>& list);
-
-    // 链表不支持随机访问
-    class iterator : public std::iterator<std::bidirectional_iterator_tag, E>
-    {
-        friend class List;
-    private:
-        Node* pn;
-    public:
-        iterator() : pn(nullptr) {}
-        iterator(Node* x) : pn(x) {}
-        iterator(const iterator& that) : pn(that.pn) {}
-        ~iterator() {}
-
-        E& operator*() const
-        { return pn->elem; }
-        E* operator->() const
-        { return &pn->elem; }
-        iterator& operator++()
-        {
-            pn = pn->next;
-            return *this;
-        }
-        iterator operator++(int)
-        {
-            iterator tmp(*this);
-            ++*this;
-            return tmp;
-        }
-        iterator& operator--()
-        {
-            pn = pn->prev;
-            return *this;
-        }
-        iterator operator--(int)
-        {
-            iterator tmp(*this);
-            --*this;
-            return tmp;
-        }
-        bool operator==(const iterator& that) const
-        { return pn == that.pn; }
-        bool operator!=(const iterator& that) const
-        { return pn != that.pn; }
-    };
-    iterator begin() const { return iterator(sentinel->next); }
-    iterator end() const { return iterator(sentinel); }
+    List& operator+=(List&& that);
 private:
-    int n; // 链表大小
-    Node* sentinel; // 哨兵指针
-
-    // 定位指定元素
-    Node* locate(int i) const;
-    // 检查索引是否合法
-    bool valid(int i) const { return i >= 0 && i < n; }
+    // 定位指定位置的结点，从较近的一端开始查找
+    const ListNodeBase* locate(size_type i) const noexcept;
+    // 把结点链接到pos之前
+    static void link(ListNodeBase* pos, ListNodeBase* node) noexcept;
+    // 把结点从链表中断开
+    static void unlink(ListNodeBase* node) noexcept;
+    // 把[first, last)的结点链接到pos之前
+    static void transfer(ListNodeBase* pos, ListNodeBase* first, ListNodeBase* last) noexcept;
+    // 返回结点中元素的引用
+    static E& value(ListNodeBase* node) noexcept { return static_cast<Node*>(node)->elem; }
+    // 合并两段以nullptr结尾的有序结点
+    template<typename Compare>
+    static ListNodeBase* merge_runs(ListNodeBase*& left, ListNodeBase*& right, Compare& comp);
+    // 连接两段以nullptr结尾的结点
+    static ListNodeBase* concat(ListNodeBase* first, ListNodeBase* second) noexcept;
+    // 按next指针恢复prev指针和循环链接
+    void relink(ListNodeBase* head) noexcept;
+    // 创建结点并构造元素
+    template<typename... Args>
+    Node* create_node(Args&&... args);
+    // 析构元素并释放结点
+    void destroy_node(ListNodeBase* node) noexcept;
+    // 移动另一个链表的结点，that变为空链表
+    void take(List& that) noexcept;
+    // 分配器支持时预留count个结点的连续空间
+    template<typename Alloc>
+    static auto reserve_nodes(Alloc& alloc, size_type count, int) -> decltype(alloc.reserve(count))
+    { return alloc.reserve(count); }
+    template<typename Alloc>
+    static void reserve_nodes(Alloc&, size_type, long) {}
+    // 使两个分配器相等，之后一方分配的结点可以由另一方释放
+    template<typename Alloc>
+    static auto adopt_nodes(Alloc& alloc, Alloc& that, int) -> decltype(alloc.adopt(that))
+    { return alloc.adopt(that); }
+    template<typename Alloc>
+    static bool adopt_nodes(Alloc& alloc, Alloc& that, long) { return alloc == that; }
+private:
+    ListNodeBase sentinel; // 哨兵结点
+    size_type n;           // 链表大小
+    node_allocator_type allocator; // 结点分配器
 };
 
 /**
  * 链表复制构造函数.
  * 复制另一个链表作为这个链表的初始化.
+ * 先一次预留所有结点的空间，复制的结点在内存中连续排列.
  *
  * @param that: 被复制的链表
  */
-template<typename E>
-List<E>::List(const List& that)
+template<typename E, typename Allocator>
+List<E, Allocator>::List(const List& that)
+: List(allocator_type(node_allocator_traits::select_on_container_copy_construction(that.allocator)))
 {
-    n = 0;
-    sentinel = new Node();
-    for (auto i : that)
-        insert_back(i);
+    // 委托构造已经完成，复制抛出异常时析构函数会释放已复制的结点
+    reserve_nodes(allocator, that.n, 0);
+    for (auto& elem : that)
+        insert_back(elem);
 }
 
 /**
  * 链表移动构造函数.
- * 移动另一个链表，其资源所有权转移到新创建的对象.
+ * 移动另一个链表，其结点的所有权转移到新创建的对象.
  *
  * @param that: 被移动的链表
  */
-template<typename E>
-List<E>::List(List&& that) noexcept
+template<typename E, typename Allocator>
+List<E, Allocator>::List(List&& that) noexcept : List()
 {
-    n = that.n;
-    sentinel = that.sentinel;
-    that.sentinel = nullptr; // 指向空指针，退出被析构
+    take(that);
 }
 
 /**
- * 链表析构函数.
+ * 移动另一个链表的所有结点到这个空链表，that变为空链表.
+ * 哨兵结点是链表对象的成员，需要修改首尾结点指向哨兵的指针.
+ * 结点由that的分配器分配，两个分配器一起交换，之后由这个链表释放.
+ *
+ * @param that: 被移动的链表
  */
-template<typename E>
-List<E>::~List()
+template<typename E, typename Allocator>
+void List<E, Allocator>::take(List& that) noexcept
 {
-    clear();
-    delete sentinel;
-    sentinel = nullptr;
+    if (that.empty())
+        return;
+    using std::swap;
+    swap(allocator, that.allocator);
+    sentinel.next = that.sentinel.next;
+    sentinel.prev = that.sentinel.prev;
+    sentinel.next->prev = &sentinel;
+    sentinel.prev->next = &sentinel;
+    n = that.n;
+    that.sentinel.next = that.sentinel.prev = &that.sentinel;
+    that.n = 0;
 }
 
 /**
- * 定位指定位置的元素.
- * 返回指向该位置元素的指针.
+ * 定位指定位置的结点.
+ * 位置在前半部分时从头部向后查找，否则从尾部向前查找.
  *
- * @param i: 指定元素的索引
- * @return 指向该位置元素的指针
- * @throws std::out_of_range: 索引不合法
+ * @param i: 指定元素的索引，要求i < size()
+ * @return 指向该位置结点的指针
  */
-template<typename E>
-typename List<E>::Node* List<E>::locate(int i) const
+template<typename E, typename Allocator>
+const ListNodeBase* List<E, Allocator>::locate(size_type i) const noexcept
 {
-    if (!valid(i))
-        throw std::out_of_range("List::locate() index out of range.");
-    if (i < (n >> 1)) return std::next(begin(), i).pn;
-    else              return std::prev(end(), n - i).pn;
+    const ListNodeBase* node = &sentinel;
+    if (i < n / 2)
+    {
+        for (size_type k = 0; k <= i; ++k)
+            node = node->next;
+    }
+    else
+    {
+        for (size_type k = n; k > i; --k)
+            node = node->prev;
+    }
+    return node;
 }
 
 /**
- * 添加元素到链表指定位置.
+ * 把结点链接到pos之前.
  *
- * @param i: 要添加元素的索引
- *        elem: 要添加的元素
- * @throws std::out_of_range: 索引不合法
+ * @param pos: 链接位置的后继结点
+ *        node: 要链接的结点
  */
-template<typename E>
-void List<E>::insert(iterator pos, E elem)
+template<typename E, typename Allocator>
+void List<E, Allocator>::link(ListNodeBase* pos, ListNodeBase* node) noexcept
 {
-    Node* prec = nullptr;
-    Node* succ = nullptr; // 指定位置的前驱和后继
-    Node* pnew = nullptr;
-
-    if (i == n) succ = sentinel;
-    else        succ = locate(i);
-    pnew = new Node(std::move(elem));
-    prec = succ->prev;
-    prec->next = pnew;
-    pnew->prev = prec;
-    pnew->next = succ;
-    succ->prev = pnew;
-    n++;
+    ListNodeBase* prec = pos->prev;
+    prec->next = node;
+    node->prev = prec;
+    node->next = pos;
+    pos->prev = node;
 }
 
 /**
- * 添加元素到链表头部.
+ * 把结点从链表中断开，不释放结点.
  *
- * @param elem: 要添加的元素
+ * @param node: 要断开的结点
  */
-template<typename E>
-void List<E>::insert_front(E elem)
+template<typename E, typename Allocator>
+void List<E, Allocator>::unlink(ListNodeBase* node) noexcept
 {
-    Node* succ = sentinel->next;
-    Node* pnew = new Node(std::move(elem));
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+}
 
-    sentinel->next = pnew;
-    pnew->prev = sentinel;
-    pnew->next = succ;
-    succ->prev = pnew;
-    n++;
+/**
+ * 把[first, last)的结点链接到pos之前，只修改指针.
+ * pos不能在[first, last)中.
+ *
+ * @param pos: 链接位置的后继结点
+ *        first: 第一个结点
+ *        last: 最后一个结点的后继结点
+ */
+template<typename E, typename Allocator>
+void List<E, Allocator>::transfer(ListNodeBase* pos, ListNodeBase* first, ListNodeBase* last) noexcept
+{
+    if (pos == last || first == last)
+        return;
+    ListNodeBase* tail = last->prev;
+    first->prev->next = last;
+    last->prev = first->prev;
+    ListNodeBase* prec = pos->prev;
+    prec->next = first;
+    first->prev = prec;
+    tail->next = pos;
+    pos->prev = tail;
 }
 
 /**
- * 添加元素到链表尾部.
+ * 创建结点并用参数构造元素.
  *
- * @param elem: 要添加的元素
+ * @param args: 用于构造元素的参数
+ * @return 新结点
  */
-template<typename E>
-void List<E>::insert_back(E elem)
+template<typename E, typename Allocator>
+template<typename... Args>
+typename List<E, Allocator>::Node* List<E, Allocator>::create_node(Args&&... args)
 {
-    Node* prec = sentinel->prev;
-    Node* pnew = new Node(std::move(elem));
+    Node* node = node_allocator_traits::allocate(allocator, 1);
+    try
+    {
+        node_allocator_traits::construct(allocator, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        node_allocator_traits::deallocate(allocator, node, 1);
+        throw;
+    }
+    return node;
+}
 
-    prec->next = pnew;
-    pnew->prev = prec;
-    pnew->next = sentinel;
-    sentinel->prev = pnew;
-    n++;
+/**
+ * 析构结点的元素并释放结点.
+ *
+ * @param node: 要释放的结点
+ */
+template<typename E, typename Allocator>
+void List<E, Allocator>::destroy_node(ListNodeBase* node) noexcept
+{
+    Node* p = static_cast<Node*>(node);
+    node_allocator_traits::destroy(allocator, p);
+    node_allocator_traits::deallocate(allocator, p, 1);
 }
 
 /**
- * 移除链表中指定位置的元素.
+ * 在迭代器指定的位置直接构造元素.
  *
- * @param i: 要移除元素的索引
- * @throws std::out_of_range: 索引不合法
+ * @param pos: 要添加元素的位置
+ *        args: 用于构造元素的参数
+ * @return 指向新元素的迭代器
  */
-template<typename E>
-void List<E>::remove(iterator pos)
+template<typename E, typename Allocator>
+template<typename... Args>
+typename List<E, Allocator>::iterator List<E, Allocator>::emplace(const_iterator pos, Args&&... args)
 {
-    Node* pold = locate(i);
-    Node* prec = pold->prev;
-    Node* succ = pold->next; // 指定位置的前驱和后继
+    Node* node = create_node(std::forward<Args>(args)...);
+    link(pos.node, node);
+    ++n;
+    return iterator(node);
+}
 
-    prec->next = succ;
-    succ->prev = prec;
-    delete pold;
-    n--;
+/**
+ * 移除迭代器指定位置的元素.
+ *
+ * @param pos: 要移除元素的位置
+ * @throws std::out_of_range: 位置为尾迭代器
+ */
+template<typename E, typename Allocator>
+void List<E, Allocator>::remove(const_iterator pos)
+{
+    if (pos.node == &sentinel)
+        throw std::out_of_range("List::remove");
+    unlink(pos.node);
+    destroy_node(pos.node);
+    --n;
 }
 
 /**
  * 移除链表头部元素.
  *
- * @throws std::out_of_range: 队空
+ * @throws std::out_of_range: 链表为空
  */
-template<typename E>
-void List<E>::remove_front()
+template<typename E, typename Allocator>
+void List<E, Allocator>::remove_front()
 {
     if (empty())
         throw std::out_of_range("List::remove_front");
-
-    Node* pold = sentinel->next;
-    Node* succ = pold->next;
-
-    sentinel->next = succ;
-    succ->prev = sentinel;
-    delete pold;
-    n--;
+    remove(cbegin());
 }
 
 /**
  * 移除链表尾部元素.
  *
- * @throws std::out_of_range: 队空
+ * @throws std::out_of_range: 链表为空
  */
-template<typename E>
-void List<E>::remove_back()
+template<typename E, typename Allocator>
+void List<E, Allocator>::remove_back()
 {
     if (empty())
         throw std::out_of_range("List::remove_back");
-
-    Node* pold = sentinel->prev;
-    Node* prec = pold->prev;
-
-    prec->next = sentinel;
-    sentinel->prev = prec;
-    delete pold;
-    n--;
+    remove(const_iterator(sentinel.prev));
 }
 
 /**
@@ -313,8 +436,8 @@ void List<E>::remove_back()
  * @return 链表头部元素的const引用
  * @throws std::out_of_range: 链表为空
  */
-template<typename E>
-const E& List<E>::front() const
+template<typename E, typename Allocator>
+const E& List<E, Allocator>::front() const
 {
     if (empty())
         throw std::out_of_range("List::front");
@@ -327,48 +450,276 @@ const E& List<E>::front() const
  * @return 链表尾部元素的const引用
  * @throws std::out_of_range: 链表为空
  */
-template<typename E>
-const E& List<E>::back() const
+template<typename E, typename Allocator>
+const E& List<E, Allocator>::back() const
 {
     if (empty())
         throw std::out_of_range("List::back");
     return *std::prev(end());
 }
 
+/**
+ * 返回链表指定位置元素的const引用，并进行越界检查.
+ *
+ * @param i: 指定元素的索引
+ * @return 指定位置元素的const引用
+ * @throws std::out_of_range: 索引不合法
+ */
+template<typename E, typename Allocator>
+const E& List<E, Allocator>::at(size_type i) const
+{
+    if (i >= n)
+        throw std::out_of_range("List::at");
+    return static_cast<const Node*>(locate(i))->elem;
+}
+
 /**
  * 交换当前List对象和另一个List对象.
  *
  * @param that: List对象that
  */
-template<typename E>
-void List<E>::swap(List<E>& that)
+template<typename E, typename Allocator>
+void List<E, Allocator>::swap(List& that) noexcept
 {
-    using std::swap;
-    swap(n, that.n);
-    swap(sentinel, that.sentinel);
+    List tmp;
+    tmp.take(that);
+    that.take(*this);
+    take(tmp);
 }
 
 /**
  * 清空该链表元素.
  */
-template<typename E>
-void List<E>::clear()
+template<typename E, typename Allocator>
+void List<E, Allocator>::clear() noexcept
 {
-    if (empty()) return;
-    if (sentinel == nullptr) return;
-
-    Node* current = sentinel->next;
+    ListNodeBase* current = sentinel.next;
     // 释放每个结点内存
-    while (current != sentinel)
+    while (current != &sentinel)
     {
-        sentinel->next = current->next;
-        delete current;
-        current = sentinel->next;
+        ListNodeBase* next = current->next;
+        destroy_node(current);
+        current = next;
     }
-    sentinel->prev = sentinel;
+    sentinel.next = sentinel.prev = &sentinel;
     n = 0;
 }
 
+/**
+ * 把另一个链表的所有结点转移到pos之前，that变为空链表.
+ *
+ * @param pos: 转移位置
+ *        that: 另一个链表，不能是这个链表
+ */
+template<typename E, typename Allocator>
+void List<E, Allocator>::splice(const_iterator pos, List& that)
+{
+    if (this != &that)
+        splice(pos, that, that.cbegin(), that.cend());
+}
+
+/**
+ * 把另一个链表中[first, last)的结点转移到pos之前.
+ * 两个分配器相等或能够共享内存池时只修改指针，不分配内存，
+ * 转移另一个链表的部分结点需要遍历一次区间来计算结点个数；
+ * 否则逐个移动元素，相当于在pos之前添加再从that中移除.
+ * that是这个链表时pos不能在[first, last)中.
+ *
+ * @param pos: 转移位置
+ *        that: [first, last)所在的链表
+ *        first: 第一个转移的元素
+ *        last: 最后一个转移的元素的下一个位置
+ */
+template<typename E, typename Allocator>
+void List<E, Allocator>::splice(const_iterator pos, List& that, const_iterator first, const_iterator last)
+{
+    if (first == last)
+        return;
+    if (this != &that)
+    {
+        if (!adopt_nodes(allocator, that.allocator, 0))
+        {
+            while (first != last)
+            {
+                emplace(pos, std::move(value(first.node)));
+                that.remove(first++);
+            }
+            return;
+        }
+        size_type count = first == that.cbegin() && last == that.cend()
+                          ? that.n : size_type(std::distance(first, last));
+        n += count;
+        that.n -= count;
+    }
+    transfer(pos.node, first.node, last.node);
+}
+
+/**
+ * 合并另一个有序链表，that变为空链表.
+ * 每次把that中一段小于当前元素的连续结点转移到当前元素之前，
+ * 相等的元素中这个链表的元素在前，合并是稳定的.
+ *
+ * @param that: 另一个有序链表
+ *        comp: 比较函数，comp(a, b)为true时a排在b之前
+ */
+template<typename E, typename Allocator>
+template<typename Compare>
+void List<E, Allocator>::merge(List& that, Compare comp)
+{
+    if (this == &that)
+        return;
+    const_iterator it = cbegin();
+    while (!that.empty())
+    {
+        const_iterator first = that.cbegin();
+        while (it != cend() && !comp(*first, *it))
+            ++it;
+        if (it == cend())
+        {
+            splice(it, that);
+            return;
+        }
+        const_iterator last = std::next(first);
+        while (last != that.cend() && comp(*last, *it))
+            ++last;
+        splice(it, that, first, last);
+    }
+}
+
+/**
+ * 合并两段以nullptr结尾的有序结点，只修改next指针.
+ * 相等的元素中left的元素在前.
+ * comp抛出异常时所有结点按已合并、left剩余、right剩余的顺序连接到left，right变为nullptr.
+ *
+ * @param left: 前一段结点
+ *        right: 后一段结点
+ *        comp: 比较函数
+ * @return 合并后的第一个结点
+ */
+template<typename E, typename Allocator>
+template<typename Compare>
+ListNodeBase* List<E, Allocator>::merge_runs(ListNodeBase*& left, ListNodeBase*& right, Compare& comp)
+{
+    // 在局部变量中合并，避免通过引用反复读写
+    ListNodeBase* a = left;
+    ListNodeBase* b = right;
+    ListNodeBase* head = nullptr;
+    ListNodeBase** tail = &head;
+    try
+    {
+        while (a != nullptr && b != nullptr)
+        {
+            if (comp(value(b), value(a)))
+            {
+                *tail = b;
+                tail = &b->next;
+                b = b->next;
+            }
+            else
+            {
+                *tail = a;
+                tail = &a->next;
+                a = a->next;
+            }
+        }
+    }
+    catch (...)
+    {
+        *tail = concat(a, b);
+        left = head;
+        right = nullptr;
+        throw;
+    }
+    *tail = a != nullptr ? a : b;
+    left = right = nullptr;
+    return head;
+}
+
+/**
+ * 连接两段以nullptr结尾的结点.
+ *
+ * @param first: 前一段结点
+ *        second: 后一段结点
+ * @return 连接后的第一个结点
+ */
+template<typename E, typename Allocator>
+ListNodeBase* List<E, Allocator>::concat(ListNodeBase* first, ListNodeBase* second) noexcept
+{
+    if (first == nullptr)
+        return second;
+    ListNodeBase* last = first;
+    while (last->next != nullptr)
+        last = last->next;
+    last->next = second;
+    return first;
+}
+
+/**
+ * 自底向上的稳定归并排序，只修改指针，不移动元素.
+ * 逐个取出结点，bins[i]保存长为2^i的有序段，像二进制计数器的进位一样
+ * 把新的段与已有的同长度段合并，最后从短到长合并所有段，再恢复prev指针.
+ * 大部分合并发生在刚取出的相邻结点之间，比每轮遍历整个链表的缓存局部性好.
+ * comp抛出异常时所有结点仍在链表中，但顺序不确定.
+ *
+ * @param comp: 比较函数，comp(a, b)为true时a排在b之前
+ */
+template<typename E, typename Allocator>
+template<typename Compare>
+void List<E, Allocator>::sort(Compare comp)
+{
+    if (n < 2)
+        return;
+    ListNodeBase* bins[sizeof(size_type) * 8] = {};
+    size_type used = 0;                 // 使用过的bins个数
+    ListNodeBase* carry = nullptr;      // 正在合并的段
+    ListNodeBase* rest = sentinel.next; // 未取出的结点
+    sentinel.prev->next = nullptr;
+    try
+    {
+        while (rest != nullptr)
+        {
+            carry = rest;
+            rest = rest->next;
+            carry->next = nullptr;
+            size_type i = 0;
+            for (; bins[i] != nullptr; ++i)
+                carry = merge_runs(bins[i], carry, comp);
+            bins[i] = carry;
+            carry = nullptr;
+            used = std::max(used, i + 1);
+        }
+        for (size_type i = 0; i < used; ++i)
+            if (bins[i] != nullptr)
+                carry = merge_runs(bins[i], carry, comp);
+    }
+    catch (...)
+    {
+        // 把所有段和未取出的结点连接起来
+        carry = concat(carry, rest);
+        for (size_type i = 0; i < used; ++i)
+            carry = concat(bins[i], carry);
+        relink(carry);
+        throw;
+    }
+    relink(carry);
+}
+
+/**
+ * 按next指针重新设置所有prev指针，恢复带哨兵的循环链表.
+ *
+ * @param head: 以nullptr结尾的第一个结点
+ */
+template<typename E, typename Allocator>
+void List<E, Allocator>::relink(ListNodeBase* head) noexcept
+{
+    ListNodeBase* prec = &sentinel;
+    for (ListNodeBase* node = head; node != nullptr; prec = node, node = node->next)
+        node->prev = prec;
+    sentinel.next = head;
+    sentinel.prev = prec;
+    prec->next = &sentinel;
+}
+
 /**
  * =操作符重载.
  * 让当前List对象等于给定List对象that.
@@ -376,10 +727,11 @@ void List<E>::clear()
  * @param that: List对象that
  * @return 当前List对象
  */
-template<typename E>
-List<E>& List<E>::operator=(List<E> that)
+template<typename E, typename Allocator>
+List<E, Allocator>& List<E, Allocator>::operator=(List that)
 {
-    swap(that);
+    clear();
+    take(that);
     return *this;
 }
 
@@ -390,14 +742,46 @@ List<E>& List<E>::operator=(List<E> that)
  * @param that: List对象that
  * @return 当前List对象
  */
-template<typename E>
-List<E>& List<E>::operator+=(const List<E>& that)
+template<typename E, typename Allocator>
+List<E, Allocator>& List<E, Allocator>::operator+=(const List& that)
 {
-    for (auto i : that)
-        insert_back(i);
+    // that与当前对象相同时，只复制原有的元素
+    size_type count = that.size();
+    auto it = that.begin();
+    for (size_type i = 0; i < count; ++i, ++it)
+        insert_back(*it);
     return *this;
 }
 
+/**
+ * +=操作符重载.
+ * 把另一个对象的所有结点转移到当前对象的尾部，不复制元素.
+ *
+ * @param that: 要转移的List对象
+ * @return 当前List对象
+ */
+template<typename E, typename Allocator>
+List<E, Allocator>& List<E, Allocator>::operator+=(List&& that)
+{
+    splice(cend(), that);
+    return *this;
+}
+
+/**
+ * +操作符重载.
+ * 返回一个包含lhs和rhs所有元素的对象，rhs的结点直接转移到结果中.
+ *
+ * @param lhs: List对象lhs
+ *        rhs: 要转移的List对象rhs
+ * @return 包含lhs和rhs所有元素的List对象
+ */
+template<typename E, typename Allocator>
+List<E, Allocator> operator+(List<E, Allocator> lhs, List<E, Allocator>&& rhs)
+{
+    lhs += std::move(rhs);
+    return lhs;
+}
+
 /**
  * +操作符重载.
  * 返回一个包含lhs和rhs所有元素的对象.
@@ -406,8 +790,8 @@ List<E>& List<E>::operator+=(const List<E>& that)
  *        rhs: List对象rhs
  * @return 包含lhs和rhs所有元素的List对象
  */
-template<typename E>
-List<E> operator+(List<E> lhs, const List<E>& rhs)
+template<typename E, typename Allocator>
+List<E, Allocator> operator+(List<E, Allocator> lhs, const List<E, Allocator>& rhs)
 {
     lhs += rhs;
     return lhs;
@@ -421,8 +805,8 @@ List<E> operator+(List<E> lhs, const List<E>& rhs)
  * @return true: 相等
  *         false: 不等
  */
-template<typename E>
-bool operator==(const List<E>& lhs, const List<E>& rhs)
+template<typename E, typename Allocator>
+bool operator==(const List<E, Allocator>& lhs, const List<E, Allocator>& rhs)
 {
     if (&lhs == &rhs)             return true;
     if (lhs.size() != rhs.size()) return false;
@@ -437,8 +821,8 @@ bool operator==(const List<E>& lhs, const List<E>& rhs)
  * @return true: 不等
  *         false: 相等
  */
-template<typename E>
-bool operator!=(const List<E>& lhs, const List<E>& rhs)
+template<typename E, typename Allocator>
+bool operator!=(const List<E, Allocator>& lhs, const List<E, Allocator>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -450,10 +834,10 @@ bool operator!=(const List<E>& lhs, const List<E>& rhs)
  *        list: 要输出的链表
  * @return 输出流对象
  */
-template<typename E>
-std::ostream& operator<<(std::ostream& os, const List<E>& list)
+template<typename E, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const List<E, Allocator>& list)
 {
-    for (auto i : list)
+    for (auto& i : list)
         os << i << " ";
     return os;
 }
@@ -464,10 +848,76 @@ std::ostream& operator<<(std::ostream& os, const List<E>& list)
  * @param lhs: List对象lhs
  *        rhs: List对象rhs
  */
-template<typename E>
-void swap(List<E>& lhs, List<E>& rhs)
+template<typename E, typename Allocator>
+void swap(List<E, Allocator>& lhs, List<E, Allocator>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
 
+/**
+ * 链表的双向迭代器.
+ * 迭代器指向结点的链接部分，解引用时转换为完整的结点.
+ * 尾迭代器指向哨兵结点.
+ */
+template<typename E, typename Ptr, typename Ref>
+class ListIterator
+{
+public:
+    // 成员类型定义
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = E;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    // 迭代器定义
+    using iterator          = ListIterator<E, E*, E&>;
+    using const_iterator    = ListIterator<E, const E*, const E&>;
+private:
+    using node_pointer      = ListNodeBase*;
+public:
+    ListIterator() noexcept : node(nullptr) {}
+    explicit ListIterator(const ListNodeBase* node) noexcept
+    : node(const_cast<node_pointer>(node)) {}
+    ListIterator(const iterator& that) noexcept : node(that.node) {}
+    ListIterator& operator=(const ListIterator& that) noexcept = default;
+
+    reference operator*() const noexcept
+    { return static_cast<ListNode<E>*>(node)->elem; }
+    pointer operator->() const noexcept
+    { return &static_cast<ListNode<E>*>(node)->elem; }
+    ListIterator& operator++() noexcept
+    {
+        node = node->next;
+        return *this;
+    }
+    ListIterator operator++(int) noexcept
+    {
+        ListIterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+    ListIterator& operator--() noexcept
+    {
+        node = node->prev;
+        return *this;
+    }
+    ListIterator operator--(int) noexcept
+    {
+        ListIterator tmp(*this);
+        --*this;
+        return tmp;
+    }
+    bool operator==(const ListIterator& that) const noexcept
+    { return node == that.node; }
+    bool operator!=(const ListIterator& that) const noexcept
+    { return node != that.node; }
+private:
+    node_pointer node; // 指向当前结点
+
+    template<typename T, typename A>
+    friend class List;
+    friend class ListIterator<E, E*, E&>;
+    friend class ListIterator<E, const E*, const E&>;
+};
+
 } // namespace cpplib
@@ -0,0 +1,655 @@
+/*******************************************************************************
+ * MmapVector.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Simd.h"
+#include "Vector.h"
+
+namespace cpplib
+{
+
+/**
+ * MmapVector打开文件的方式.
+ * ReadWrite: 读写打开，文件不存在时创建，修改和扩容直接写回文件；
+ * ReadOnly: 只读打开，不能修改元素和容量；
+ * CopyOnWrite: 私有映射，修改只对当前对象可见，不写回文件.
+ */
+enum class MmapMode { ReadWrite, ReadOnly, CopyOnWrite };
+
+/**
+ * 使用模板实现的文件映射Vector.
+ * 文件内容就是连续存放的元素，文件大小为元素个数乘以sizeof(E).
+ * 打开时只建立映射，不读取和解析数据，访问到的页由操作系统按需从页缓存载入，
+ * 可以处理比内存更大的数组.
+ * 读写方式扩容时先用ftruncate扩展文件，再用mremap扩展映射；析构时把文件截断到元素个数.
+ * 写时复制方式第一次改变容量时把元素复制到匿名映射，之后与读写方式一样用mremap扩容.
+ * 默认构造的对象不关联文件，元素存放在匿名映射中.
+ * 只读方式下返回可修改元素的迭代器或引用会抛出异常，需要通过const对象访问元素.
+ * 提供与Vector相同的接口，元素类型必须是平凡可复制的.
+ */
+template<typename E, typename Policy = GrowthFactor<>>
+class MmapVector
+{
+    static_assert(std::is_trivially_copyable<E>::value, "MmapVector requires trivially copyable elements");
+public:
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using growth_policy   = Policy;
+    // 原生指针具备随机访问迭代器的一切特征
+    using iterator               = E*;
+    using const_iterator         = const E*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+public:
+    MmapVector() noexcept : fd(-1), mode(MmapMode::ReadWrite), anonymous(true), n(0), N(0), pv(nullptr) {}
+    explicit MmapVector(const std::string& path, MmapMode mode = MmapMode::ReadWrite);
+    MmapVector(const MmapVector&) = delete;
+    MmapVector(MmapVector&& that) noexcept;
+    ~MmapVector();
+    MmapVector& operator=(MmapVector that) noexcept { swap(that); return *this; }
+
+    iterator begin() { check_writable(); return pv; }
+    iterator end()   { check_writable(); return pv + n; }
+    const_iterator begin()  const noexcept { return pv; }
+    const_iterator end()    const noexcept { return pv + n; }
+    const_iterator cbegin() const noexcept { return pv; }
+    const_iterator cend()   const noexcept { return pv + n; }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend()   { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    // 返回元素的数量
+    size_type size() const noexcept { return n; }
+    // 返回容量
+    size_type capacity() const noexcept { return N; }
+    // 返回可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(E); }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 返回打开文件的方式
+    MmapMode open_mode() const noexcept { return mode; }
+    // 预留至少容纳count个元素的容量，不会减小容量
+    void reserve(size_type count) { check_writable(); if (count > N) reallocate(count); }
+    // 收缩容量到元素个数
+    void shrink_to_fit() { check_writable(); if (n < N) reallocate(n); }
+    // 改变元素的数量，新增的元素值初始化
+    void resize(size_type count) { resize(count, E()); }
+    // 改变元素的数量，新增的元素复制value
+    void resize(size_type count, const E& value);
+    // 在尾部直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    // 添加元素到指定位置
+    void insert(const_iterator pos, const E& elem);
+    // 添加元素到尾部
+    void insert_back(const E& elem) { emplace_back(elem); }
+    // 添加迭代器范围内的元素到尾部，范围不能是当前对象的元素
+    template<typename InputIt>
+    void append(InputIt first, InputIt last);
+    // 移除指定位置的元素
+    void remove(const_iterator pos);
+    // 移除尾部元素
+    void remove_back();
+    // 返回指定位置元素的引用，带边界检查
+    E& at(size_type i) { check_writable(); return const_cast<E&>(static_cast<const MmapVector&>(*this).at(i)); }
+    // 返回指定位置元素的const引用，带边界检查
+    const E& at(size_type i) const;
+    // 返回头部元素的引用
+    E& front() { check_writable(); return const_cast<E&>(static_cast<const MmapVector&>(*this).front()); }
+    // 返回头部元素的const引用
+    const E& front() const;
+    // 返回尾部元素的引用
+    E& back() { check_writable(); return const_cast<E&>(static_cast<const MmapVector&>(*this).back()); }
+    // 返回尾部元素的const引用
+    const E& back() const;
+    // 查找第一个等于value的元素，没有时返回end()
+    iterator find(const E& value) { check_writable(); return pv + simd::find(cbegin(), n, value); }
+    const_iterator find(const E& value) const { return pv + simd::find(cbegin(), n, value); }
+    // 统计等于value的元素个数
+    size_type count(const E& value) const { return simd::count(cbegin(), n, value); }
+    // 返回所有元素的和，整数扩展到64位累加
+    typename simd::sum_type<E>::type sum() const { return simd::sum(cbegin(), n); }
+    // 内容与另一个MmapVector对象交换
+    void swap(MmapVector& that) noexcept;
+    // 清空元素，容量不变
+    void clear() { check_writable(); n = 0; }
+    // 把修改过的页同步写回文件
+    void sync();
+    // 解除映射，读写方式下把文件截断到元素个数并关闭文件，之后对象不关联文件且为空
+    void close();
+
+    // 返回指定位置元素的引用，无边界检查
+    E& operator[](size_type i) { check_writable(); return pv[i]; }
+    // 返回指定位置元素的const引用，无边界检查
+    const E& operator[](size_type i) const { return pv[i]; }
+private:
+    // 只读方式下拒绝修改，也拒绝返回可修改元素的迭代器或引用
+    void check_writable() const
+    {
+        if (mode == MmapMode::ReadOnly)
+            throw std::logic_error("MmapVector: read-only");
+    }
+    // 调整容量，元素按字节搬移
+    void reallocate(size_type count);
+    // 按增长策略扩容后的容量，至少容纳required个元素
+    size_type grow_capacity(size_type required) const noexcept
+    { return Policy::grow(N, required); }
+    // 移除元素后按增长策略收缩
+    void shrink()
+    {
+        size_type count = Policy::shrink(n, N);
+        if (count < N)
+            reallocate(count);
+    }
+    // 把文件大小设置为bytes字节
+    void truncate(std::size_t bytes);
+    // 容纳count个元素的映射空间按页大小向上取整的字节数
+    static std::size_t mapped_bytes(size_type count) noexcept;
+    // 系统调用失败时抛出带有错误码的异常
+    [[noreturn]] static void fail(const char* what, int error = errno)
+    { throw std::system_error(error, std::generic_category(), what); }
+    // 添加范围内的元素前预留空间，只有前向迭代器可以预先计算元素个数
+    template<typename InputIt>
+    void reserve_for(InputIt, InputIt, std::input_iterator_tag) {}
+    template<typename ForwardIt>
+    void reserve_for(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+    {
+        size_type count = size_type(std::distance(first, last));
+        if (n + count > N)
+            reallocate(grow_capacity(n + count));
+    }
+    // 检查索引是否合法
+    bool valid(size_type i) const noexcept { return i < n; }
+private:
+    int fd;          // 读写方式打开的文件，其他情况为-1
+    MmapMode mode;   // 打开文件的方式
+    bool anonymous;  // 元素是否存放在匿名映射中
+    size_type n;     // 元素个数
+    size_type N;     // 容量
+    E* pv;           // 映射空间
+};
+
+/**
+ * MmapVector构造函数，映射文件中的所有元素.
+ * 只建立映射，不读取文件内容.
+ *
+ * @param path: 文件路径
+ *        mode: 打开文件的方式
+ * @throws std::system_error: 打开、查询或映射文件失败
+ *         std::runtime_error: 文件大小不是sizeof(E)的整数倍
+ */
+template<typename E, typename Policy>
+MmapVector<E, Policy>::MmapVector(const std::string& path, MmapMode mode)
+: fd(-1), mode(mode), anonymous(false), n(0), N(0), pv(nullptr)
+{
+    int flags = mode == MmapMode::ReadWrite ? O_RDWR | O_CREAT : O_RDONLY;
+    int file = ::open(path.c_str(), flags, 0644);
+    if (file < 0)
+        fail("MmapVector::open");
+    struct stat st;
+    if (fstat(file, &st) != 0)
+    {
+        int error = errno;
+        ::close(file);
+        fail("MmapVector::open", error);
+    }
+    std::size_t bytes = std::size_t(st.st_size);
+    if (bytes % sizeof(E) != 0)
+    {
+        ::close(file);
+        throw std::runtime_error("MmapVector: file size is not a multiple of element size");
+    }
+    if (bytes > 0)
+    {
+        int prot = mode == MmapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        int share = mode == MmapMode::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+        void* p = mmap(nullptr, bytes, prot, share, file, 0);
+        if (p == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(file);
+            fail("MmapVector::open", error);
+        }
+        pv = static_cast<pointer>(p);
+    }
+    n = N = bytes / sizeof(E);
+    // 只有读写方式需要保留文件用于扩容，其他方式的映射在文件关闭后仍然有效
+    if (mode == MmapMode::ReadWrite)
+        fd = file;
+    else
+        ::close(file);
+}
+
+/**
+ * MmapVector移动构造函数.
+ * 接管另一个对象的映射和文件，that变为不关联文件的空对象.
+ *
+ * @param that: 被移动的MmapVector
+ */
+template<typename E, typename Policy>
+MmapVector<E, Policy>::MmapVector(MmapVector&& that) noexcept
+: MmapVector()
+{
+    swap(that);
+}
+
+/**
+ * MmapVector析构函数.
+ * 关闭失败时无法报告，忽略异常，需要知道结果时应在析构前调用close().
+ */
+template<typename E, typename Policy>
+MmapVector<E, Policy>::~MmapVector()
+{
+    try
+    {
+        close();
+    }
+    catch (const std::system_error&)
+    {
+    }
+}
+
+/**
+ * 解除映射，读写方式下把文件截断到元素个数并关闭文件.
+ * 无论是否失败，之后对象都与默认构造的对象相同.
+ *
+ * @throws std::system_error: 截断文件失败，文件大小仍为容量
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::close()
+{
+    int error = 0;
+    if (pv != nullptr)
+        munmap(static_cast<void*>(pv), mapped_bytes(N));
+    if (fd >= 0)
+    {
+        if (ftruncate(fd, off_t(n * sizeof(E))) != 0)
+            error = errno;
+        ::close(fd);
+    }
+    fd = -1;
+    mode = MmapMode::ReadWrite;
+    anonymous = true;
+    pv = nullptr;
+    n = N = 0;
+    if (error != 0)
+        fail("MmapVector::close", error);
+}
+
+/**
+ * 调整容量.
+ * 读写方式先改变文件大小，再用mremap改变映射的大小，只移动页表项而不复制数据；
+ * 私有的文件映射超出文件末尾的部分不能访问，第一次改变容量时复制到匿名映射；
+ * 匿名映射用mremap改变大小.
+ *
+ * @param count: 新容量
+ * @throws std::length_error: 容量超过max_size()
+ *         std::system_error: 改变文件大小或映射失败
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::reallocate(size_type count)
+{
+    if (count < n)
+        count = n;
+    if (count == N)
+        return;
+    if (count > max_size())
+        throw std::length_error("MmapVector::reserve");
+
+    std::size_t old_bytes = mapped_bytes(N);
+    std::size_t new_bytes = mapped_bytes(count);
+    void* p = nullptr;
+    if (fd >= 0)
+    {
+        // 扩容时先扩展文件，映射的页才有文件内容对应；收缩时先缩小映射
+        if (count > N)
+            truncate(count * sizeof(E));
+        if (old_bytes == 0)
+            p = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        else if (new_bytes == 0)
+            munmap(static_cast<void*>(pv), old_bytes);
+#if defined(__linux__)
+        else
+            p = mremap(static_cast<void*>(pv), old_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+        else
+        {
+            // 共享映射的内容都在文件中，重新映射即可
+            p = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED)
+                munmap(static_cast<void*>(pv), old_bytes);
+        }
+#endif
+        if (p == MAP_FAILED)
+            fail("MmapVector::reserve");
+        if (count < N)
+            truncate(count * sizeof(E));
+    }
+    else if (new_bytes == 0)
+    {
+        munmap(static_cast<void*>(pv), old_bytes);
+    }
+#if defined(__linux__)
+    else if (anonymous && old_bytes != 0)
+    {
+        p = mremap(static_cast<void*>(pv), old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+            fail("MmapVector::reserve");
+    }
+#endif
+    else
+    {
+        p = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            fail("MmapVector::reserve");
+        if (n > 0)
+            std::memcpy(p, static_cast<const void*>(pv), n * sizeof(E));
+        if (old_bytes != 0)
+            munmap(static_cast<void*>(pv), old_bytes);
+        anonymous = true;
+    }
+    pv = static_cast<pointer>(p);
+    N = count;
+}
+
+/**
+ * 把文件大小设置为bytes字节.
+ *
+ * @param bytes: 新的文件大小
+ * @throws std::system_error: ftruncate失败
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::truncate(std::size_t bytes)
+{
+    if (ftruncate(fd, off_t(bytes)) != 0)
+        fail("MmapVector::truncate");
+}
+
+/**
+ * 返回容纳count个元素的映射空间的字节数，按页大小向上取整.
+ *
+ * @param count: 元素个数
+ * @return 映射空间的字节数
+ */
+template<typename E, typename Policy>
+std::size_t MmapVector<E, Policy>::mapped_bytes(size_type count) noexcept
+{
+    std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+    return (count * sizeof(E) + page - 1) / page * page;
+}
+
+/**
+ * 改变元素的数量.
+ * 元素数量增加时，新增的元素复制value；减少时，丢弃多余的元素.
+ *
+ * @param count: 新的元素数量
+ *        value: 新增元素的值
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::resize(size_type count, const E& value)
+{
+    check_writable();
+    if (count > N)
+    {
+        // value可能引用对象中的元素，先复制再扩容
+        E tmp(value);
+        reallocate(grow_capacity(count));
+        std::fill(pv + n, pv + count, tmp);
+    }
+    else if (count > n)
+        std::fill(pv + n, pv + count, value);
+    n = count;
+}
+
+/**
+ * 在尾部直接构造元素.
+ * 容量已满时，按增长策略扩容后，再构造元素.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename Policy>
+template<typename... Args>
+void MmapVector<E, Policy>::emplace_back(Args&&... args)
+{
+    check_writable();
+    // 参数可能引用对象中的元素，先构造再扩容
+    E elem(std::forward<Args>(args)...);
+    if (n == N)
+        reallocate(grow_capacity(n + 1));
+    pv[n++] = elem;
+}
+
+/**
+ * 添加元素到指定位置.
+ *
+ * @param pos: 要添加元素的位置
+ *        elem: 要添加的元素
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::insert(const_iterator pos, const E& elem)
+{
+    check_writable();
+    size_type i = size_type(pos - cbegin());
+    if (i > n)
+        throw std::out_of_range("MmapVector::insert");
+    E tmp(elem);
+    if (n == N)
+        reallocate(grow_capacity(n + 1));
+    std::memmove(static_cast<void*>(pv + i + 1), static_cast<const void*>(pv + i), (n - i) * sizeof(E));
+    pv[i] = tmp;
+    ++n;
+}
+
+/**
+ * 添加迭代器范围内的元素到尾部.
+ * 前向迭代器范围按增长策略一次扩容.
+ *
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
+ */
+template<typename E, typename Policy>
+template<typename InputIt>
+void MmapVector<E, Policy>::append(InputIt first, InputIt last)
+{
+    check_writable();
+    reserve_for(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+/**
+ * 移除指定位置的元素.
+ * 移除后按增长策略收缩容量.
+ *
+ * @param pos: 要移除元素的位置
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::remove(const_iterator pos)
+{
+    check_writable();
+    size_type i = size_type(pos - cbegin());
+    if (!valid(i))
+        throw std::out_of_range("MmapVector::remove");
+    std::memmove(static_cast<void*>(pv + i), static_cast<const void*>(pv + i + 1), (n - i - 1) * sizeof(E));
+    --n;
+    shrink();
+}
+
+/**
+ * 移除尾部元素.
+ * 移除后按增长策略收缩容量.
+ *
+ * @throws std::out_of_range: 对象为空
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::remove_back()
+{
+    check_writable();
+    if (empty())
+        throw std::out_of_range("MmapVector::remove_back");
+    --n;
+    shrink();
+}
+
+/**
+ * 返回头部元素的const引用.
+ *
+ * @return 头部元素的const引用
+ * @throws std::out_of_range: 对象为空
+ */
+template<typename E, typename Policy>
+const E& MmapVector<E, Policy>::front() const
+{
+    if (empty())
+        throw std::out_of_range("MmapVector::front");
+    return *begin();
+}
+
+/**
+ * 返回尾部元素的const引用.
+ *
+ * @return 尾部元素的const引用
+ * @throws std::out_of_range: 对象为空
+ */
+template<typename E, typename Policy>
+const E& MmapVector<E, Policy>::back() const
+{
+    if (empty())
+        throw std::out_of_range("MmapVector::back");
+    return *std::prev(end());
+}
+
+/**
+ * 返回指定位置元素的const引用，并进行越界检查.
+ *
+ * @return 指定位置元素的const引用
+ * @throws std::out_of_range: 索引不合法
+ */
+template<typename E, typename Policy>
+const E& MmapVector<E, Policy>::at(size_type i) const
+{
+    if (!valid(i))
+        throw std::out_of_range("MmapVector::at");
+    return (*this)[i];
+}
+
+/**
+ * 交换当前MmapVector对象和另一个MmapVector对象，包括映射和文件.
+ *
+ * @param that: MmapVector对象that
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::swap(MmapVector& that) noexcept
+{
+    using std::swap;
+    swap(fd, that.fd);
+    swap(mode, that.mode);
+    swap(anonymous, that.anonymous);
+    swap(n, that.n);
+    swap(N, that.N);
+    swap(pv, that.pv);
+}
+
+/**
+ * 把修改过的页同步写回文件，返回时数据已经落盘.
+ * 只对读写方式有效，其他方式不写回文件.
+ *
+ * @throws std::system_error: msync失败
+ */
+template<typename E, typename Policy>
+void MmapVector<E, Policy>::sync()
+{
+    if (fd < 0 || pv == nullptr)
+        return;
+    if (msync(static_cast<void*>(pv), mapped_bytes(N), MS_SYNC) != 0)
+        fail("MmapVector::sync");
+}
+
+/**
+ * ==操作符重载函数，比较两个MmapVector对象是否相等.
+ *
+ * @param lhs: MmapVector对象lhs
+ *        rhs: MmapVector对象rhs
+ * @return true: 相等
+ *         false: 不等
+ */
+template<typename E, typename Policy>
+bool operator==(const MmapVector<E, Policy>& lhs, const MmapVector<E, Policy>& rhs)
+{
+    if (&lhs == &rhs)             return true;
+    if (lhs.size() != rhs.size()) return false;
+    return simd::equal(lhs.begin(), rhs.begin(), lhs.size());
+}
+
+/**
+ * !=操作符重载函数，比较两个MmapVector对象是否不等.
+ *
+ * @param lhs: MmapVector对象lhs
+ *        rhs: MmapVector对象rhs
+ * @return true: 不等
+ *         false: 相等
+ */
+template<typename E, typename Policy>
+bool operator!=(const MmapVector<E, Policy>& lhs, const MmapVector<E, Policy>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * <<操作符重载函数，打印所有元素.
+ *
+ * @param os: 输出流对象
+ *        vector: 要输出的MmapVector
+ * @return 输出流对象
+ */
+template<typename E, typename Policy>
+std::ostream& operator<<(std::ostream& os, const MmapVector<E, Policy>& vector)
+{
+    for (auto& i : vector)
+        os << i << " ";
+    return os;
+}
+
+/**
+ * 交换两个MmapVector对象.
+ *
+ * @param lhs: MmapVector对象lhs
+ *        rhs: MmapVector对象rhs
+ */
+template<typename E, typename Policy>
+void swap(MmapVector<E, Policy>& lhs, MmapVector<E, Policy>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace cpplib
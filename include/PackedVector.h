@@ -0,0 +1,744 @@
+/*******************************************************************************
+ * PackedVector.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Simd.h"
+#include "Vector.h"
+
+namespace cpplib
+{
+
+// 位压缩Vector的随机访问迭代器，Packed为容器类型（可带const），Ref为解引用的结果类型
+template<typename Packed, typename Ref>
+class PackedIterator;
+
+/**
+ * 使用模板实现的定宽位压缩Vector.
+ * 每个元素是Bits位的无符号整数，元素按位紧密排列在64位整数数组中，
+ * 第i个元素占据第i * Bits位起的Bits位，可能跨越两个64位整数.
+ * 与Vector<std::uint32_t>相比，Bits为10到20时内存和带宽减少到约1 / 3到2 / 3，
+ * 代价是每次访问多一次移位和屏蔽.
+ * 元素不是独立的对象，operator[]和迭代器返回代理对象，不能取元素的地址.
+ * 连续读取大量元素时使用unpack批量解压.
+ */
+template<unsigned Bits, typename Policy = GrowthFactor<>>
+class PackedVector
+{
+    static_assert(Bits >= 1 && Bits <= 64, "bit width must be between 1 and 64");
+public:
+    // 成员类型定义
+    using value_type      = typename std::conditional<Bits <= 32, std::uint32_t, std::uint64_t>::type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using growth_policy   = Policy;
+    // 元素的代理引用，读取时转换为value_type，赋值时写回压缩数组
+    class reference;
+    using const_reference = value_type;
+    // 迭代器定义
+    using iterator               = PackedIterator<PackedVector, reference>;
+    using const_iterator         = PackedIterator<const PackedVector, value_type>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // 每个元素的位数
+    static constexpr unsigned BITS = Bits;
+    // 元素的最大值
+    static constexpr value_type MAX_VALUE =
+            std::numeric_limits<value_type>::max() >> (sizeof(value_type) * 8 - Bits);
+private:
+    using word_type = std::uint64_t;
+    static constexpr unsigned WORD_BITS = 64;
+    static constexpr word_type MASK = word_type(MAX_VALUE);
+public:
+    PackedVector() : n(0) {}
+    explicit PackedVector(size_type count, value_type value = 0);
+    PackedVector(std::initializer_list<value_type> ilist);
+    PackedVector(const PackedVector&) = default;
+    PackedVector(PackedVector&& that) noexcept : words(std::move(that.words)), n(that.n) { that.n = 0; }
+    PackedVector& operator=(PackedVector that) noexcept { swap(that); return *this; }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end()   noexcept { return iterator(this, n); }
+    const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+    const_iterator end()    const noexcept { return const_iterator(this, n); }
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cend()   const noexcept { return const_iterator(this, n); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    // 返回元素的数量
+    size_type size() const noexcept { return n; }
+    // 返回不重新分配时可容纳的元素数量
+    size_type capacity() const noexcept { return words.capacity() * WORD_BITS / Bits; }
+    // 返回可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / Bits; }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 返回压缩数组占用的字节数
+    size_type bytes() const noexcept { return words.size() * sizeof(word_type); }
+    // 预留至少容纳count个元素的容量，不会减小容量
+    void reserve(size_type count) { words.reserve(words_for(count)); }
+    // 收缩容量到元素个数
+    void shrink_to_fit() { words.shrink_to_fit(); }
+    // 改变元素的数量，新增的元素等于value
+    void resize(size_type count, value_type value = 0);
+    // 返回第i个元素，不检查边界
+    value_type get(size_type i) const noexcept;
+    // 设置第i个元素，不检查边界，值超过MAX_VALUE时抛出std::out_of_range
+    void set(size_type i, value_type value);
+    // 添加元素到尾部
+    void insert_back(value_type value);
+    // 添加迭代器范围内的元素到尾部
+    template<typename InputIt>
+    void append(InputIt first, InputIt last);
+    // 移除尾部元素
+    void remove_back();
+    // 移除所有元素，保留容量
+    void clear() noexcept { words.clear(); n = 0; }
+    // 返回指定位置的元素，带边界检查
+    value_type at(size_type i) const;
+    // 返回头部元素
+    value_type front() const;
+    // 返回尾部元素
+    value_type back() const;
+    // 把从pos起的count个元素解压到out，带边界检查
+    void unpack(size_type pos, size_type count, value_type* out) const;
+    // 内容与另一个PackedVector对象交换
+    void swap(PackedVector& that) noexcept { words.swap(that.words); std::swap(n, that.n); }
+
+    // 下标运算符，不检查边界
+    reference operator[](size_type i) noexcept { return reference(this, i); }
+    value_type operator[](size_type i) const noexcept { return get(i); }
+
+    // 元素的代理引用
+    class reference
+    {
+    public:
+        reference(const reference&) noexcept = default;
+        operator value_type() const noexcept { return pv->get(i); }
+        reference& operator=(value_type value) { pv->set(i, value); return *this; }
+        reference& operator=(const reference& that) { return *this = value_type(that); }
+        // 交换两个代理引用指向的元素，供std::reverse等算法使用
+        friend void swap(reference lhs, reference rhs)
+        {
+            value_type tmp = lhs;
+            lhs = value_type(rhs);
+            rhs = tmp;
+        }
+    private:
+        reference(PackedVector* pv, size_type i) noexcept : pv(pv), i(i) {}
+
+        PackedVector* pv; // 所属的容器
+        size_type i;      // 元素的下标
+
+        friend class PackedVector;
+    };
+private:
+    // 容纳count个元素需要的64位整数个数
+    static size_type words_for(size_type count) noexcept
+    { return (count * Bits + WORD_BITS - 1) / WORD_BITS; }
+    // 值超过MAX_VALUE时抛出std::out_of_range
+    static void check_value(value_type value);
+    // 添加范围内的元素前预留空间，只有前向迭代器可以预先计算元素个数
+    template<typename InputIt>
+    void reserve_for(InputIt, InputIt, std::input_iterator_tag) {}
+    template<typename ForwardIt>
+    void reserve_for(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+    { reserve(n + size_type(std::distance(first, last))); }
+    // unpack的实现，位宽不超过32时可以使用向量化的解压
+    void unpack(size_type pos, size_type count, std::uint32_t* out, std::true_type) const;
+    void unpack(size_type pos, size_type count, value_type* out, std::false_type) const;
+
+    Vector<word_type, Policy> words; // 压缩数组，不使用的高位总是0
+    size_type n;                     // 元素的数量
+
+    template<unsigned B, typename P>
+    friend bool operator==(const PackedVector<B, P>& lhs, const PackedVector<B, P>& rhs);
+};
+
+template<unsigned Bits, typename Policy>
+constexpr unsigned PackedVector<Bits, Policy>::BITS;
+template<unsigned Bits, typename Policy>
+constexpr typename PackedVector<Bits, Policy>::value_type PackedVector<Bits, Policy>::MAX_VALUE;
+template<unsigned Bits, typename Policy>
+constexpr unsigned PackedVector<Bits, Policy>::WORD_BITS;
+template<unsigned Bits, typename Policy>
+constexpr typename PackedVector<Bits, Policy>::word_type PackedVector<Bits, Policy>::MASK;
+
+/**
+ * 位压缩Vector的随机访问迭代器.
+ * 保存容器指针和下标，解引用时按下标读取或返回代理引用.
+ */
+template<typename Packed, typename Ref>
+class PackedIterator
+{
+public:
+    // 成员类型定义
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename Packed::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = Ref;
+    using size_type         = std::size_t;
+    // 迭代器定义
+    using iterator          = PackedIterator<typename std::remove_const<Packed>::type,
+                                             typename std::remove_const<Packed>::type::reference>;
+public:
+    PackedIterator() noexcept : pv(nullptr), i(0) {}
+    PackedIterator(Packed* pv, size_type i) noexcept : pv(pv), i(i) {}
+    PackedIterator(const iterator& that) noexcept : pv(that.pv), i(that.i) {}
+    PackedIterator& operator=(const PackedIterator& that) noexcept = default;
+
+    reference operator*() const noexcept { return (*pv)[i]; }
+    reference operator[](difference_type k) const noexcept { return (*pv)[i + k]; }
+    PackedIterator& operator++() noexcept { ++i; return *this; }
+    PackedIterator operator++(int) noexcept { PackedIterator tmp(*this); ++i; return tmp; }
+    PackedIterator& operator--() noexcept { --i; return *this; }
+    PackedIterator operator--(int) noexcept { PackedIterator tmp(*this); --i; return tmp; }
+    PackedIterator& operator+=(difference_type k) noexcept { i += k; return *this; }
+    PackedIterator& operator-=(difference_type k) noexcept { i -= k; return *this; }
+    PackedIterator operator+(difference_type k) const noexcept { return PackedIterator(pv, i + k); }
+    PackedIterator operator-(difference_type k) const noexcept { return PackedIterator(pv, i - k); }
+    difference_type operator-(const PackedIterator& that) const noexcept
+    { return difference_type(i) - difference_type(that.i); }
+    bool operator==(const PackedIterator& that) const noexcept { return i == that.i; }
+    bool operator!=(const PackedIterator& that) const noexcept { return i != that.i; }
+    bool operator<(const PackedIterator& that) const noexcept { return i < that.i; }
+    bool operator>(const PackedIterator& that) const noexcept { return i > that.i; }
+    bool operator<=(const PackedIterator& that) const noexcept { return i <= that.i; }
+    bool operator>=(const PackedIterator& that) const noexcept { return i >= that.i; }
+    // 返回元素的下标
+    size_type index() const noexcept { return i; }
+private:
+    Packed* pv;  // 所属的容器
+    size_type i; // 元素的下标
+
+    template<typename P, typename R>
+    friend class PackedIterator;
+};
+
+template<typename Packed, typename Ref>
+PackedIterator<Packed, Ref> operator+(std::ptrdiff_t k, const PackedIterator<Packed, Ref>& it) noexcept
+{
+    return it + k;
+}
+
+/**
+ * 构造含有count个value的PackedVector.
+ *
+ * @param count: 元素个数
+ *        value: 元素的值
+ * @throws std::out_of_range: value超过MAX_VALUE
+ */
+template<unsigned Bits, typename Policy>
+PackedVector<Bits, Policy>::PackedVector(size_type count, value_type value)
+: n(0)
+{
+    resize(count, value);
+}
+
+/**
+ * 用初始化列表构造PackedVector.
+ *
+ * @param ilist: 初始化列表
+ * @throws std::out_of_range: 有元素超过MAX_VALUE
+ */
+template<unsigned Bits, typename Policy>
+PackedVector<Bits, Policy>::PackedVector(std::initializer_list<value_type> ilist)
+: n(0)
+{
+    append(ilist.begin(), ilist.end());
+}
+
+/**
+ * 检查元素的值.
+ *
+ * @param value: 元素的值
+ * @throws std::out_of_range: value超过MAX_VALUE
+ */
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::check_value(value_type value)
+{
+    if (value > MAX_VALUE)
+        throw std::out_of_range("PackedVector: value exceeds bit width");
+}
+
+/**
+ * 改变元素的数量.
+ * 元素减少时清零多余的位，保证压缩数组中不使用的位总是0.
+ *
+ * @param count: 新的元素个数
+ *        value: 新增元素的值
+ * @throws std::out_of_range: value超过MAX_VALUE
+ */
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::resize(size_type count, value_type value)
+{
+    check_value(value);
+    if (count < n)
+    {
+        words.resize(words_for(count));
+        unsigned used = unsigned(count * Bits % WORD_BITS);
+        if (used != 0)
+            words.back() &= ~word_type(0) >> (WORD_BITS - used);
+        n = count;
+        return;
+    }
+    words.resize(words_for(count), 0);
+    if (value != 0)
+        for (size_type i = n; i < count; ++i)
+            set(i, value);
+    n = count;
+}
+
+/**
+ * 读取第i个元素.
+ * 元素跨越两个64位整数时，把后一个整数的低位拼接到高位.
+ *
+ * @param i: 元素下标
+ * @return 元素的值
+ */
+template<unsigned Bits, typename Policy>
+inline typename PackedVector<Bits, Policy>::value_type
+PackedVector<Bits, Policy>::get(size_type i) const noexcept
+{
+    size_type bit = i * Bits;
+    size_type w = bit / WORD_BITS;
+    unsigned offset = unsigned(bit % WORD_BITS);
+    word_type v = words[w] >> offset;
+    if (offset + Bits > WORD_BITS)
+        v |= words[w + 1] << (WORD_BITS - offset);
+    return value_type(v & MASK);
+}
+
+/**
+ * 设置第i个元素.
+ *
+ * @param i: 元素下标
+ *        value: 元素的值
+ * @throws std::out_of_range: value超过MAX_VALUE
+ */
+template<unsigned Bits, typename Policy>
+inline void PackedVector<Bits, Policy>::set(size_type i, value_type value)
+{
+    check_value(value);
+    size_type bit = i * Bits;
+    size_type w = bit / WORD_BITS;
+    unsigned offset = unsigned(bit % WORD_BITS);
+    words[w] = (words[w] & ~(MASK << offset)) | (word_type(value) << offset);
+    if (offset + Bits > WORD_BITS)
+    {
+        // 跨越时offset大于0，后一个整数存放高WORD_BITS - offset位之外的部分
+        unsigned shift = WORD_BITS - offset;
+        words[w + 1] = (words[w + 1] & ~(MASK >> shift)) | (word_type(value) >> shift);
+    }
+}
+
+/**
+ * 添加元素到尾部.
+ * 需要新的64位整数时按增长策略扩容.
+ *
+ * @param value: 元素的值
+ * @throws std::out_of_range: value超过MAX_VALUE
+ */
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::insert_back(value_type value)
+{
+    check_value(value);
+    if (words_for(n + 1) > words.size())
+        words.insert_back(0);
+    set(n++, value);
+}
+
+/**
+ * 添加迭代器范围内的元素到尾部.
+ * 前向迭代器先一次预留全部空间.
+ *
+ * @param first: 范围头部（包含）
+ *        last: 范围尾部（不包含）
+ * @throws std::out_of_range: 有元素超过MAX_VALUE，之前的元素已经添加
+ */
+template<unsigned Bits, typename Policy>
+template<typename InputIt>
+void PackedVector<Bits, Policy>::append(InputIt first, InputIt last)
+{
+    reserve_for(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    for (; first != last; ++first)
+        insert_back(value_type(*first));
+}
+
+/**
+ * 移除尾部元素.
+ *
+ * @throws std::out_of_range: 为空
+ */
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::remove_back()
+{
+    if (n == 0)
+        throw std::out_of_range("PackedVector::remove_back() failed, vector is empty");
+    resize(n - 1);
+}
+
+/**
+ * 返回指定位置的元素，带边界检查.
+ *
+ * @param i: 元素下标
+ * @return 元素的值
+ * @throws std::out_of_range: 下标越界
+ */
+template<unsigned Bits, typename Policy>
+typename PackedVector<Bits, Policy>::value_type PackedVector<Bits, Policy>::at(size_type i) const
+{
+    if (i >= n)
+        throw std::out_of_range("PackedVector::at() index out of range");
+    return get(i);
+}
+
+/**
+ * 返回头部元素.
+ *
+ * @return 头部元素
+ * @throws std::out_of_range: 为空
+ */
+template<unsigned Bits, typename Policy>
+typename PackedVector<Bits, Policy>::value_type PackedVector<Bits, Policy>::front() const
+{
+    if (n == 0)
+        throw std::out_of_range("PackedVector::front() failed, vector is empty");
+    return get(0);
+}
+
+/**
+ * 返回尾部元素.
+ *
+ * @return 尾部元素
+ * @throws std::out_of_range: 为空
+ */
+template<unsigned Bits, typename Policy>
+typename PackedVector<Bits, Policy>::value_type PackedVector<Bits, Policy>::back() const
+{
+    if (n == 0)
+        throw std::out_of_range("PackedVector::back() failed, vector is empty");
+    return get(n - 1);
+}
+
+/**
+ * 批量解压从pos起的count个元素.
+ * 位宽不超过32时使用simd::unpack，不超过25位且CPU支持AVX2时每次解压8个元素.
+ *
+ * @param pos: 第一个元素的下标
+ *        count: 元素个数
+ *        out: 输出数组，至少容纳count个元素
+ * @throws std::out_of_range: 范围越界
+ */
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::unpack(size_type pos, size_type count, value_type* out) const
+{
+    if (pos > n || count > n - pos)
+        throw std::out_of_range("PackedVector::unpack() range out of range");
+    unpack(pos, count, out, std::integral_constant<bool, (Bits <= 32)>());
+}
+
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::unpack(size_type pos, size_type count, std::uint32_t* out,
+                                        std::true_type) const
+{
+    simd::unpack(words.begin(), words.size(), Bits, pos, count, out);
+}
+
+template<unsigned Bits, typename Policy>
+void PackedVector<Bits, Policy>::unpack(size_type pos, size_type count, value_type* out,
+                                        std::false_type) const
+{
+    for (size_type i = 0; i < count; ++i)
+        out[i] = get(pos + i);
+}
+
+/**
+ * 判断两个PackedVector对象是否相等.
+ * 不使用的位总是0，直接比较压缩数组.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 相等返回true，否则返回false
+ */
+template<unsigned Bits, typename Policy>
+bool operator==(const PackedVector<Bits, Policy>& lhs, const PackedVector<Bits, Policy>& rhs)
+{
+    return lhs.n == rhs.n && lhs.words == rhs.words;
+}
+
+/**
+ * 判断两个PackedVector对象是否不等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 不等返回true，否则返回false
+ */
+template<unsigned Bits, typename Policy>
+bool operator!=(const PackedVector<Bits, Policy>& lhs, const PackedVector<Bits, Policy>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * 输出PackedVector对象.
+ *
+ * @param os: 输出流
+ *        vector: 要输出的PackedVector对象
+ * @return 输出流
+ */
+template<unsigned Bits, typename Policy>
+std::ostream& operator<<(std::ostream& os, const PackedVector<Bits, Policy>& vector)
+{
+    for (auto value : vector)
+        os << value << " ";
+    return os;
+}
+
+/**
+ * 交换两个PackedVector对象.
+ *
+ * @param lhs: 要交换的对象
+ *        rhs: 要交换的对象
+ */
+template<unsigned Bits, typename Policy>
+void swap(PackedVector<Bits, Policy>& lhs, PackedVector<Bits, Policy>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * 使用模板实现的分块参考帧压缩Vector.
+ * 元素按BlockSize个一组分块，每块记录最小值作为参考帧，
+ * 块内元素存储与最小值的差，位宽取决于块内的最大差值，各块的位宽可以不同.
+ * 排序或局部聚集的数据差值很小，比全局定宽压缩更省空间.
+ * 只支持在尾部添加和移除元素，已压缩的块不能修改；
+ * 尾部不满一块的元素不压缩，满一块时压缩到数组末尾.
+ * 随机访问仍是O(1)：按下标找到块，再按块的位宽读取.
+ */
+template<typename T = std::uint32_t, std::size_t BlockSize = 128>
+class BlockPackedVector
+{
+    static_assert(std::is_integral<T>::value, "BlockPackedVector requires integral elements");
+    static_assert(BlockSize > 0 && BlockSize % 64 == 0, "block size must be a multiple of 64");
+public:
+    // 成员类型定义
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T;
+    using const_reference = T;
+    using iterator        = PackedIterator<const BlockPackedVector, T>;
+    using const_iterator  = iterator;
+    // 每块的元素个数
+    static constexpr size_type BLOCK_SIZE = BlockSize;
+private:
+    using word_type = std::uint64_t;
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    static constexpr unsigned WORD_BITS = 64;
+
+    // 已压缩的块
+    struct Block
+    {
+        T base;          // 块内的最小值
+        unsigned bits;   // 块内差值的位宽，为0时所有元素相等
+        size_type start; // 块在压缩数组中的起始下标
+    };
+public:
+    BlockPackedVector() : tail(BlockSize) {}
+
+    const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+    const_iterator end()    const noexcept { return const_iterator(this, size()); }
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cend()   const noexcept { return const_iterator(this, size()); }
+
+    // 返回元素的数量
+    size_type size() const noexcept { return blocks.size() * BlockSize + tail.size(); }
+    // 判断是否为空
+    bool empty() const noexcept { return size() == 0; }
+    // 返回压缩数组、块信息和尾部元素占用的字节数
+    size_type bytes() const noexcept
+    { return words.size() * sizeof(word_type) + blocks.size() * sizeof(Block) + tail.size() * sizeof(T); }
+    // 添加元素到尾部
+    void insert_back(T value);
+    // 移除尾部元素
+    void remove_back();
+    // 移除所有元素
+    void clear() noexcept { words.clear(); blocks.clear(); tail.clear(); }
+    // 返回指定位置的元素，带边界检查
+    T at(size_type i) const;
+    // 把第b块的BlockSize个元素解压到out
+    void unpack(size_type b, T* out) const;
+    // 下标运算符，不检查边界
+    T operator[](size_type i) const noexcept;
+private:
+    // 压缩尾部的一整块元素
+    void seal();
+
+    Vector<word_type> words;        // 所有已压缩块的差值
+    Vector<Block> blocks;           // 已压缩块的信息
+    Vector<T> tail;                 // 尾部未压缩的元素，不超过BlockSize个
+};
+
+template<typename T, std::size_t BlockSize>
+constexpr typename BlockPackedVector<T, BlockSize>::size_type BlockPackedVector<T, BlockSize>::BLOCK_SIZE;
+template<typename T, std::size_t BlockSize>
+constexpr unsigned BlockPackedVector<T, BlockSize>::WORD_BITS;
+
+/**
+ * 添加元素到尾部，满一块时压缩.
+ *
+ * @param value: 元素的值
+ */
+template<typename T, std::size_t BlockSize>
+void BlockPackedVector<T, BlockSize>::insert_back(T value)
+{
+    tail.insert_back(value);
+    if (tail.size() == BlockSize)
+        seal();
+}
+
+/**
+ * 压缩尾部的一整块元素.
+ * 位宽为最大差值的有效位数，块的长度是64的倍数，每块正好占bits个64位整数.
+ */
+template<typename T, std::size_t BlockSize>
+void BlockPackedVector<T, BlockSize>::seal()
+{
+    T base = *std::min_element(tail.begin(), tail.end());
+    unsigned_type range = unsigned_type(unsigned_type(*std::max_element(tail.begin(), tail.end())) -
+                                        unsigned_type(base));
+    unsigned bits = 0;
+    while (bits < sizeof(T) * 8 && (range >> bits) != 0)
+        ++bits;
+
+    Block block = {base, bits, words.size()};
+    blocks.insert_back(block);
+    // 所有元素相等的块不占用压缩数组
+    if (bits == 0)
+    {
+        tail.clear();
+        return;
+    }
+    words.resize(words.size() + BlockSize * bits / WORD_BITS, 0);
+    word_type* p = words.begin() + block.start;
+    size_type bit = 0;
+    for (size_type i = 0; i < BlockSize; ++i, bit += bits)
+    {
+        word_type v = word_type(unsigned_type(unsigned_type(tail[i]) - unsigned_type(base)));
+        size_type w = bit / WORD_BITS;
+        unsigned offset = unsigned(bit % WORD_BITS);
+        p[w] |= v << offset;
+        if (offset + bits > WORD_BITS)
+            p[w + 1] |= v >> (WORD_BITS - offset);
+    }
+    tail.clear();
+}
+
+/**
+ * 移除尾部元素.
+ * 尾部为空时先把最后一块解压回尾部.
+ *
+ * @throws std::out_of_range: 为空
+ */
+template<typename T, std::size_t BlockSize>
+void BlockPackedVector<T, BlockSize>::remove_back()
+{
+    if (empty())
+        throw std::out_of_range("BlockPackedVector::remove_back() failed, vector is empty");
+    if (tail.empty())
+    {
+        tail.resize(BlockSize);
+        unpack(blocks.size() - 1, tail.begin());
+        words.resize(blocks.back().start);
+        blocks.remove_back();
+    }
+    tail.remove_back();
+}
+
+/**
+ * 返回第i个元素.
+ *
+ * @param i: 元素下标
+ * @return 元素的值
+ */
+template<typename T, std::size_t BlockSize>
+inline T BlockPackedVector<T, BlockSize>::operator[](size_type i) const noexcept
+{
+    size_type b = i / BlockSize;
+    if (b == blocks.size())
+        return tail[i % BlockSize];
+    const Block& block = blocks[b];
+    if (block.bits == 0)
+        return block.base;
+    size_type bit = i % BlockSize * block.bits;
+    const word_type* p = words.begin() + block.start + bit / WORD_BITS;
+    unsigned offset = unsigned(bit % WORD_BITS);
+    word_type v = p[0] >> offset;
+    if (offset + block.bits > WORD_BITS)
+        v |= p[1] << (WORD_BITS - offset);
+    if (block.bits < WORD_BITS)
+        v &= (word_type(1) << block.bits) - 1;
+    return T(unsigned_type(unsigned_type(block.base) + unsigned_type(v)));
+}
+
+/**
+ * 返回指定位置的元素，带边界检查.
+ *
+ * @param i: 元素下标
+ * @return 元素的值
+ * @throws std::out_of_range: 下标越界
+ */
+template<typename T, std::size_t BlockSize>
+T BlockPackedVector<T, BlockSize>::at(size_type i) const
+{
+    if (i >= size())
+        throw std::out_of_range("BlockPackedVector::at() index out of range");
+    return (*this)[i];
+}
+
+/**
+ * 解压第b块的所有元素.
+ * 元素是32位整数且位宽不超过32时使用simd::unpack批量解压，再加上参考帧.
+ *
+ * @param b: 块的下标，必须是已压缩的块
+ *        out: 输出数组，至少容纳BlockSize个元素
+ */
+template<typename T, std::size_t BlockSize>
+void BlockPackedVector<T, BlockSize>::unpack(size_type b, T* out) const
+{
+    const Block& block = blocks[b];
+    if (sizeof(T) == sizeof(std::uint32_t) && block.bits > 0 && block.bits <= 32)
+    {
+        std::uint32_t* p = reinterpret_cast<std::uint32_t*>(out);
+        simd::unpack(words.begin() + block.start, block.bits * BlockSize / WORD_BITS,
+                     block.bits, 0, BlockSize, p);
+        std::uint32_t base = std::uint32_t(block.base);
+        for (size_type i = 0; i < BlockSize; ++i)
+            p[i] += base;
+        return;
+    }
+    for (size_type i = 0; i < BlockSize; ++i)
+        out[i] = (*this)[b * BlockSize + i];
+}
+
+} // namespace cpplib
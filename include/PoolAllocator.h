@@ -0,0 +1,383 @@
+/*******************************************************************************
+ * PoolAllocator.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace cpplib
+{
+
+/**
+ * 固定大小内存块的池.
+ * 从操作系统按块组（chunk）申请连续内存，每个块组包含多个大小相同的块；
+ * 释放的块链接到空闲链表，下次分配时优先复用，只有析构时才把块组还给操作系统.
+ * 新块组中的块按地址顺序分配，连续添加的结点在内存中相邻，遍历时有更好的局部性.
+ * 块组的大小从MIN_CHUNK个块开始倍增，到MAX_CHUNK个块为止；reserve可以申请任意大小的块组.
+ * 不是线程安全的.
+ */
+class NodePool
+{
+public:
+    // 第一个块组的块数
+    static constexpr std::size_t MIN_CHUNK = 16;
+    // 自动增长的块组的最大块数
+    static constexpr std::size_t MAX_CHUNK = 4096;
+public:
+    NodePool(std::size_t size, std::size_t alignment) noexcept;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    ~NodePool();
+
+    // 返回每个块的字节数
+    std::size_t block_size() const noexcept { return size; }
+    // 返回块的对齐字节数
+    std::size_t block_alignment() const noexcept { return alignment; }
+    // 分配一个块
+    void* allocate();
+    // 释放一个块到空闲链表
+    void deallocate(void* p) noexcept;
+    // 保证接下来的count次分配使用同一个块组中连续的块
+    void reserve(std::size_t count);
+    // 接管另一个内存池的所有块组，块的大小和对齐必须相同
+    bool absorb(NodePool& that) noexcept;
+private:
+    // 块组头部，块组之间组成单向链表
+    struct Chunk
+    {
+        Chunk* next;
+    };
+    // 空闲块，第一个字长用作链接
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    // 块组头部占用的字节数，保证块按max_align_t对齐
+    static constexpr std::size_t HEADER = (sizeof(Chunk) + alignof(std::max_align_t) - 1) /
+                                          alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    // 申请含有count个块的块组，未使用的块放入空闲链表
+    void add_chunk(std::size_t count);
+
+    std::size_t size;      // 每个块的字节数
+    std::size_t alignment; // 块的对齐字节数
+    std::size_t next_size; // 下一个自动申请的块组的块数
+    Chunk* chunks;         // 所有块组
+    FreeBlock* free_list;  // 空闲链表
+    char* fresh;           // 最新块组中未分配过的第一个块
+    char* fresh_end;       // 最新块组的尾部
+};
+
+/**
+ * 构造内存池.
+ * 块至少能容纳一个指针，大小向上取整为对齐字节数的整数倍；
+ * 块组头部按max_align_t对齐，对齐字节数不能超过alignof(std::max_align_t).
+ *
+ * @param size: 每个块的字节数
+ *        alignment: 块的对齐字节数
+ */
+inline NodePool::NodePool(std::size_t size, std::size_t alignment) noexcept
+: size(0), alignment(std::max(alignment, alignof(FreeBlock))), next_size(MIN_CHUNK),
+  chunks(nullptr), free_list(nullptr), fresh(nullptr), fresh_end(nullptr)
+{
+    std::size_t bytes = std::max(size, sizeof(FreeBlock));
+    this->size = (bytes + this->alignment - 1) / this->alignment * this->alignment;
+}
+
+/**
+ * 析构内存池，释放所有块组.
+ * 块中的对象必须已经析构.
+ */
+inline NodePool::~NodePool()
+{
+    while (chunks != nullptr)
+    {
+        Chunk* next = chunks->next;
+        ::operator delete(chunks);
+        chunks = next;
+    }
+}
+
+/**
+ * 分配一个块.
+ * 优先从空闲链表中取出最近释放的块，其次使用最新块组中未分配过的块，
+ * 都没有时申请新的块组.
+ *
+ * @return 块的地址
+ * @throws std::bad_alloc: 内存不足
+ */
+inline void* NodePool::allocate()
+{
+    if (free_list != nullptr)
+    {
+        FreeBlock* block = free_list;
+        free_list = block->next;
+        return block;
+    }
+    if (fresh == fresh_end)
+    {
+        add_chunk(next_size);
+        next_size = next_size * 2 < MAX_CHUNK ? next_size * 2 : MAX_CHUNK;
+    }
+    void* block = fresh;
+    fresh += size;
+    return block;
+}
+
+/**
+ * 释放一个块到空闲链表.
+ *
+ * @param p: 由这个内存池分配的块
+ */
+inline void NodePool::deallocate(void* p) noexcept
+{
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = free_list;
+    free_list = block;
+}
+
+/**
+ * 预留count个连续的块.
+ * 最新块组的剩余空间不足时，申请一个正好含有count个块的块组，
+ * 空闲链表中的块留到这些块用完之后再使用.
+ *
+ * @param count: 块的个数
+ * @throws std::bad_alloc: 内存不足
+ */
+inline void NodePool::reserve(std::size_t count)
+{
+    if (std::size_t(fresh_end - fresh) / size < count)
+        add_chunk(count);
+}
+
+/**
+ * 接管另一个内存池的所有块组.
+ * that的块组接到这个内存池的块组链表中，that的空闲块和未分配过的块放入空闲链表，
+ * 之后that中已分配的块可以由这个内存池释放，that变为空的内存池.
+ *
+ * @param that: 被接管的内存池
+ * @return 块的大小和对齐相同时返回true，否则不做修改并返回false
+ */
+inline bool NodePool::absorb(NodePool& that) noexcept
+{
+    if (this == &that)
+        return true;
+    if (size != that.size || alignment != that.alignment)
+        return false;
+    if (that.chunks != nullptr)
+    {
+        Chunk* last = that.chunks;
+        while (last->next != nullptr)
+            last = last->next;
+        last->next = chunks;
+        chunks = that.chunks;
+    }
+    for (; that.fresh != that.fresh_end; that.fresh += size)
+        deallocate(that.fresh);
+    while (that.free_list != nullptr)
+    {
+        FreeBlock* block = that.free_list;
+        that.free_list = block->next;
+        deallocate(block);
+    }
+    that.chunks = nullptr;
+    that.fresh = that.fresh_end = nullptr;
+    return true;
+}
+
+/**
+ * 申请含有count个块的块组.
+ * 上一个块组中未分配过的块放入空闲链表，之后从新块组的头部开始分配.
+ *
+ * @param count: 块的个数
+ * @throws std::bad_alloc: 内存不足
+ */
+inline void NodePool::add_chunk(std::size_t count)
+{
+    if (count > (std::size_t(-1) - HEADER) / size)
+        throw std::bad_alloc();
+    Chunk* chunk = static_cast<Chunk*>(::operator new(HEADER + count * size));
+    chunk->next = chunks;
+    chunks = chunk;
+    for (; fresh != fresh_end; fresh += size)
+        deallocate(fresh);
+    fresh = reinterpret_cast<char*>(chunk) + HEADER;
+    fresh_end = fresh + count * size;
+}
+
+/**
+ * 使用内存池的分配器，满足标准库分配器的要求.
+ * 单个对象从共享的NodePool分配，多个对象或过度对齐的对象直接使用::operator new.
+ * 内存池在第一次分配时创建，块的大小和对齐为当时的sizeof(T)和alignof(T)，
+ * 之后复制和rebind得到的分配器共享同一个内存池，它们相等，可以互相释放对方分配的内存；
+ * 创建内存池之前复制的分配器各自创建内存池.
+ * 容器复制时选择新的内存池，移动和交换时内存池随结点一起转移.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+    // 成员类型定义
+    using value_type = T;
+    using size_type  = std::size_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    template<typename U>
+    struct rebind { using other = PoolAllocator<U>; };
+public:
+    PoolAllocator() noexcept {}
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& that) noexcept : pool(that.pool) {}
+
+    // 分配count个对象的空间
+    T* allocate(size_type count);
+    // 释放allocate分配的空间
+    void deallocate(T* p, size_type count) noexcept;
+    // 保证接下来的count次单个对象的分配使用连续的空间
+    void reserve(size_type count);
+    // 与另一个分配器共享内存池，使两者相等
+    bool adopt(PoolAllocator& that) noexcept;
+    // 容器复制时使用新的内存池
+    PoolAllocator select_on_container_copy_construction() const noexcept { return PoolAllocator(); }
+    // 与另一个分配器交换内存池
+    void swap(PoolAllocator& that) noexcept { pool.swap(that.pool); }
+private:
+    // 判断count个对象是否从内存池分配
+    bool is_pooled(size_type count) const noexcept
+    {
+        return count == 1 && sizeof(T) <= pool->block_size() && alignof(T) <= pool->block_alignment();
+    }
+    // 第一次分配时创建内存池，过度对齐的类型不使用内存池
+    void create_pool()
+    {
+        if (!pool)
+            pool = std::make_shared<NodePool>(sizeof(T),
+                    alignof(T) <= alignof(std::max_align_t) ? alignof(T) : 1);
+    }
+
+    std::shared_ptr<NodePool> pool; // 共享的内存池
+
+    template<typename U>
+    friend class PoolAllocator;
+    template<typename U, typename V>
+    friend bool operator==(const PoolAllocator<U>& lhs, const PoolAllocator<V>& rhs) noexcept;
+};
+
+/**
+ * 分配count个对象的空间.
+ *
+ * @param count: 对象的个数
+ * @return 空间的首地址
+ * @throws std::bad_alloc: 内存不足
+ */
+template<typename T>
+T* PoolAllocator<T>::allocate(size_type count)
+{
+    create_pool();
+    if (is_pooled(count))
+        return static_cast<T*>(pool->allocate());
+    if (count > size_type(-1) / sizeof(T))
+        throw std::bad_alloc();
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+}
+
+/**
+ * 释放allocate分配的空间.
+ *
+ * @param p: 空间的首地址
+ *        count: 分配时对象的个数
+ */
+template<typename T>
+void PoolAllocator<T>::deallocate(T* p, size_type count) noexcept
+{
+    if (is_pooled(count))
+        pool->deallocate(p);
+    else
+        ::operator delete(p);
+}
+
+/**
+ * 预留count个连续的块.
+ *
+ * @param count: 对象的个数
+ * @throws std::bad_alloc: 内存不足
+ */
+template<typename T>
+void PoolAllocator<T>::reserve(size_type count)
+{
+    create_pool();
+    if (is_pooled(1))
+        pool->reserve(count);
+}
+
+/**
+ * 与另一个分配器共享内存池，之后两个分配器相等，可以互相释放对方分配的内存.
+ * 只有一方创建了内存池时共享这个内存池；
+ * 都创建了内存池时，只有that独占它的内存池才能由这个分配器的内存池接管.
+ * 容器在两个分配器相等后可以直接转移结点.
+ *
+ * @param that: 另一个分配器
+ * @return 两个分配器相等返回true，否则返回false
+ */
+template<typename T>
+bool PoolAllocator<T>::adopt(PoolAllocator& that) noexcept
+{
+    if (pool == that.pool)
+        return true;
+    if (!that.pool)
+        that.pool = pool;
+    else if (!pool)
+        pool = that.pool;
+    else if (that.pool.use_count() == 1 && pool->absorb(*that.pool))
+        that.pool = pool;
+    return pool == that.pool;
+}
+
+/**
+ * 判断两个分配器是否相等.
+ * 共享同一个内存池时相等，一个分配器分配的空间可以由另一个释放.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 相等返回true，否则返回false
+ */
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) noexcept
+{
+    return lhs.pool == rhs.pool;
+}
+
+/**
+ * 判断两个分配器是否不等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 不等返回true，否则返回false
+ */
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * 交换两个分配器的内存池.
+ *
+ * @param lhs: 要交换的对象
+ *        rhs: 要交换的对象
+ */
+template<typename T>
+void swap(PoolAllocator<T>& lhs, PoolAllocator<T>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace cpplib
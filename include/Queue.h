@@ -12,7 +12,7 @@
 /**
  * 使用模板实现的先进先出队列.
  */
-template<typename E, typename Container = Deque<E>>
+template<typename E, typename Container = cpplib::Deque<E>>
 class Queue
 {
     template <typename T, typename C>
@@ -28,6 +28,9 @@ public:
 public:
     // 构造函数隐式声明
     Queue() = default;
+    // 用已有的容器构造，例如指定容量的RingBuffer
+    explicit Queue(const Container& c) : c(c) {}
+    explicit Queue(Container&& c) : c(std::move(c)) {}
 
     // 判断是否为空队列
     bool empty() const { return c.empty(); }
@@ -0,0 +1,546 @@
+/*******************************************************************************
+ * RingBuffer.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cpplib
+{
+
+/**
+ * 环形缓冲区满时拒绝添加的溢出策略.
+ * 添加元素抛出std::overflow_error，缓冲区内容不变.
+ */
+struct RejectOnOverflow {};
+
+/**
+ * 环形缓冲区满时覆盖的溢出策略.
+ * 在一端添加元素时覆盖另一端的元素，对于队列用法即覆盖最早添加的元素.
+ */
+struct OverwriteOnOverflow {};
+
+// 环形缓冲区的随机访问迭代器
+template<typename E, typename Ptr, typename Ref>
+class RingBufferIterator;
+
+/**
+ * 使用模板实现的定长环形缓冲区.
+ * 构造时一次分配容纳capacity个元素的连续空间，首尾相接循环使用，
+ * 之后的添加和移除只构造和析构元素，不再分配和释放内存.
+ * 提供与Deque相同的两端操作，可以作为Queue和Stack的Container.
+ * 缓冲区满时的行为由溢出策略OverflowPolicy在编译期确定.
+ */
+template<typename E, typename OverflowPolicy = RejectOnOverflow>
+class RingBuffer
+{
+public:
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = std::allocator<E>;
+    using overflow_policy = OverflowPolicy;
+    // 迭代器定义
+    using iterator               = RingBufferIterator<E, E*, E&>;
+    using const_iterator         = RingBufferIterator<E, const E*, const E&>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+private:
+    using allocator_traits = typename std::allocator_traits<allocator_type>;
+    using is_overwrite = std::is_same<OverflowPolicy, OverwriteOnOverflow>;
+
+    static constexpr size_type DEFAULT_CAPACITY = 16; // 默认容量
+public:
+    explicit RingBuffer(size_type capacity = DEFAULT_CAPACITY);
+    RingBuffer(const RingBuffer& that);
+    RingBuffer(RingBuffer&& that) noexcept;
+    ~RingBuffer();
+    RingBuffer& operator=(RingBuffer that);
+    allocator_type get_allocator() const noexcept { return allocator_type(); }
+
+    iterator begin() noexcept { return iterator(buffer, N, head, 0); }
+    iterator end()   noexcept { return iterator(buffer, N, head, n); }
+    const_iterator begin()  const noexcept { return const_iterator(buffer, N, head, 0); }
+    const_iterator end()    const noexcept { return const_iterator(buffer, N, head, n); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 判断是否为空缓冲区
+    bool empty() const noexcept { return n == 0; }
+    // 判断缓冲区是否已满
+    bool full() const noexcept { return n == N; }
+    // 返回缓冲区元素的数量
+    size_type size() const noexcept { return n; }
+    // 返回缓冲区的容量
+    size_type capacity() const noexcept { return N; }
+    // 返回缓冲区可容纳的最大元素数量
+    size_type max_size() const noexcept { return N; }
+
+    // 返回const队首引用
+    const E& front() const;
+    // 返回const队尾引用
+    const E& back() const;
+    // 返回指定位置元素的const引用，带边界检查
+    const E& at(size_type i) const;
+    // 返回指定位置元素的const引用，无边界检查
+    const E& operator[](size_type i) const { return buffer[physical(i)]; }
+    // 返回队首引用
+    E& front() { return const_cast<E&>(static_cast<const RingBuffer&>(*this).front()); }
+    // 返回队尾引用
+    E& back() { return const_cast<E&>(static_cast<const RingBuffer&>(*this).back()); }
+    // 返回指定位置元素的引用，带边界检查
+    E& at(size_type i) { return const_cast<E&>(static_cast<const RingBuffer&>(*this).at(i)); }
+    // 返回指定位置元素的引用，无边界检查
+    E& operator[](size_type i) { return buffer[physical(i)]; }
+
+    // 在队首直接构造元素
+    template<typename... Args>
+    void emplace_front(Args&&... args);
+    // 在队尾直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    // 添加元素到队首
+    void insert_front(const E& elem) { emplace_front(elem); }
+    void insert_front(E&& elem) { emplace_front(std::move(elem)); }
+    // 添加元素到队尾
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
+    // 队首元素出队
+    void remove_front();
+    // 队尾元素出队
+    void remove_back();
+    // 内容与另一个RingBuffer对象交换
+    void swap(RingBuffer& that) noexcept;
+    // 清空缓冲区，不释放空间
+    void clear() noexcept;
+private:
+    // 逻辑位置i对应的物理位置，用比较代替取模
+    size_type physical(size_type i) const noexcept
+    { return head + i < N ? head + i : head + i - N; }
+    // 物理位置的下一个位置
+    size_type next(size_type i) const noexcept { return i + 1 == N ? 0 : i + 1; }
+    // 物理位置的上一个位置
+    size_type prev(size_type i) const noexcept { return i == 0 ? N - 1 : i - 1; }
+    // 缓冲区满时在队首构造元素，按溢出策略拒绝或覆盖队尾元素
+    template<typename... Args>
+    void overflow_front(std::false_type, Args&&...)
+    { throw std::overflow_error("RingBuffer::insert_front"); }
+    template<typename... Args>
+    void overflow_front(std::true_type, Args&&... args);
+    // 缓冲区满时在队尾构造元素，按溢出策略拒绝或覆盖队首元素
+    template<typename... Args>
+    void overflow_back(std::false_type, Args&&...)
+    { throw std::overflow_error("RingBuffer::insert_back"); }
+    template<typename... Args>
+    void overflow_back(std::true_type, Args&&... args);
+private:
+    pointer buffer;  // 缓冲区
+    size_type N;     // 缓冲区容量
+    size_type head;  // 队首元素的物理位置
+    size_type n;     // 元素个数
+    allocator_type allocator;
+};
+
+template<typename E, typename OverflowPolicy>
+constexpr typename RingBuffer<E, OverflowPolicy>::size_type
+RingBuffer<E, OverflowPolicy>::DEFAULT_CAPACITY;
+
+/**
+ * 环形缓冲区构造函数.
+ * 一次分配指定容量的空间，之后不再分配内存.
+ *
+ * @param capacity: 缓冲区容量
+ * @throws std::invalid_argument: 容量为0
+ */
+template<typename E, typename OverflowPolicy>
+RingBuffer<E, OverflowPolicy>::RingBuffer(size_type capacity)
+: N(capacity), head(0), n(0)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("RingBuffer::RingBuffer");
+    buffer = allocator_traits::allocate(allocator, N);
+}
+
+/**
+ * 环形缓冲区复制构造函数.
+ * 容量与that相同，元素从物理位置0开始存放.
+ *
+ * @param that: 被复制的环形缓冲区
+ */
+template<typename E, typename OverflowPolicy>
+RingBuffer<E, OverflowPolicy>::RingBuffer(const RingBuffer& that)
+: RingBuffer(that.N)
+{
+    // 委托构造已经完成，构造抛出异常时析构函数会析构已构造的元素并释放空间
+    for (; n < that.n; ++n)
+        allocator_traits::construct(allocator, buffer + n, that[n]);
+}
+
+/**
+ * 环形缓冲区移动构造函数.
+ * 移动另一个环形缓冲区，其资源所有权转移到新创建的对象.
+ *
+ * @param that: 被移动的环形缓冲区
+ */
+template<typename E, typename OverflowPolicy>
+RingBuffer<E, OverflowPolicy>::RingBuffer(RingBuffer&& that) noexcept
+: buffer(that.buffer), N(that.N), head(that.head), n(that.n)
+{
+    that.buffer = nullptr; // 指向空指针，退出被析构
+    that.N = 0;
+    that.head = 0;
+    that.n = 0;
+}
+
+/**
+ * 环形缓冲区析构函数.
+ */
+template<typename E, typename OverflowPolicy>
+RingBuffer<E, OverflowPolicy>::~RingBuffer()
+{
+    // 已被移动的环形缓冲区不持有任何资源
+    if (buffer == nullptr)
+        return;
+    clear();
+    allocator_traits::deallocate(allocator, buffer, N);
+}
+
+/**
+ * =操作符重载.
+ * 让当前RingBuffer对象等于给定RingBuffer对象that.
+ *
+ * @param that: RingBuffer对象that
+ * @return 当前RingBuffer对象
+ */
+template<typename E, typename OverflowPolicy>
+RingBuffer<E, OverflowPolicy>&
+RingBuffer<E, OverflowPolicy>::operator=(RingBuffer that)
+{
+    swap(that);
+    return *this;
+}
+
+/**
+ * 返回const队首引用.
+ *
+ * @return const队首引用
+ * @throws std::out_of_range: 缓冲区空
+ */
+template<typename E, typename OverflowPolicy>
+const E& RingBuffer<E, OverflowPolicy>::front() const
+{
+    if (empty())
+        throw std::out_of_range("RingBuffer::front");
+    return buffer[head];
+}
+
+/**
+ * 返回const队尾引用.
+ *
+ * @return const队尾引用
+ * @throws std::out_of_range: 缓冲区空
+ */
+template<typename E, typename OverflowPolicy>
+const E& RingBuffer<E, OverflowPolicy>::back() const
+{
+    if (empty())
+        throw std::out_of_range("RingBuffer::back");
+    return buffer[physical(n - 1)];
+}
+
+/**
+ * 返回RingBuffer指定位置元素的const引用，并进行越界检查.
+ *
+ * @return 指定位置元素的const引用
+ * @throws std::out_of_range: 索引不合法
+ */
+template<typename E, typename OverflowPolicy>
+const E& RingBuffer<E, OverflowPolicy>::at(size_type i) const
+{
+    if (i >= n)
+        throw std::out_of_range("RingBuffer::at");
+    return (*this)[i];
+}
+
+/**
+ * 在队首直接构造元素.
+ * 缓冲区满时按溢出策略处理.
+ *
+ * @param args: 用于构造元素的参数
+ * @throws std::overflow_error: 缓冲区满且溢出策略为RejectOnOverflow
+ */
+template<typename E, typename OverflowPolicy>
+template<typename... Args>
+void RingBuffer<E, OverflowPolicy>::emplace_front(Args&&... args)
+{
+    if (full())
+    {
+        overflow_front(is_overwrite(), std::forward<Args>(args)...);
+        return;
+    }
+    size_type new_head = prev(head);
+    allocator_traits::construct(allocator, buffer + new_head, std::forward<Args>(args)...);
+    head = new_head;
+    ++n;
+}
+
+/**
+ * 在队尾直接构造元素.
+ * 缓冲区满时按溢出策略处理.
+ *
+ * @param args: 用于构造元素的参数
+ * @throws std::overflow_error: 缓冲区满且溢出策略为RejectOnOverflow
+ */
+template<typename E, typename OverflowPolicy>
+template<typename... Args>
+void RingBuffer<E, OverflowPolicy>::emplace_back(Args&&... args)
+{
+    if (full())
+    {
+        overflow_back(is_overwrite(), std::forward<Args>(args)...);
+        return;
+    }
+    allocator_traits::construct(allocator, buffer + physical(n), std::forward<Args>(args)...);
+    ++n;
+}
+
+/**
+ * 缓冲区满时在队首添加元素，覆盖队尾元素.
+ * 队尾元素的位置正好是新的队首位置，新元素先构造为临时对象再移动赋值，
+ * 参数引用缓冲区内的元素时也是安全的.
+ * 已被移动的缓冲区容量为0，新元素立即被覆盖，不做任何事.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename OverflowPolicy>
+template<typename... Args>
+void RingBuffer<E, OverflowPolicy>::overflow_front(std::true_type, Args&&... args)
+{
+    if (N == 0)
+        return;
+    size_type new_head = prev(head);
+    buffer[new_head] = E(std::forward<Args>(args)...);
+    head = new_head;
+}
+
+/**
+ * 缓冲区满时在队尾添加元素，覆盖队首元素.
+ * 队首元素的位置正好是新的队尾位置，覆盖后队首后移一个位置.
+ * 已被移动的缓冲区容量为0，新元素立即被覆盖，不做任何事.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename OverflowPolicy>
+template<typename... Args>
+void RingBuffer<E, OverflowPolicy>::overflow_back(std::true_type, Args&&... args)
+{
+    if (N == 0)
+        return;
+    buffer[head] = E(std::forward<Args>(args)...);
+    head = next(head);
+}
+
+/**
+ * 移除队首元素.
+ *
+ * @throws std::out_of_range: 缓冲区空
+ */
+template<typename E, typename OverflowPolicy>
+void RingBuffer<E, OverflowPolicy>::remove_front()
+{
+    if (empty())
+        throw std::out_of_range("RingBuffer::remove_front");
+    allocator_traits::destroy(allocator, buffer + head);
+    head = next(head);
+    --n;
+}
+
+/**
+ * 移除队尾元素.
+ *
+ * @throws std::out_of_range: 缓冲区空
+ */
+template<typename E, typename OverflowPolicy>
+void RingBuffer<E, OverflowPolicy>::remove_back()
+{
+    if (empty())
+        throw std::out_of_range("RingBuffer::remove_back");
+    allocator_traits::destroy(allocator, buffer + physical(n - 1));
+    --n;
+}
+
+/**
+ * 交换当前RingBuffer对象和另一个RingBuffer对象.
+ *
+ * @param that: RingBuffer对象that
+ */
+template<typename E, typename OverflowPolicy>
+void RingBuffer<E, OverflowPolicy>::swap(RingBuffer& that) noexcept
+{
+    using std::swap;
+    swap(buffer, that.buffer);
+    swap(N, that.N);
+    swap(head, that.head);
+    swap(n, that.n);
+}
+
+/**
+ * 清空该环形缓冲区元素，容量不变.
+ */
+template<typename E, typename OverflowPolicy>
+void RingBuffer<E, OverflowPolicy>::clear() noexcept
+{
+    for (; n > 0; --n)
+    {
+        allocator_traits::destroy(allocator, buffer + head);
+        head = next(head);
+    }
+    head = 0;
+}
+
+/**
+ * ==操作符重载函数，比较两个RingBuffer对象是否相等.
+ *
+ * @param lhs: RingBuffer对象lhs
+ *        rhs: RingBuffer对象rhs
+ * @return true: 相等
+ *         false: 不等
+ */
+template<typename E, typename OverflowPolicy>
+bool operator==(const RingBuffer<E, OverflowPolicy>& lhs,
+                const RingBuffer<E, OverflowPolicy>& rhs)
+{
+    if (&lhs == &rhs)             return true;
+    if (lhs.size() != rhs.size()) return false;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * !=操作符重载函数，比较两个RingBuffer对象是否不等.
+ *
+ * @param lhs: RingBuffer对象lhs
+ *        rhs: RingBuffer对象rhs
+ * @return true: 不等
+ *         false: 相等
+ */
+template<typename E, typename OverflowPolicy>
+bool operator!=(const RingBuffer<E, OverflowPolicy>& lhs,
+                const RingBuffer<E, OverflowPolicy>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * <<操作符重载函数，打印所有环形缓冲区元素.
+ *
+ * @param os: 输出流对象
+ *        buffer: 要输出的环形缓冲区
+ * @return 输出流对象
+ */
+template<typename E, typename OverflowPolicy>
+std::ostream& operator<<(std::ostream& os, const RingBuffer<E, OverflowPolicy>& buffer)
+{
+    for (auto i : buffer)
+        os << i << " ";
+    return os;
+}
+
+/**
+ * 交换两个RingBuffer对象.
+ *
+ * @param lhs: RingBuffer对象lhs
+ *        rhs: RingBuffer对象rhs
+ */
+template<typename E, typename OverflowPolicy>
+void swap(RingBuffer<E, OverflowPolicy>& lhs, RingBuffer<E, OverflowPolicy>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+template<typename E, typename Ptr, typename Ref>
+class RingBufferIterator
+{
+public:
+    // 成员类型定义
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = E;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    // 迭代器定义
+    using iterator          = RingBufferIterator<E, E*, E&>;
+    using const_iterator    = RingBufferIterator<E, const E*, const E&>;
+public:
+    RingBufferIterator() noexcept
+    : buffer(nullptr), N(0), head(0), index(0) {}
+    RingBufferIterator(E* buffer, std::size_t N, std::size_t head, std::size_t index) noexcept
+    : buffer(buffer), N(N), head(head), index(index) {}
+    RingBufferIterator(const iterator& that) noexcept
+    : buffer(that.buffer), N(that.N), head(that.head), index(that.index) {}
+    RingBufferIterator& operator=(const RingBufferIterator& that) noexcept = default;
+
+    reference operator*() const noexcept
+    { return buffer[head + index < N ? head + index : head + index - N]; }
+    pointer operator->() const noexcept
+    { return &**this; }
+    reference operator[](difference_type i) const noexcept
+    { return *(*this + i); }
+    RingBufferIterator& operator++() noexcept
+    { ++index; return *this; }
+    RingBufferIterator operator++(int) noexcept
+    { RingBufferIterator tmp(*this); ++index; return tmp; }
+    RingBufferIterator& operator--() noexcept
+    { --index; return *this; }
+    RingBufferIterator operator--(int) noexcept
+    { RingBufferIterator tmp(*this); --index; return tmp; }
+    RingBufferIterator& operator+=(difference_type n) noexcept
+    { index += n; return *this; }
+    RingBufferIterator& operator-=(difference_type n) noexcept
+    { index -= n; return *this; }
+    RingBufferIterator operator+(difference_type n) const noexcept
+    { RingBufferIterator tmp(*this); return tmp += n; }
+    RingBufferIterator operator-(difference_type n) const noexcept
+    { RingBufferIterator tmp(*this); return tmp -= n; }
+    difference_type operator-(const RingBufferIterator& that) const noexcept
+    { return difference_type(index) - difference_type(that.index); }
+    bool operator==(const RingBufferIterator& that) const noexcept
+    { return index == that.index; }
+    bool operator!=(const RingBufferIterator& that) const noexcept
+    { return index != that.index; }
+    bool operator<(const RingBufferIterator& that) const noexcept
+    { return index < that.index; }
+    bool operator>(const RingBufferIterator& that) const noexcept
+    { return that < *this; }
+    bool operator<=(const RingBufferIterator& that) const noexcept
+    { return !(that < *this); }
+    bool operator>=(const RingBufferIterator& that) const noexcept
+    { return !(*this < that); }
+private:
+    E* buffer;         // 缓冲区
+    std::size_t N;     // 缓冲区容量
+    std::size_t head;  // 队首元素的物理位置
+    std::size_t index; // 相对于队首的逻辑位置
+
+    friend class RingBufferIterator<E, const E*, const E&>;
+};
+
+} // namespace cpplib
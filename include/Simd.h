@@ -0,0 +1,777 @@
+/*******************************************************************************
+ * Simd.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define CPPLIB_SIMD_X86 1
+#include <immintrin.h>
+// 按指定指令集编译单个函数，不要求整个程序使用-mavx2等编译选项
+#define CPPLIB_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define CPPLIB_TARGET_AVX2  __attribute__((target("avx2,popcnt")))
+#else
+#define CPPLIB_SIMD_X86 0
+#endif
+
+namespace cpplib
+{
+
+/**
+ * 连续数组上的线性扫描：相等比较、查找、计数、最小值、最大值和求和.
+ * 元素类型为int32_t、float和uint8_t时使用SSE4.2或AVX2指令，
+ * 运行时按CPU支持的最高级别选择实现；其他类型和其他平台使用标量循环.
+ * 另有定宽位压缩整数的批量解压，位宽不超过25时使用AVX2指令.
+ */
+namespace simd
+{
+
+// 指令集级别
+enum class Level { Scalar, SSE42, AVX2 };
+
+// 求和的结果类型，整数扩展到64位，避免uint8_t和int32_t溢出
+template<typename T>
+struct sum_type
+{
+    using type = typename std::conditional<std::is_integral<T>::value,
+            typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type,
+            T>::type;
+};
+
+// 判断元素类型是否有向量化的实现
+template<typename T>
+struct is_accelerated : std::integral_constant<bool,
+        std::is_same<T, std::int32_t>::value || std::is_same<T, float>::value ||
+        std::is_same<T, std::uint8_t>::value> {};
+
+/**
+ * 检测CPU支持的最高指令集级别，结果在第一次调用时确定.
+ *
+ * @return CPU支持的最高级别
+ */
+inline Level supported_level() noexcept
+{
+#if CPPLIB_SIMD_X86
+    static const Level level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+            return Level::AVX2;
+        if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+            return Level::SSE42;
+        return Level::Scalar;
+    }();
+    return level;
+#else
+    return Level::Scalar;
+#endif
+}
+
+/**
+ * 返回当前使用的指令集级别，初始为CPU支持的最高级别.
+ * 可以赋值为更低的级别，用于测试和比较各个实现，不能高于supported_level().
+ *
+ * @return 当前级别的引用
+ */
+inline Level& level() noexcept
+{
+    static Level current = supported_level();
+    return current;
+}
+
+// 标量实现，适用于任意元素类型，也用于处理向量化实现剩余的尾部元素
+namespace scalar
+{
+
+template<typename T>
+bool equal(const T* a, const T* b, std::size_t n)
+{
+    return std::equal(a, a + n, b);
+}
+
+template<typename T>
+std::size_t find(const T* p, std::size_t n, const T& value)
+{
+    return std::size_t(std::find(p, p + n, value) - p);
+}
+
+template<typename T>
+std::size_t count(const T* p, std::size_t n, const T& value)
+{
+    return std::size_t(std::count(p, p + n, value));
+}
+
+template<typename T>
+const T& min(const T* p, std::size_t n)
+{
+    return *std::min_element(p, p + n);
+}
+
+template<typename T>
+const T& max(const T* p, std::size_t n)
+{
+    return *std::max_element(p, p + n);
+}
+
+template<typename T>
+typename sum_type<T>::type sum(const T* p, std::size_t n)
+{
+    typename sum_type<T>::type s = typename sum_type<T>::type();
+    for (std::size_t i = 0; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+// 从按位紧密排列的数组中解压第first个起的n个宽度为bits的整数，bits不超过32
+inline void unpack(const std::uint64_t* words, unsigned bits, std::size_t first, std::size_t n,
+                   std::uint32_t* out)
+{
+    const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+    std::size_t bit = first * bits;
+    for (std::size_t i = 0; i < n; ++i, bit += bits)
+    {
+        std::size_t w = bit / 64;
+        unsigned offset = unsigned(bit % 64);
+        std::uint64_t v = words[w] >> offset;
+        if (offset + bits > 64)
+            v |= words[w + 1] << (64 - offset);
+        out[i] = std::uint32_t(v & mask);
+    }
+}
+
+} // namespace scalar
+
+#if CPPLIB_SIMD_X86
+
+/**
+ * 向量化的扫描算法，Ops提供一个指令集上某种元素类型的基本操作：
+ * lanes: 一个寄存器容纳的元素个数
+ * full: 所有元素都相等时eq返回的掩码
+ * load/store: 非对齐的加载和存储
+ * eq: 逐个比较元素，每个元素对应掩码的一位
+ * min/max: 逐个元素的最小值和最大值
+ * zero/add/total: 累加到更宽的累加器，最后求出总和
+ * 两个指令集的算法相同，只是编译的目标指令集不同.
+ */
+namespace sse42
+{
+
+template<typename T>
+struct Ops;
+
+template<>
+struct Ops<std::int32_t>
+{
+    using reg = __m128i;
+    using acc = __m128i;
+    static constexpr std::size_t lanes = 4;
+    static constexpr unsigned full = 0xF;
+
+    CPPLIB_TARGET_SSE42 static reg load(const std::int32_t* p)
+    { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    CPPLIB_TARGET_SSE42 static void store(std::int32_t* p, reg v)
+    { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    CPPLIB_TARGET_SSE42 static reg set1(std::int32_t value) { return _mm_set1_epi32(value); }
+    CPPLIB_TARGET_SSE42 static unsigned eq(reg a, reg b)
+    { return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+    CPPLIB_TARGET_SSE42 static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+    CPPLIB_TARGET_SSE42 static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+    CPPLIB_TARGET_SSE42 static acc zero() { return _mm_setzero_si128(); }
+    CPPLIB_TARGET_SSE42 static acc add(acc s, reg v)
+    {
+        s = _mm_add_epi64(s, _mm_cvtepi32_epi64(v));
+        return _mm_add_epi64(s, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    CPPLIB_TARGET_SSE42 static long long total(acc s)
+    { return _mm_cvtsi128_si64(s) + _mm_cvtsi128_si64(_mm_srli_si128(s, 8)); }
+};
+
+template<>
+struct Ops<float>
+{
+    using reg = __m128;
+    using acc = __m128;
+    static constexpr std::size_t lanes = 4;
+    static constexpr unsigned full = 0xF;
+
+    CPPLIB_TARGET_SSE42 static reg load(const float* p) { return _mm_loadu_ps(p); }
+    CPPLIB_TARGET_SSE42 static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+    CPPLIB_TARGET_SSE42 static reg set1(float value) { return _mm_set1_ps(value); }
+    CPPLIB_TARGET_SSE42 static unsigned eq(reg a, reg b) { return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+    CPPLIB_TARGET_SSE42 static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    CPPLIB_TARGET_SSE42 static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+    CPPLIB_TARGET_SSE42 static acc zero() { return _mm_setzero_ps(); }
+    CPPLIB_TARGET_SSE42 static acc add(acc s, reg v) { return _mm_add_ps(s, v); }
+    CPPLIB_TARGET_SSE42 static float total(acc s)
+    {
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        return _mm_cvtss_f32(s);
+    }
+};
+
+template<>
+struct Ops<std::uint8_t>
+{
+    using reg = __m128i;
+    using acc = __m128i;
+    static constexpr std::size_t lanes = 16;
+    static constexpr unsigned full = 0xFFFF;
+
+    CPPLIB_TARGET_SSE42 static reg load(const std::uint8_t* p)
+    { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    CPPLIB_TARGET_SSE42 static void store(std::uint8_t* p, reg v)
+    { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    CPPLIB_TARGET_SSE42 static reg set1(std::uint8_t value) { return _mm_set1_epi8(char(value)); }
+    CPPLIB_TARGET_SSE42 static unsigned eq(reg a, reg b)
+    { return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+    CPPLIB_TARGET_SSE42 static reg min(reg a, reg b) { return _mm_min_epu8(a, b); }
+    CPPLIB_TARGET_SSE42 static reg max(reg a, reg b) { return _mm_max_epu8(a, b); }
+    CPPLIB_TARGET_SSE42 static acc zero() { return _mm_setzero_si128(); }
+    // 与0的绝对差之和，把16个字节分两组求和到两个64位整数
+    CPPLIB_TARGET_SSE42 static acc add(acc s, reg v)
+    { return _mm_add_epi64(s, _mm_sad_epu8(v, _mm_setzero_si128())); }
+    CPPLIB_TARGET_SSE42 static unsigned long long total(acc s)
+    { return (unsigned long long)(_mm_cvtsi128_si64(s) + _mm_cvtsi128_si64(_mm_srli_si128(s, 8))); }
+};
+
+template<typename T>
+CPPLIB_TARGET_SSE42 bool equal(const T* a, const T* b, std::size_t n)
+{
+    using O = Ops<T>;
+    std::size_t i = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+        if (O::eq(O::load(a + i), O::load(b + i)) != O::full)
+            return false;
+    return scalar::equal(a + i, b + i, n - i);
+}
+
+template<typename T>
+CPPLIB_TARGET_SSE42 std::size_t find(const T* p, std::size_t n, T value)
+{
+    using O = Ops<T>;
+    typename O::reg v = O::set1(value);
+    std::size_t i = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+    {
+        unsigned mask = O::eq(O::load(p + i), v);
+        if (mask != 0)
+            return i + std::size_t(__builtin_ctz(mask));
+    }
+    return i + scalar::find(p + i, n - i, value);
+}
+
+template<typename T>
+CPPLIB_TARGET_SSE42 std::size_t count(const T* p, std::size_t n, T value)
+{
+    using O = Ops<T>;
+    typename O::reg v = O::set1(value);
+    std::size_t i = 0;
+    std::size_t c = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+        c += std::size_t(__builtin_popcount(O::eq(O::load(p + i), v)));
+    return c + scalar::count(p + i, n - i, value);
+}
+
+// 不足一个寄存器的尾部与前面的元素重叠加载，重复比较不影响最小值和最大值
+template<typename T>
+CPPLIB_TARGET_SSE42 T min(const T* p, std::size_t n)
+{
+    using O = Ops<T>;
+    if (n < O::lanes)
+        return scalar::min(p, n);
+    typename O::reg m = O::load(p + n - O::lanes);
+    for (std::size_t i = 0; i + O::lanes <= n; i += O::lanes)
+        m = O::min(m, O::load(p + i));
+    T lanes[O::lanes];
+    O::store(lanes, m);
+    return scalar::min(lanes, O::lanes);
+}
+
+template<typename T>
+CPPLIB_TARGET_SSE42 T max(const T* p, std::size_t n)
+{
+    using O = Ops<T>;
+    if (n < O::lanes)
+        return scalar::max(p, n);
+    typename O::reg m = O::load(p + n - O::lanes);
+    for (std::size_t i = 0; i + O::lanes <= n; i += O::lanes)
+        m = O::max(m, O::load(p + i));
+    T lanes[O::lanes];
+    O::store(lanes, m);
+    return scalar::max(lanes, O::lanes);
+}
+
+template<typename T>
+CPPLIB_TARGET_SSE42 typename sum_type<T>::type sum(const T* p, std::size_t n)
+{
+    using O = Ops<T>;
+    typename O::acc s = O::zero();
+    std::size_t i = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+        s = O::add(s, O::load(p + i));
+    return O::total(s) + scalar::sum(p + i, n - i);
+}
+
+} // namespace sse42
+
+namespace avx2
+{
+
+template<typename T>
+struct Ops;
+
+template<>
+struct Ops<std::int32_t>
+{
+    using reg = __m256i;
+    using acc = __m256i;
+    static constexpr std::size_t lanes = 8;
+    static constexpr unsigned full = 0xFF;
+
+    CPPLIB_TARGET_AVX2 static reg load(const std::int32_t* p)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    CPPLIB_TARGET_AVX2 static void store(std::int32_t* p, reg v)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    CPPLIB_TARGET_AVX2 static reg set1(std::int32_t value) { return _mm256_set1_epi32(value); }
+    CPPLIB_TARGET_AVX2 static unsigned eq(reg a, reg b)
+    { return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+    CPPLIB_TARGET_AVX2 static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+    CPPLIB_TARGET_AVX2 static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+    CPPLIB_TARGET_AVX2 static acc zero() { return _mm256_setzero_si256(); }
+    CPPLIB_TARGET_AVX2 static acc add(acc s, reg v)
+    {
+        s = _mm256_add_epi64(s, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        return _mm256_add_epi64(s, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    CPPLIB_TARGET_AVX2 static long long total(acc s)
+    {
+        __m128i t = _mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+        return _mm_cvtsi128_si64(t) + _mm_cvtsi128_si64(_mm_srli_si128(t, 8));
+    }
+};
+
+template<>
+struct Ops<float>
+{
+    using reg = __m256;
+    using acc = __m256;
+    static constexpr std::size_t lanes = 8;
+    static constexpr unsigned full = 0xFF;
+
+    CPPLIB_TARGET_AVX2 static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    CPPLIB_TARGET_AVX2 static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+    CPPLIB_TARGET_AVX2 static reg set1(float value) { return _mm256_set1_ps(value); }
+    CPPLIB_TARGET_AVX2 static unsigned eq(reg a, reg b)
+    { return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+    CPPLIB_TARGET_AVX2 static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    CPPLIB_TARGET_AVX2 static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+    CPPLIB_TARGET_AVX2 static acc zero() { return _mm256_setzero_ps(); }
+    CPPLIB_TARGET_AVX2 static acc add(acc s, reg v) { return _mm256_add_ps(s, v); }
+    CPPLIB_TARGET_AVX2 static float total(acc s)
+    {
+        __m128 t = _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+        t = _mm_add_ps(t, _mm_movehl_ps(t, t));
+        t = _mm_add_ss(t, _mm_shuffle_ps(t, t, 1));
+        return _mm_cvtss_f32(t);
+    }
+};
+
+template<>
+struct Ops<std::uint8_t>
+{
+    using reg = __m256i;
+    using acc = __m256i;
+    static constexpr std::size_t lanes = 32;
+    static constexpr unsigned full = 0xFFFFFFFF;
+
+    CPPLIB_TARGET_AVX2 static reg load(const std::uint8_t* p)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    CPPLIB_TARGET_AVX2 static void store(std::uint8_t* p, reg v)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    CPPLIB_TARGET_AVX2 static reg set1(std::uint8_t value) { return _mm256_set1_epi8(char(value)); }
+    CPPLIB_TARGET_AVX2 static unsigned eq(reg a, reg b)
+    { return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+    CPPLIB_TARGET_AVX2 static reg min(reg a, reg b) { return _mm256_min_epu8(a, b); }
+    CPPLIB_TARGET_AVX2 static reg max(reg a, reg b) { return _mm256_max_epu8(a, b); }
+    CPPLIB_TARGET_AVX2 static acc zero() { return _mm256_setzero_si256(); }
+    // 与0的绝对差之和，把32个字节分四组求和到四个64位整数
+    CPPLIB_TARGET_AVX2 static acc add(acc s, reg v)
+    { return _mm256_add_epi64(s, _mm256_sad_epu8(v, _mm256_setzero_si256())); }
+    CPPLIB_TARGET_AVX2 static unsigned long long total(acc s)
+    {
+        __m128i t = _mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+        return (unsigned long long)(_mm_cvtsi128_si64(t) + _mm_cvtsi128_si64(_mm_srli_si128(t, 8)));
+    }
+};
+
+template<typename T>
+CPPLIB_TARGET_AVX2 bool equal(const T* a, const T* b, std::size_t n)
+{
+    using O = Ops<T>;
+    std::size_t i = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+        if (O::eq(O::load(a + i), O::load(b + i)) != O::full)
+            return false;
+    return scalar::equal(a + i, b + i, n - i);
+}
+
+template<typename T>
+CPPLIB_TARGET_AVX2 std::size_t find(const T* p, std::size_t n, T value)
+{
+    using O = Ops<T>;
+    typename O::reg v = O::set1(value);
+    std::size_t i = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+    {
+        unsigned mask = O::eq(O::load(p + i), v);
+        if (mask != 0)
+            return i + std::size_t(__builtin_ctz(mask));
+    }
+    return i + scalar::find(p + i, n - i, value);
+}
+
+template<typename T>
+CPPLIB_TARGET_AVX2 std::size_t count(const T* p, std::size_t n, T value)
+{
+    using O = Ops<T>;
+    typename O::reg v = O::set1(value);
+    std::size_t i = 0;
+    std::size_t c = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+        c += std::size_t(__builtin_popcount(O::eq(O::load(p + i), v)));
+    return c + scalar::count(p + i, n - i, value);
+}
+
+// 不足一个寄存器的尾部与前面的元素重叠加载，重复比较不影响最小值和最大值
+template<typename T>
+CPPLIB_TARGET_AVX2 T min(const T* p, std::size_t n)
+{
+    using O = Ops<T>;
+    if (n < O::lanes)
+        return scalar::min(p, n);
+    typename O::reg m = O::load(p + n - O::lanes);
+    for (std::size_t i = 0; i + O::lanes <= n; i += O::lanes)
+        m = O::min(m, O::load(p + i));
+    T lanes[O::lanes];
+    O::store(lanes, m);
+    return scalar::min(lanes, O::lanes);
+}
+
+template<typename T>
+CPPLIB_TARGET_AVX2 T max(const T* p, std::size_t n)
+{
+    using O = Ops<T>;
+    if (n < O::lanes)
+        return scalar::max(p, n);
+    typename O::reg m = O::load(p + n - O::lanes);
+    for (std::size_t i = 0; i + O::lanes <= n; i += O::lanes)
+        m = O::max(m, O::load(p + i));
+    T lanes[O::lanes];
+    O::store(lanes, m);
+    return scalar::max(lanes, O::lanes);
+}
+
+template<typename T>
+CPPLIB_TARGET_AVX2 typename sum_type<T>::type sum(const T* p, std::size_t n)
+{
+    using O = Ops<T>;
+    typename O::acc s = O::zero();
+    std::size_t i = 0;
+    for (; i + O::lanes <= n; i += O::lanes)
+        s = O::add(s, O::load(p + i));
+    return O::total(s) + scalar::sum(p + i, n - i);
+}
+
+/**
+ * 每次解压8个整数.
+ * 8个整数正好占bits个字节，从下标为8的倍数的整数开始，每组的起始位置都是整字节，
+ * 组内第k个整数从第k * bits位开始，字节偏移和位移对每组都相同.
+ * 前4个整数位于前16个字节内，后4个整数位于从第4 * bits / 8个字节起的16个字节内，
+ * 两次16字节加载拼成一个寄存器后，用字节重排把每个整数所在的4个字节移到各自的通道，
+ * 再逐通道右移并屏蔽高位.
+ * bits不超过25时，一个整数连同它之前不足一字节的位不超过32位，保证这些条件成立.
+ */
+CPPLIB_TARGET_AVX2 inline void unpack(const std::uint64_t* words, std::size_t size, unsigned bits,
+                                      std::size_t first, std::size_t n, std::uint32_t* out)
+{
+    // 标量解压到组边界
+    std::size_t head = std::min(n, (8 - first % 8) % 8);
+    scalar::unpack(words, bits, first, head, out);
+    first += head;
+    n -= head;
+    out += head;
+
+    std::size_t half = 4 * bits / 8;
+    alignas(32) std::int8_t index[32];
+    alignas(32) std::int32_t shift[8];
+    for (unsigned k = 0; k < 8; ++k)
+    {
+        unsigned byte = k * bits / 8 - (k < 4 ? 0 : unsigned(half));
+        for (unsigned j = 0; j < 4; ++j)
+            index[k * 4 + j] = std::int8_t(byte + j);
+        shift[k] = std::int32_t(k * bits % 8);
+    }
+    __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(index));
+    __m256i count = _mm256_load_si256(reinterpret_cast<const __m256i*>(shift));
+    __m256i mask = _mm256_set1_epi32(std::int32_t((std::uint32_t(1) << bits) - 1));
+
+    // 两次加载都不能超出words的size个64位整数
+    const char* bytes = reinterpret_cast<const char*>(words);
+    std::size_t limit = size * sizeof(std::uint64_t);
+    std::size_t base = first / 8 * bits;
+    std::size_t i = 0;
+    for (; i + 8 <= n && base + half + 16 <= limit; i += 8, base += bits)
+    {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + base));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + base + half));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        v = _mm256_and_si256(_mm256_srlv_epi32(v, count), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+    }
+    scalar::unpack(words, bits, first + i, n - i, out + i);
+}
+
+} // namespace avx2
+
+#endif // CPPLIB_SIMD_X86
+
+// 按元素类型是否有向量化的实现分派，有时再按当前指令集级别选择实现
+template<typename T>
+bool equal(const T* a, const T* b, std::size_t n, std::false_type)
+{
+    return scalar::equal(a, b, n);
+}
+
+template<typename T>
+bool equal(const T* a, const T* b, std::size_t n, std::true_type)
+{
+#if CPPLIB_SIMD_X86
+    switch (level())
+    {
+    case Level::AVX2:  return avx2::equal(a, b, n);
+    case Level::SSE42: return sse42::equal(a, b, n);
+    default:           break;
+    }
+#endif
+    return scalar::equal(a, b, n);
+}
+
+/**
+ * 比较两个长度为n的数组是否逐个元素相等.
+ *
+ * @param a: 数组a
+ *        b: 数组b
+ *        n: 元素个数
+ * @return true: 相等
+ *         false: 不等
+ */
+template<typename T>
+bool equal(const T* a, const T* b, std::size_t n)
+{
+    return simd::equal(a, b, n, is_accelerated<T>());
+}
+
+template<typename T>
+std::size_t find(const T* p, std::size_t n, const T& value, std::false_type)
+{
+    return scalar::find(p, n, value);
+}
+
+template<typename T>
+std::size_t find(const T* p, std::size_t n, const T& value, std::true_type)
+{
+#if CPPLIB_SIMD_X86
+    switch (level())
+    {
+    case Level::AVX2:  return avx2::find(p, n, value);
+    case Level::SSE42: return sse42::find(p, n, value);
+    default:           break;
+    }
+#endif
+    return scalar::find(p, n, value);
+}
+
+/**
+ * 查找第一个等于value的元素.
+ *
+ * @param p: 数组
+ *        n: 元素个数
+ *        value: 要查找的值
+ * @return 第一个等于value的元素的索引，没有时返回n
+ */
+template<typename T>
+std::size_t find(const T* p, std::size_t n, const T& value)
+{
+    return simd::find(p, n, value, is_accelerated<T>());
+}
+
+template<typename T>
+std::size_t count(const T* p, std::size_t n, const T& value, std::false_type)
+{
+    return scalar::count(p, n, value);
+}
+
+template<typename T>
+std::size_t count(const T* p, std::size_t n, const T& value, std::true_type)
+{
+#if CPPLIB_SIMD_X86
+    switch (level())
+    {
+    case Level::AVX2:  return avx2::count(p, n, value);
+    case Level::SSE42: return sse42::count(p, n, value);
+    default:           break;
+    }
+#endif
+    return scalar::count(p, n, value);
+}
+
+/**
+ * 统计等于value的元素个数.
+ *
+ * @param p: 数组
+ *        n: 元素个数
+ *        value: 要统计的值
+ * @return 等于value的元素个数
+ */
+template<typename T>
+std::size_t count(const T* p, std::size_t n, const T& value)
+{
+    return simd::count(p, n, value, is_accelerated<T>());
+}
+
+template<typename T>
+T min(const T* p, std::size_t n, std::false_type)
+{
+    return scalar::min(p, n);
+}
+
+template<typename T>
+T min(const T* p, std::size_t n, std::true_type)
+{
+#if CPPLIB_SIMD_X86
+    switch (level())
+    {
+    case Level::AVX2:  return avx2::min(p, n);
+    case Level::SSE42: return sse42::min(p, n);
+    default:           break;
+    }
+#endif
+    return scalar::min(p, n);
+}
+
+/**
+ * 返回最小的元素，n必须大于0.
+ * 浮点数中有NaN时结果未指定.
+ *
+ * @param p: 数组
+ *        n: 元素个数
+ * @return 最小的元素
+ */
+template<typename T>
+T min(const T* p, std::size_t n)
+{
+    return simd::min(p, n, is_accelerated<T>());
+}
+
+template<typename T>
+T max(const T* p, std::size_t n, std::false_type)
+{
+    return scalar::max(p, n);
+}
+
+template<typename T>
+T max(const T* p, std::size_t n, std::true_type)
+{
+#if CPPLIB_SIMD_X86
+    switch (level())
+    {
+    case Level::AVX2:  return avx2::max(p, n);
+    case Level::SSE42: return sse42::max(p, n);
+    default:           break;
+    }
+#endif
+    return scalar::max(p, n);
+}
+
+/**
+ * 返回最大的元素，n必须大于0.
+ * 浮点数中有NaN时结果未指定.
+ *
+ * @param p: 数组
+ *        n: 元素个数
+ * @return 最大的元素
+ */
+template<typename T>
+T max(const T* p, std::size_t n)
+{
+    return simd::max(p, n, is_accelerated<T>());
+}
+
+template<typename T>
+typename sum_type<T>::type sum(const T* p, std::size_t n, std::false_type)
+{
+    return scalar::sum(p, n);
+}
+
+template<typename T>
+typename sum_type<T>::type sum(const T* p, std::size_t n, std::true_type)
+{
+#if CPPLIB_SIMD_X86
+    switch (level())
+    {
+    case Level::AVX2:  return avx2::sum(p, n);
+    case Level::SSE42: return sse42::sum(p, n);
+    default:           break;
+    }
+#endif
+    return scalar::sum(p, n);
+}
+
+/**
+ * 返回所有元素的和.
+ * 整数扩展到64位累加；浮点数分组累加，舍入误差与逐个累加不同.
+ *
+ * @param p: 数组
+ *        n: 元素个数
+ * @return 所有元素的和
+ */
+template<typename T>
+typename sum_type<T>::type sum(const T* p, std::size_t n)
+{
+    return simd::sum(p, n, is_accelerated<T>());
+}
+
+/**
+ * 从按位紧密排列的数组中批量解压整数.
+ * 第i个整数占据第i * bits位起的bits位，位从每个64位整数的最低位开始编号.
+ * bits不超过25且CPU支持AVX2时每次解压8个整数.
+ *
+ * @param words: 压缩的数组
+ *        size: 数组中64位整数的个数
+ *        bits: 每个整数的位数，在1到32之间
+ *        first: 第一个要解压的整数的下标
+ *        n: 要解压的整数个数
+ *        out: 输出数组，至少容纳n个整数
+ */
+inline void unpack(const std::uint64_t* words, std::size_t size, unsigned bits,
+                   std::size_t first, std::size_t n, std::uint32_t* out)
+{
+#if CPPLIB_SIMD_X86
+    if (level() == Level::AVX2 && bits <= 25)
+        return avx2::unpack(words, size, bits, first, n, out);
+#else
+    (void)size;
+#endif
+    scalar::unpack(words, bits, first, n, out);
+}
+
+} // namespace simd
+
+} // namespace cpplib
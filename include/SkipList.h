@@ -0,0 +1,771 @@
+/*******************************************************************************
+ * SkipList.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace cpplib
+{
+
+struct SkipNodeBase;
+
+// 跳表结点在某一层的链接，width为这个链接跨过的位置数
+struct SkipLink
+{
+    SkipNodeBase* next;
+    std::size_t width;
+};
+
+// 跳表结点的链接部分，第0层是双向链表，更高的层只有后继
+struct SkipNodeBase
+{
+    SkipNodeBase* prev;
+    SkipLink* links;     // 各层的链接，紧跟在结点之后分配
+    std::size_t height;  // 结点的层数
+};
+
+// 跳表结点
+template<typename E>
+struct SkipNode : SkipNodeBase
+{
+    E elem;
+
+    template<typename... Args>
+    explicit SkipNode(Args&&... args) : elem(std::forward<Args>(args)...) {}
+};
+
+// 跳表的双向迭代器
+template<typename E, typename Ptr, typename Ref>
+class SkipListIterator;
+
+/**
+ * 使用模板实现的可索引跳表.
+ * 提供与List相同的按位置添加、移除和访问的接口，但都是期望O(log n)的.
+ * 第0层是带哨兵结点的双向循环链表，哨兵结点是跳表对象的成员，迭代方式与List相同；
+ * 每个结点以1 / 4的概率多一层，每层的链接记录跨过的位置数，
+ * 从最高层向下按位置数累加就能定位第i个元素.
+ * 结点的层数不同，每个结点连同它的链接一次分配.
+ * 添加和移除只使指向被移除元素的迭代器失效.
+ */
+template<typename E>
+class SkipList
+{
+public:
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    // 迭代器定义
+    using iterator               = SkipListIterator<E, E*, E&>;
+    using const_iterator         = SkipListIterator<E, const E*, const E&>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // 最大层数，足够容纳4^16个元素
+    static constexpr size_type MAX_LEVEL = 16;
+private:
+    using Node = SkipNode<E>;
+public:
+    SkipList() noexcept;
+    SkipList(const SkipList& that);
+    SkipList(SkipList&& that) noexcept : SkipList() { take(that); }
+    ~SkipList() { clear(); }
+    SkipList& operator=(SkipList that);
+
+    iterator begin() noexcept { return iterator(head[0].next); }
+    iterator end()   noexcept { return iterator(&sentinel); }
+    const_iterator begin()  const noexcept { return const_iterator(head[0].next); }
+    const_iterator end()    const noexcept { return const_iterator(&sentinel); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 返回元素的数量
+    size_type size() const noexcept { return n; }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 返回可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / (sizeof(Node) + sizeof(SkipLink)); }
+
+    // 返回头部元素的const引用
+    const E& front() const;
+    // 返回尾部元素的const引用
+    const E& back() const;
+    // 返回指定位置元素的const引用，带边界检查
+    const E& at(size_type i) const;
+    // 返回头部元素的引用
+    E& front() { return const_cast<E&>(static_cast<const SkipList&>(*this).front()); }
+    // 返回尾部元素的引用
+    E& back() { return const_cast<E&>(static_cast<const SkipList&>(*this).back()); }
+    // 返回指定位置元素的引用，带边界检查
+    E& at(size_type i) { return const_cast<E&>(static_cast<const SkipList&>(*this).at(i)); }
+    // 返回指向指定位置元素的迭代器，i == size()时返回尾迭代器
+    iterator nth(size_type i);
+    const_iterator nth(size_type i) const;
+    // 返回迭代器指向的元素的位置，尾迭代器返回size()
+    size_type index_of(const_iterator pos) const noexcept;
+
+    // 在头部直接构造元素
+    template<typename... Args>
+    void emplace_front(Args&&... args) { emplace_at(0, std::forward<Args>(args)...); }
+    // 在尾部直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args) { emplace_at(n, std::forward<Args>(args)...); }
+    // 在迭代器指定的位置直接构造元素
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    { return emplace_at(index_of(pos), std::forward<Args>(args)...); }
+    // 在指定位置直接构造元素
+    template<typename... Args>
+    iterator emplace_at(size_type i, Args&&... args);
+    // 添加元素到迭代器指定的位置
+    iterator insert(const_iterator pos, E elem) { return emplace(pos, std::move(elem)); }
+    // 添加元素到指定位置
+    iterator insert(size_type i, E elem) { return emplace_at(i, std::move(elem)); }
+    // 添加元素到头部
+    void insert_front(const E& elem) { emplace_front(elem); }
+    void insert_front(E&& elem) { emplace_front(std::move(elem)); }
+    // 添加元素到尾部
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
+    // 移除迭代器指定位置的元素
+    void remove(const_iterator pos);
+    // 移除指定位置的元素
+    void remove(size_type i);
+    // 移除头部元素
+    void remove_front();
+    // 移除尾部元素
+    void remove_back();
+    // 内容与另一个SkipList对象交换
+    void swap(SkipList& that) noexcept;
+    // 清空跳表
+    void clear() noexcept;
+
+    SkipList& operator+=(const SkipList& that);
+private:
+    // 查找每层中位置不超过i的最后一个结点及其位置，哨兵结点的位置为0
+    void find_predecessors(size_type i, SkipNodeBase** update, size_type* rank) const noexcept;
+    // 定位位置为i的结点，哨兵结点的位置为0，元素从1开始
+    const SkipNodeBase* locate(size_type i) const noexcept;
+    // 生成新结点的层数
+    size_type random_height() noexcept;
+    // 创建结点并构造元素
+    template<typename... Args>
+    static Node* create_node(size_type height, Args&&... args);
+    // 析构元素并释放结点
+    static void destroy_node(SkipNodeBase* node) noexcept;
+    // 重置为空跳表，不释放结点
+    void reset() noexcept;
+    // 移动另一个跳表的结点，that变为空跳表
+    void take(SkipList& that) noexcept;
+private:
+    SkipNodeBase sentinel;     // 哨兵结点
+    SkipLink head[MAX_LEVEL];  // 哨兵结点各层的链接
+    size_type level;           // 当前使用的层数
+    size_type n;               // 元素的数量
+    std::uint32_t seed;        // 生成层数的随机数种子
+};
+
+template<typename E>
+constexpr typename SkipList<E>::size_type SkipList<E>::MAX_LEVEL;
+
+/**
+ * 跳表的双向迭代器.
+ * 迭代器指向结点的链接部分，沿第0层移动，尾迭代器指向哨兵结点.
+ */
+template<typename E, typename Ptr, typename Ref>
+class SkipListIterator
+{
+public:
+    // 成员类型定义
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = E;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    // 迭代器定义
+    using iterator          = SkipListIterator<E, E*, E&>;
+    using const_iterator    = SkipListIterator<E, const E*, const E&>;
+private:
+    using node_pointer      = SkipNodeBase*;
+public:
+    SkipListIterator() noexcept : node(nullptr) {}
+    explicit SkipListIterator(const SkipNodeBase* node) noexcept
+    : node(const_cast<node_pointer>(node)) {}
+    SkipListIterator(const iterator& that) noexcept : node(that.node) {}
+    SkipListIterator& operator=(const SkipListIterator& that) noexcept = default;
+
+    reference operator*() const noexcept
+    { return static_cast<SkipNode<E>*>(node)->elem; }
+    pointer operator->() const noexcept
+    { return &static_cast<SkipNode<E>*>(node)->elem; }
+    SkipListIterator& operator++() noexcept
+    {
+        node = node->links[0].next;
+        return *this;
+    }
+    SkipListIterator operator++(int) noexcept
+    {
+        SkipListIterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+    SkipListIterator& operator--() noexcept
+    {
+        node = node->prev;
+        return *this;
+    }
+    SkipListIterator operator--(int) noexcept
+    {
+        SkipListIterator tmp(*this);
+        --*this;
+        return tmp;
+    }
+    bool operator==(const SkipListIterator& that) const noexcept
+    { return node == that.node; }
+    bool operator!=(const SkipListIterator& that) const noexcept
+    { return node != that.node; }
+private:
+    node_pointer node; // 指向当前结点
+
+    template<typename T>
+    friend class SkipList;
+    friend class SkipListIterator<E, E*, E&>;
+    friend class SkipListIterator<E, const E*, const E&>;
+};
+
+/**
+ * 构造空跳表.
+ */
+template<typename E>
+SkipList<E>::SkipList() noexcept : level(0), n(0), seed(2463534242u)
+{
+    sentinel.links = head;
+    sentinel.height = MAX_LEVEL;
+    reset();
+}
+
+/**
+ * 复制构造函数.
+ *
+ * @param that: 被复制的跳表
+ */
+template<typename E>
+SkipList<E>::SkipList(const SkipList& that) : SkipList()
+{
+    // 委托构造已经完成，复制抛出异常时析构函数会释放已复制的结点
+    for (auto& elem : that)
+        insert_back(elem);
+}
+
+/**
+ * 重置为空跳表，不释放结点.
+ */
+template<typename E>
+void SkipList<E>::reset() noexcept
+{
+    sentinel.prev = &sentinel;
+    head[0].next = &sentinel;
+    head[0].width = 1;
+    level = 0;
+    n = 0;
+}
+
+/**
+ * 移动另一个跳表的所有结点到这个空跳表，that变为空跳表.
+ * 哨兵结点是跳表对象的成员，需要修改每层最后一个结点指向哨兵的链接，
+ * 从最高层向下查找这些结点是期望O(log n)的.
+ *
+ * @param that: 被移动的跳表
+ */
+template<typename E>
+void SkipList<E>::take(SkipList& that) noexcept
+{
+    if (that.empty())
+        return;
+    std::copy(that.head, that.head + that.level, head);
+    level = that.level;
+    n = that.n;
+    SkipNodeBase* x = &sentinel;
+    for (size_type l = level; l-- > 0;)
+    {
+        while (x->links[l].next != &that.sentinel)
+            x = x->links[l].next;
+        x->links[l].next = &sentinel;
+    }
+    sentinel.prev = that.sentinel.prev;
+    head[0].next->prev = &sentinel;
+    that.reset();
+}
+
+/**
+ * 查找每层中位置不超过i的最后一个结点.
+ * 新元素添加到位置i + 1时，这些结点的链接需要修改.
+ *
+ * @param i: 位置，要求i <= size()
+ *        update: 保存每层的结点
+ *        rank: 保存每层的结点的位置
+ */
+template<typename E>
+void SkipList<E>::find_predecessors(size_type i, SkipNodeBase** update, size_type* rank) const noexcept
+{
+    SkipNodeBase* x = const_cast<SkipNodeBase*>(&sentinel);
+    size_type pos = 0;
+    for (size_type l = level; l-- > 0;)
+    {
+        // 指向尾部的链接跨到位置n + 1，不会越过i
+        while (pos + x->links[l].width <= i)
+        {
+            pos += x->links[l].width;
+            x = x->links[l].next;
+        }
+        update[l] = x;
+        rank[l] = pos;
+    }
+}
+
+/**
+ * 定位位置为i的结点.
+ *
+ * @param i: 位置，元素从1开始，要求i <= size()
+ * @return 指向该位置结点的指针
+ */
+template<typename E>
+const SkipNodeBase* SkipList<E>::locate(size_type i) const noexcept
+{
+    const SkipNodeBase* x = &sentinel;
+    size_type pos = 0;
+    for (size_type l = level; l-- > 0 && pos != i;)
+    {
+        while (pos + x->links[l].width <= i)
+        {
+            pos += x->links[l].width;
+            x = x->links[l].next;
+        }
+    }
+    return x;
+}
+
+/**
+ * 生成新结点的层数.
+ * 使用xorshift生成随机数，每两位为0的概率是1 / 4，层数服从几何分布.
+ *
+ * @return 层数，在[1, MAX_LEVEL]范围内
+ */
+template<typename E>
+typename SkipList<E>::size_type SkipList<E>::random_height() noexcept
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    std::uint32_t bits = seed;
+    size_type height = 1;
+    for (; height < MAX_LEVEL && (bits & 3) == 0; bits >>= 2)
+        ++height;
+    return height;
+}
+
+/**
+ * 创建结点并用参数构造元素.
+ * 结点的链接数组紧跟在结点之后，与结点一起分配.
+ *
+ * @param height: 结点的层数
+ *        args: 用于构造元素的参数
+ * @return 新结点
+ */
+template<typename E>
+template<typename... Args>
+typename SkipList<E>::Node* SkipList<E>::create_node(size_type height, Args&&... args)
+{
+    void* p = ::operator new(sizeof(Node) + height * sizeof(SkipLink));
+    Node* node;
+    try
+    {
+        node = ::new(p) Node(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        ::operator delete(p);
+        throw;
+    }
+    node->links = reinterpret_cast<SkipLink*>(reinterpret_cast<char*>(node) + sizeof(Node));
+    node->height = height;
+    return node;
+}
+
+/**
+ * 析构结点的元素并释放结点.
+ *
+ * @param node: 要释放的结点
+ */
+template<typename E>
+void SkipList<E>::destroy_node(SkipNodeBase* node) noexcept
+{
+    Node* p = static_cast<Node*>(node);
+    p->~Node();
+    ::operator delete(p);
+}
+
+/**
+ * 在指定位置直接构造元素.
+ * 新结点在自己的每一层链接到前驱之后，并按位置拆分前驱链接跨过的位置数；
+ * 更高层中跨过新结点的链接跨过的位置数加1.
+ *
+ * @param i: 新元素的位置，在[0, size()]范围内
+ *        args: 用于构造元素的参数
+ * @return 指向新元素的迭代器
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E>
+template<typename... Args>
+typename SkipList<E>::iterator SkipList<E>::emplace_at(size_type i, Args&&... args)
+{
+    if (i > n)
+        throw std::out_of_range("SkipList::insert");
+    Node* node = create_node(random_height(), std::forward<Args>(args)...);
+    SkipNodeBase* update[MAX_LEVEL] = {};
+    size_type rank[MAX_LEVEL] = {};
+    find_predecessors(i, update, rank);
+    size_type height = node->height;
+    for (; level < height; ++level)
+    {
+        head[level].next = &sentinel;
+        head[level].width = n + 1;
+        update[level] = &sentinel;
+        rank[level] = 0;
+    }
+    for (size_type l = 0; l < height; ++l)
+    {
+        SkipLink& link = update[l]->links[l];
+        node->links[l].next = link.next;
+        node->links[l].width = link.width - (i - rank[l]);
+        link.next = node;
+        link.width = i - rank[l] + 1;
+    }
+    for (size_type l = height; l < level; ++l)
+        ++update[l]->links[l].width;
+    node->prev = update[0];
+    node->links[0].next->prev = node;
+    ++n;
+    return iterator(node);
+}
+
+/**
+ * 移除指定位置的元素.
+ * 指向被移除结点的链接改为指向它的后继，跨过的位置数合并；
+ * 其他跨过它的链接跨过的位置数减1.
+ *
+ * @param i: 要移除元素的位置
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E>
+void SkipList<E>::remove(size_type i)
+{
+    if (i >= n)
+        throw std::out_of_range("SkipList::remove");
+    SkipNodeBase* update[MAX_LEVEL] = {};
+    size_type rank[MAX_LEVEL] = {};
+    find_predecessors(i, update, rank);
+    SkipNodeBase* node = update[0]->links[0].next;
+    for (size_type l = 0; l < level; ++l)
+    {
+        SkipLink& link = update[l]->links[l];
+        if (link.next == node)
+        {
+            link.width += node->links[l].width - 1;
+            link.next = node->links[l].next;
+        }
+        else
+        {
+            --link.width;
+        }
+    }
+    node->links[0].next->prev = update[0];
+    while (level > 0 && head[level - 1].next == &sentinel)
+        --level;
+    destroy_node(node);
+    --n;
+}
+
+/**
+ * 移除迭代器指定位置的元素.
+ *
+ * @param pos: 要移除元素的位置
+ * @throws std::out_of_range: 位置为尾迭代器
+ */
+template<typename E>
+void SkipList<E>::remove(const_iterator pos)
+{
+    if (pos.node == &sentinel)
+        throw std::out_of_range("SkipList::remove");
+    remove(index_of(pos));
+}
+
+/**
+ * 移除头部元素.
+ *
+ * @throws std::out_of_range: 跳表为空
+ */
+template<typename E>
+void SkipList<E>::remove_front()
+{
+    if (empty())
+        throw std::out_of_range("SkipList::remove_front");
+    remove(size_type(0));
+}
+
+/**
+ * 移除尾部元素.
+ *
+ * @throws std::out_of_range: 跳表为空
+ */
+template<typename E>
+void SkipList<E>::remove_back()
+{
+    if (empty())
+        throw std::out_of_range("SkipList::remove_back");
+    remove(n - 1);
+}
+
+/**
+ * 返回头部元素的const引用.
+ *
+ * @return 头部元素的const引用
+ * @throws std::out_of_range: 跳表为空
+ */
+template<typename E>
+const E& SkipList<E>::front() const
+{
+    if (empty())
+        throw std::out_of_range("SkipList::front");
+    return *begin();
+}
+
+/**
+ * 返回尾部元素的const引用.
+ *
+ * @return 尾部元素的const引用
+ * @throws std::out_of_range: 跳表为空
+ */
+template<typename E>
+const E& SkipList<E>::back() const
+{
+    if (empty())
+        throw std::out_of_range("SkipList::back");
+    return *std::prev(end());
+}
+
+/**
+ * 返回指定位置元素的const引用，并进行越界检查.
+ *
+ * @param i: 指定元素的索引
+ * @return 指定位置元素的const引用
+ * @throws std::out_of_range: 索引不合法
+ */
+template<typename E>
+const E& SkipList<E>::at(size_type i) const
+{
+    if (i >= n)
+        throw std::out_of_range("SkipList::at");
+    return static_cast<const Node*>(locate(i + 1))->elem;
+}
+
+/**
+ * 返回指向指定位置元素的迭代器.
+ *
+ * @param i: 指定元素的索引，i == size()时返回尾迭代器
+ * @return 指向该元素的迭代器
+ * @throws std::out_of_range: 索引大于size()
+ */
+template<typename E>
+typename SkipList<E>::const_iterator SkipList<E>::nth(size_type i) const
+{
+    if (i > n)
+        throw std::out_of_range("SkipList::nth");
+    return i == n ? end() : const_iterator(locate(i + 1));
+}
+
+/**
+ * 返回指向指定位置元素的迭代器.
+ *
+ * @param i: 指定元素的索引，i == size()时返回尾迭代器
+ * @return 指向该元素的迭代器
+ * @throws std::out_of_range: 索引大于size()
+ */
+template<typename E>
+typename SkipList<E>::iterator SkipList<E>::nth(size_type i)
+{
+    return iterator(static_cast<const SkipList&>(*this).nth(i).node);
+}
+
+/**
+ * 返回迭代器指向的元素的位置.
+ * 从结点出发每次沿最高层的链接向后跳到哨兵结点，累加跨过的位置数，期望O(log n).
+ *
+ * @param pos: 这个跳表的迭代器
+ * @return 元素的索引，尾迭代器返回size()
+ */
+template<typename E>
+typename SkipList<E>::size_type SkipList<E>::index_of(const_iterator pos) const noexcept
+{
+    size_type distance = 0;
+    for (const SkipNodeBase* x = pos.node; x != &sentinel;)
+    {
+        const SkipLink& link = x->links[x->height - 1];
+        distance += link.width;
+        x = link.next;
+    }
+    // 哨兵结点作为尾部的位置是n + 1，元素的位置是n + 1 - distance，索引比位置小1
+    return n - distance;
+}
+
+/**
+ * 交换当前SkipList对象和另一个SkipList对象.
+ *
+ * @param that: 要交换的对象
+ */
+template<typename E>
+void SkipList<E>::swap(SkipList& that) noexcept
+{
+    SkipList tmp;
+    tmp.take(that);
+    that.take(*this);
+    take(tmp);
+}
+
+/**
+ * 清空跳表，析构所有元素并释放所有结点.
+ */
+template<typename E>
+void SkipList<E>::clear() noexcept
+{
+    SkipNodeBase* current = head[0].next;
+    while (current != &sentinel)
+    {
+        SkipNodeBase* next = current->links[0].next;
+        destroy_node(current);
+        current = next;
+    }
+    reset();
+}
+
+/**
+ * 赋值运算符.
+ *
+ * @param that: 要复制或移动的对象
+ * @return 当前对象
+ */
+template<typename E>
+SkipList<E>& SkipList<E>::operator=(SkipList that)
+{
+    clear();
+    take(that);
+    return *this;
+}
+
+/**
+ * 复制另一个对象的所有元素，添加到当前对象的尾部.
+ *
+ * @param that: 要复制的对象
+ * @return 当前对象
+ */
+template<typename E>
+SkipList<E>& SkipList<E>::operator+=(const SkipList& that)
+{
+    // that与当前对象相同时，只复制原有的元素
+    size_type count = that.size();
+    auto it = that.begin();
+    for (size_type i = 0; i < count; ++i, ++it)
+        insert_back(*it);
+    return *this;
+}
+
+/**
+ * 返回一个包含lhs和rhs所有元素的对象.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 包含lhs和rhs所有元素的对象
+ */
+template<typename E>
+SkipList<E> operator+(SkipList<E> lhs, const SkipList<E>& rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+/**
+ * 判断两个SkipList对象是否相等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 相等返回true，否则返回false
+ */
+template<typename E>
+bool operator==(const SkipList<E>& lhs, const SkipList<E>& rhs)
+{
+    if (&lhs == &rhs)             return true;
+    if (lhs.size() != rhs.size()) return false;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * 判断两个SkipList对象是否不等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 不等返回true，否则返回false
+ */
+template<typename E>
+bool operator!=(const SkipList<E>& lhs, const SkipList<E>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * 输出所有元素.
+ *
+ * @param os: 输出流
+ *        list: 要输出的跳表
+ * @return 输出流
+ */
+template<typename E>
+std::ostream& operator<<(std::ostream& os, const SkipList<E>& list)
+{
+    for (auto& i : list)
+        os << i << " ";
+    return os;
+}
+
+/**
+ * 交换两个SkipList对象.
+ *
+ * @param lhs: 要交换的对象
+ *        rhs: 要交换的对象
+ */
+template<typename E>
+void swap(SkipList<E>& lhs, SkipList<E>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace cpplib
@@ -0,0 +1,684 @@
+/*******************************************************************************
+ * SmallVector.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Vector.h"
+
+namespace cpplib
+{
+
+/**
+ * 使用模板实现的小型Vector.
+ * 对象内部带有容纳Count个元素的内联空间，元素个数不超过Count时不分配堆内存，
+ * 超过Count时才把元素搬移到堆上，之后按增长策略Policy扩容和收缩.
+ * 收缩到不超过Count个元素的容量时，元素搬回内联空间.
+ * 提供与Vector相同的接口.
+ */
+template<typename E, std::size_t Count, typename Policy = GrowthFactor<>>
+class SmallVector
+{
+    static_assert(Count > 0, "Count must be positive");
+public:
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = std::allocator<E>;
+    using growth_policy   = Policy;
+    // 原生指针具备随机访问迭代器的一切特征
+    using iterator               = E*;
+    using const_iterator         = const E*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // 内联空间可容纳的元素个数
+    static constexpr size_type INLINE_CAPACITY = Count;
+private:
+    using allocator_traits = typename std::allocator_traits<allocator_type>;
+    using storage_type = typename std::aligned_storage<sizeof(E), alignof(E)>::type;
+    // 搬移元素的方式，移动构造可能抛出异常且可以复制时使用复制，保证强异常安全
+    using relocate_iterator = typename std::conditional<
+            std::is_nothrow_move_constructible<E>::value || !std::is_copy_constructible<E>::value,
+            std::move_iterator<E*>, const E*>::type;
+public:
+    explicit SmallVector(size_type count = Count);
+    SmallVector(const SmallVector& that);
+    SmallVector(SmallVector&& that) noexcept(std::is_nothrow_move_constructible<E>::value);
+    ~SmallVector();
+    SmallVector& operator=(SmallVector that);
+    allocator_type get_allocator() const noexcept { return allocator_type(); }
+
+    iterator begin() noexcept { return pv; }
+    iterator end()   noexcept { return pv + n; }
+    const_iterator begin()  const noexcept { return pv; }
+    const_iterator end()    const noexcept { return pv + n; }
+    const_iterator cbegin() const noexcept { return pv; }
+    const_iterator cend()   const noexcept { return pv + n; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    // 返回元素的数量
+    size_type size() const noexcept { return n; }
+    // 返回容量
+    size_type capacity() const noexcept { return N; }
+    // 返回可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(E); }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 判断元素是否存储在内联空间
+    bool is_inline() const noexcept { return pv == inline_data(); }
+    // 预留至少容纳count个元素的容量，不会减小容量
+    void reserve(size_type count) { if (count > N) reallocate(count); }
+    // 收缩容量到元素个数，元素个数不超过Count时搬回内联空间
+    void shrink_to_fit() { if (n < N) reallocate(n); }
+    // 改变元素的数量，新增的元素值初始化
+    void resize(size_type count);
+    // 改变元素的数量，新增的元素复制value
+    void resize(size_type count, const E& value);
+    // 在尾部直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+    // 添加元素到指定位置
+    void insert(const_iterator pos, E elem);
+    // 添加元素到尾部
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
+    // 移除指定位置的元素
+    void remove(const_iterator pos);
+    // 移除尾部元素
+    void remove_back();
+    // 返回指定位置元素的引用，带边界检查
+    E& at(size_type i) { return const_cast<E&>(static_cast<const SmallVector&>(*this).at(i)); }
+    // 返回指定位置元素的const引用，带边界检查
+    const E& at(size_type i) const;
+    // 返回头部元素的引用
+    E& front() { return const_cast<E&>(static_cast<const SmallVector&>(*this).front()); }
+    // 返回头部元素的const引用
+    const E& front() const;
+    // 返回尾部元素的引用
+    E& back() { return const_cast<E&>(static_cast<const SmallVector&>(*this).back()); }
+    // 返回尾部元素的const引用
+    const E& back() const;
+    // 内容与另一个SmallVector对象交换
+    void swap(SmallVector& that) noexcept(std::is_nothrow_move_constructible<E>::value);
+    // 清空元素，容量不变
+    void clear() noexcept { destroy(pv, pv + n); n = 0; }
+
+    // 返回指定位置元素的引用，无边界检查
+    E& operator[](size_type i) { return pv[i]; }
+    // 返回指定位置元素的const引用，无边界检查
+    const E& operator[](size_type i) const { return pv[i]; }
+    SmallVector& operator+=(const SmallVector& that);
+private:
+    // 内联空间的起始位置
+    pointer inline_data() noexcept { return reinterpret_cast<pointer>(buffer); }
+    const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(buffer); }
+    // 调整容量，容量不超过Count时使用内联空间
+    void reallocate(size_type count);
+    // 按增长策略扩容后的容量，至少容纳required个元素
+    size_type grow_capacity(size_type required) const noexcept
+    { return Policy::grow(N, required); }
+    // 移除元素后按增长策略收缩
+    void shrink()
+    {
+        size_type count = Policy::shrink(n, N);
+        if (count < N)
+            reallocate(count);
+    }
+    // 扩容并在新空间的尾部构造元素
+    template<typename... Args>
+    void emplace_back_grow(Args&&... args);
+    // 把[first, last)的元素搬移到未初始化的空间destination，并析构原来的元素
+    void relocate(pointer first, pointer last, pointer destination)
+    { relocate(first, last, destination, is_trivially_relocatable<E>()); }
+    void relocate(pointer first, pointer last, pointer destination, std::true_type) noexcept;
+    void relocate(pointer first, pointer last, pointer destination, std::false_type);
+    // 释放所有元素和堆空间，然后接管另一个对象的元素，that变为空
+    void take(SmallVector& that) noexcept(std::is_nothrow_move_constructible<E>::value);
+    // 析构迭代器范围内的元素
+    void destroy(pointer first, pointer last) noexcept;
+    // 检查索引是否合法
+    bool valid(size_type i) const noexcept { return i < n; }
+private:
+    pointer pv;   // 元素空间，指向内联空间或堆空间
+    size_type n;  // 元素个数
+    size_type N;  // 容量
+    storage_type buffer[Count]; // 内联空间
+    allocator_type allocator;
+};
+
+template<typename E, std::size_t Count, typename Policy>
+constexpr typename SmallVector<E, Count, Policy>::size_type
+SmallVector<E, Count, Policy>::INLINE_CAPACITY;
+
+/**
+ * SmallVector构造函数.
+ * 容量不超过Count时使用内联空间，不分配堆内存.
+ *
+ * @param count: 指定容量
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy>::SmallVector(size_type count)
+: pv(inline_data()), n(0), N(Count)
+{
+    if (count > Count)
+    {
+        pv = allocator_traits::allocate(allocator, count);
+        N = count;
+    }
+}
+
+/**
+ * SmallVector复制构造函数.
+ * 容量按元素个数确定，元素个数不超过Count时副本使用内联空间.
+ *
+ * @param that: 被复制的SmallVector
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy>::SmallVector(const SmallVector& that)
+: SmallVector(that.n)
+{
+    // 委托构造已经完成，复制抛出异常时析构函数会释放空间
+    std::uninitialized_copy(that.begin(), that.end(), pv);
+    n = that.n;
+}
+
+/**
+ * SmallVector移动构造函数.
+ * that使用堆空间时直接接管堆空间；使用内联空间时逐个搬移元素，至多Count个.
+ *
+ * @param that: 被移动的SmallVector
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy>::SmallVector(SmallVector&& that)
+noexcept(std::is_nothrow_move_constructible<E>::value)
+: pv(inline_data()), n(0), N(Count)
+{
+    take(that);
+}
+
+/**
+ * SmallVector析构函数.
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy>::~SmallVector()
+{
+    destroy(pv, pv + n);
+    if (!is_inline())
+        allocator_traits::deallocate(allocator, pv, N);
+}
+
+/**
+ * =操作符重载.
+ * 让当前SmallVector对象等于给定SmallVector对象that.
+ *
+ * @param that: SmallVector对象that
+ * @return 当前SmallVector对象
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy>& SmallVector<E, Count, Policy>::operator=(SmallVector that)
+{
+    take(that);
+    return *this;
+}
+
+/**
+ * 释放所有元素和堆空间，然后接管另一个对象的元素.
+ * that使用堆空间时接管堆空间，否则把元素搬移到内联空间，that变为空.
+ *
+ * @param that: 被接管的SmallVector
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::take(SmallVector& that)
+noexcept(std::is_nothrow_move_constructible<E>::value)
+{
+    clear();
+    if (!is_inline())
+    {
+        allocator_traits::deallocate(allocator, pv, N);
+        pv = inline_data();
+        N = Count;
+    }
+    if (that.is_inline())
+    {
+        relocate(that.pv, that.pv + that.n, pv);
+        n = that.n;
+    }
+    else
+    {
+        pv = that.pv;
+        n = that.n;
+        N = that.N;
+        that.pv = that.inline_data();
+        that.N = Count;
+    }
+    that.n = 0;
+}
+
+/**
+ * 调整容量，只搬移已构造的元素.
+ * 新容量不超过Count时使用内联空间，否则分配新的堆空间.
+ *
+ * @param count: 新容量
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::reallocate(size_type count)
+{
+    if (count < n)
+        count = n;
+    if (count <= Count)
+    {
+        if (is_inline())
+            return;
+        pointer p = inline_data();
+        relocate(pv, pv + n, p);
+        allocator_traits::deallocate(allocator, pv, N);
+        pv = p;
+        N = Count;
+        return;
+    }
+    if (count > max_size())
+        throw std::length_error("SmallVector::reserve");
+    pointer p = allocator_traits::allocate(allocator, count);
+    try
+    {
+        relocate(pv, pv + n, p);
+    }
+    catch (...)
+    {
+        allocator_traits::deallocate(allocator, p, count);
+        throw;
+    }
+    if (!is_inline())
+        allocator_traits::deallocate(allocator, pv, N);
+    pv = p;
+    N = count;
+}
+
+/**
+ * 把可以平凡重定位的元素按字节搬移到未初始化的空间.
+ *
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
+ *        destination: 目标空间
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::relocate(pointer first, pointer last, pointer destination,
+                                             std::true_type) noexcept
+{
+    if (first != last)
+        std::memcpy(static_cast<void*>(destination), static_cast<const void*>(first),
+                    (last - first) * sizeof(E));
+}
+
+/**
+ * 把元素逐个移动构造到未初始化的空间，并析构原来的元素.
+ * 构造抛出异常时原来的元素保持不变.
+ *
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
+ *        destination: 目标空间
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::relocate(pointer first, pointer last, pointer destination,
+                                             std::false_type)
+{
+    std::uninitialized_copy(relocate_iterator(first), relocate_iterator(last), destination);
+    destroy(first, last);
+}
+
+/**
+ * 改变元素的数量.
+ * 元素数量增加时，新增的元素值初始化；减少时，析构多余的元素.
+ *
+ * @param count: 新的元素数量
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::resize(size_type count)
+{
+    if (count < n)
+    {
+        destroy(pv + count, pv + n);
+        n = count;
+        return;
+    }
+    if (count > N)
+        reallocate(grow_capacity(count));
+    for (; n < count; ++n)
+        allocator_traits::construct(allocator, pv + n);
+}
+
+/**
+ * 改变元素的数量.
+ * 元素数量增加时，新增的元素复制value；减少时，析构多余的元素.
+ *
+ * @param count: 新的元素数量
+ *        value: 新增元素的值
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::resize(size_type count, const E& value)
+{
+    if (count < n)
+    {
+        destroy(pv + count, pv + n);
+        n = count;
+        return;
+    }
+    if (count > N)
+    {
+        // value可能引用SmallVector中的元素，先复制再扩容
+        E tmp(value);
+        reallocate(grow_capacity(count));
+        std::uninitialized_fill(pv + n, pv + count, tmp);
+    }
+    else
+        std::uninitialized_fill(pv + n, pv + count, value);
+    n = count;
+}
+
+/**
+ * 在尾部直接构造元素.
+ * 容量已满时，按增长策略扩容到堆空间后，再构造元素.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, std::size_t Count, typename Policy>
+template<typename... Args>
+void SmallVector<E, Count, Policy>::emplace_back(Args&&... args)
+{
+    if (n == N)
+        return emplace_back_grow(std::forward<Args>(args)...);
+    allocator_traits::construct(allocator, pv + n, std::forward<Args>(args)...);
+    ++n;
+}
+
+/**
+ * 扩容到堆空间并在新空间的尾部构造元素.
+ * 先构造新元素再搬移原有元素，参数引用SmallVector中的元素时也是安全的.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, std::size_t Count, typename Policy>
+template<typename... Args>
+void SmallVector<E, Count, Policy>::emplace_back_grow(Args&&... args)
+{
+    size_type count = grow_capacity(n + 1);
+    pointer p = allocator_traits::allocate(allocator, count);
+    try
+    {
+        allocator_traits::construct(allocator, p + n, std::forward<Args>(args)...);
+        try
+        {
+            relocate(pv, pv + n, p);
+        }
+        catch (...)
+        {
+            allocator_traits::destroy(allocator, p + n);
+            throw;
+        }
+    }
+    catch (...)
+    {
+        allocator_traits::deallocate(allocator, p, count);
+        throw;
+    }
+    if (!is_inline())
+        allocator_traits::deallocate(allocator, pv, N);
+    pv = p;
+    N = count;
+    ++n;
+}
+
+/**
+ * 添加元素到指定位置.
+ * 容量已满时，按增长策略扩容后，再添加元素.
+ *
+ * @param pos: 要添加元素的位置
+ *        elem: 要添加的元素
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::insert(const_iterator pos, E elem)
+{
+    size_type i = size_type(pos - cbegin());
+    if (i == n)
+        return emplace_back(std::move(elem));
+    if (!valid(i))
+        throw std::out_of_range("SmallVector::insert");
+    if (n == N)
+        reallocate(grow_capacity(n + 1));
+    // 在尾部构造最后一个元素的副本，再将pv[i]后面的元素向后迁移一个位置
+    allocator_traits::construct(allocator, pv + n, std::move(pv[n - 1]));
+    ++n;
+    std::move_backward(pv + i, pv + n - 2, pv + n - 1);
+    pv[i] = std::move(elem);
+}
+
+/**
+ * 移除指定位置的元素.
+ * 移除后按增长策略收缩容量.
+ *
+ * @param pos: 要移除元素的位置
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::remove(const_iterator pos)
+{
+    size_type i = size_type(pos - cbegin());
+    if (!valid(i))
+        throw std::out_of_range("SmallVector::remove");
+    // 将pv[i]后面的所有元素向前迁移一个位置
+    std::move(pv + i + 1, pv + n, pv + i);
+    allocator_traits::destroy(allocator, pv + --n);
+    shrink();
+}
+
+/**
+ * 移除尾部元素.
+ * 移除后按增长策略收缩容量.
+ *
+ * @throws std::out_of_range: SmallVector为空
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::remove_back()
+{
+    if (empty())
+        throw std::out_of_range("SmallVector::remove_back");
+    allocator_traits::destroy(allocator, pv + --n);
+    shrink();
+}
+
+/**
+ * 返回头部元素的const引用.
+ *
+ * @return 头部元素的const引用
+ * @throws std::out_of_range: SmallVector为空
+ */
+template<typename E, std::size_t Count, typename Policy>
+const E& SmallVector<E, Count, Policy>::front() const
+{
+    if (empty())
+        throw std::out_of_range("SmallVector::front");
+    return *begin();
+}
+
+/**
+ * 返回尾部元素的const引用.
+ *
+ * @return 尾部元素的const引用
+ * @throws std::out_of_range: SmallVector为空
+ */
+template<typename E, std::size_t Count, typename Policy>
+const E& SmallVector<E, Count, Policy>::back() const
+{
+    if (empty())
+        throw std::out_of_range("SmallVector::back");
+    return *std::prev(end());
+}
+
+/**
+ * 返回指定位置元素的const引用，并进行越界检查.
+ *
+ * @return 指定位置元素的const引用
+ * @throws std::out_of_range: 索引不合法
+ */
+template<typename E, std::size_t Count, typename Policy>
+const E& SmallVector<E, Count, Policy>::at(size_type i) const
+{
+    if (!valid(i))
+        throw std::out_of_range("SmallVector::at");
+    return (*this)[i];
+}
+
+/**
+ * 交换当前SmallVector对象和另一个SmallVector对象.
+ * 两者都使用堆空间时只交换指针，否则通过临时对象搬移元素.
+ *
+ * @param that: SmallVector对象that
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::swap(SmallVector& that)
+noexcept(std::is_nothrow_move_constructible<E>::value)
+{
+    if (this == &that)
+        return;
+    if (!is_inline() && !that.is_inline())
+    {
+        using std::swap;
+        swap(pv, that.pv);
+        swap(n, that.n);
+        swap(N, that.N);
+        return;
+    }
+    SmallVector tmp(std::move(that));
+    that.take(*this);
+    take(tmp);
+}
+
+/**
+ * 析构迭代器范围内的元素，不释放空间.
+ *
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
+ */
+template<typename E, std::size_t Count, typename Policy>
+void SmallVector<E, Count, Policy>::destroy(pointer first, pointer last) noexcept
+{
+    for (; first != last; ++first)
+        allocator_traits::destroy(allocator, first);
+}
+
+/**
+ * +=操作符重载.
+ * 复制另一个对象所有元素,添加到当前对象.
+ *
+ * @param that: SmallVector对象that
+ * @return 当前SmallVector对象
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy>& SmallVector<E, Count, Policy>::operator+=(const SmallVector& that)
+{
+    // that与当前对象相同时，扩容后that的元素位置随之改变
+    size_type count = that.n;
+    if (n + count > N)
+        reallocate(grow_capacity(n + count));
+    std::uninitialized_copy(that.pv, that.pv + count, pv + n);
+    n += count;
+    return *this;
+}
+
+/**
+ * +操作符重载.
+ * 返回一个包含lhs和rhs所有元素的对象.
+ *
+ * @param lhs: SmallVector对象lhs
+ *        rhs: SmallVector对象rhs
+ * @return 包含lhs和rhs所有元素的SmallVector对象
+ */
+template<typename E, std::size_t Count, typename Policy>
+SmallVector<E, Count, Policy> operator+(SmallVector<E, Count, Policy> lhs,
+                                        const SmallVector<E, Count, Policy>& rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+/**
+ * ==操作符重载函数，比较两个SmallVector对象是否相等.
+ *
+ * @param lhs: SmallVector对象lhs
+ *        rhs: SmallVector对象rhs
+ * @return true: 相等
+ *         false: 不等
+ */
+template<typename E, std::size_t Count, typename Policy>
+bool operator==(const SmallVector<E, Count, Policy>& lhs, const SmallVector<E, Count, Policy>& rhs)
+{
+    if (&lhs == &rhs)             return true;
+    if (lhs.size() != rhs.size()) return false;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * !=操作符重载函数，比较两个SmallVector对象是否不等.
+ *
+ * @param lhs: SmallVector对象lhs
+ *        rhs: SmallVector对象rhs
+ * @return true: 不等
+ *         false: 相等
+ */
+template<typename E, std::size_t Count, typename Policy>
+bool operator!=(const SmallVector<E, Count, Policy>& lhs, const SmallVector<E, Count, Policy>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * <<操作符重载函数，打印所有元素.
+ *
+ * @param os: 输出流对象
+ *        vector: 要输出的SmallVector
+ * @return 输出流对象
+ */
+template<typename E, std::size_t Count, typename Policy>
+std::ostream& operator<<(std::ostream& os, const SmallVector<E, Count, Policy>& vector)
+{
+    for (auto& i : vector)
+        os << i << " ";
+    return os;
+}
+
+/**
+ * 交换两个SmallVector对象.
+ *
+ * @param lhs: SmallVector对象lhs
+ *        rhs: SmallVector对象rhs
+ */
+template<typename E, std::size_t Count, typename Policy>
+void swap(SmallVector<E, Count, Policy>& lhs, SmallVector<E, Count, Policy>& rhs)
+noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+} // namespace cpplib
@@ -0,0 +1,391 @@
+/*******************************************************************************
+ * SoAVector.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Vector.h"
+
+namespace cpplib
+{
+
+/**
+ * 连续数组的视图，不拥有元素.
+ * SoAVector用它返回一列元素，供循环直接按下标或指针访问.
+ */
+template<typename T>
+class Span
+{
+public:
+    // 成员类型定义
+    using value_type = typename std::remove_const<T>::type;
+    using size_type  = std::size_t;
+    using iterator   = T*;
+public:
+    Span(T* p, size_type n) noexcept : p(p), n(n) {}
+
+    iterator begin() const noexcept { return p; }
+    iterator end()   const noexcept { return p + n; }
+    // 返回首元素的地址
+    T* data() const noexcept { return p; }
+    // 返回元素的数量
+    size_type size() const noexcept { return n; }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 下标运算符，不检查边界
+    T& operator[](size_type i) const noexcept { return p[i]; }
+private:
+    T* p;        // 首元素的地址
+    size_type n; // 元素的数量
+};
+
+// 编译期的下标序列，用于展开SoAVector的所有列
+template<std::size_t... I>
+struct IndexSequence {};
+
+template<std::size_t N, std::size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template<std::size_t... I>
+struct MakeIndexSequence<0, I...> { using type = IndexSequence<I...>; };
+
+// SoAVector的随机访问迭代器，SoA为容器类型（可带const），Ref为一行的引用类型
+template<typename SoA, typename Ref>
+class SoAIterator;
+
+/**
+ * 使用模板实现的列存储Vector.
+ * 一行记录由Fields中的各个字段组成，每个字段单独存放在一个Vector中，
+ * 所有列的元素个数相同，第i行由每列的第i个元素组成.
+ * 只访问少数字段的循环只读取这些列，缓存行中没有不用的字段；
+ * 每列起始地址按ALIGNMENT字节对齐，容量是整数个向量通道，循环容易被编译器向量化.
+ * 扩容和收缩由每列的Vector按增长策略Policy完成.
+ * operator[]返回由各字段引用组成的std::tuple，作为一行的代理对象；
+ * column返回一列的Span，供热点循环直接访问.
+ */
+template<typename Policy, typename... Fields>
+class BasicSoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "SoAVector requires at least one field");
+public:
+    // 成员类型定义
+    using value_type      = std::tuple<Fields...>;
+    using reference       = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using growth_policy   = Policy;
+    // 迭代器定义
+    using iterator        = SoAIterator<BasicSoAVector, reference>;
+    using const_iterator  = SoAIterator<const BasicSoAVector, const_reference>;
+    // 第I列的元素类型
+    template<std::size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+    // 列的个数
+    static constexpr std::size_t COLUMNS = sizeof...(Fields);
+    // 每列起始地址的对齐字节数
+    static constexpr std::size_t ALIGNMENT = 64;
+private:
+    using indices = typename MakeIndexSequence<sizeof...(Fields)>::type;
+    using swallow = int[];
+public:
+    BasicSoAVector() : n(0) {}
+    explicit BasicSoAVector(size_type count) : n(0) { resize(count); }
+    BasicSoAVector(const BasicSoAVector&) = default;
+    BasicSoAVector(BasicSoAVector&& that) noexcept : columns(std::move(that.columns)), n(that.n) { that.n = 0; }
+    BasicSoAVector& operator=(BasicSoAVector that) noexcept { swap(that); return *this; }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end()   noexcept { return iterator(this, n); }
+    const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+    const_iterator end()    const noexcept { return const_iterator(this, n); }
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cend()   const noexcept { return const_iterator(this, n); }
+
+    // 返回行数
+    size_type size() const noexcept { return n; }
+    // 返回不重新分配时可容纳的行数
+    size_type capacity() const noexcept { return capacity(indices()); }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 预留至少容纳count行的容量，不会减小容量
+    void reserve(size_type count) { reserve(count, indices()); }
+    // 收缩每列的容量到行数
+    void shrink_to_fit() { shrink_to_fit(indices()); }
+    // 改变行数，新增的行值初始化
+    void resize(size_type count) { resize(count, indices()); n = count; }
+    // 添加一行到尾部
+    void insert_back(const Fields&... values)
+    { insert_row(std::forward_as_tuple(values...), indices()); }
+    void insert_back(const value_type& row) { insert_row(row, indices()); }
+    // 移除尾部的一行
+    void remove_back();
+    // 移除所有行，保留容量
+    void clear() noexcept { clear(indices()); n = 0; }
+    // 返回第i行，带边界检查
+    reference at(size_type i);
+    const_reference at(size_type i) const;
+    // 返回第i行第I列的元素，不检查边界
+    template<std::size_t I>
+    field_type<I>& get(size_type i) noexcept { return std::get<I>(columns)[i]; }
+    template<std::size_t I>
+    const field_type<I>& get(size_type i) const noexcept { return std::get<I>(columns)[i]; }
+    // 返回第I列，起始地址按ALIGNMENT字节对齐
+    template<std::size_t I>
+    Span<field_type<I>> column() noexcept
+    { return Span<field_type<I>>(std::get<I>(columns).begin(), n); }
+    template<std::size_t I>
+    Span<const field_type<I>> column() const noexcept
+    { return Span<const field_type<I>>(std::get<I>(columns).begin(), n); }
+    // 内容与另一个SoAVector对象交换
+    void swap(BasicSoAVector& that) noexcept { columns.swap(that.columns); std::swap(n, that.n); }
+
+    // 下标运算符，不检查边界，返回由各字段引用组成的一行
+    reference operator[](size_type i) noexcept { return row(i, indices()); }
+    const_reference operator[](size_type i) const noexcept { return row(i, indices()); }
+private:
+    // 对每一列展开的实现
+    template<std::size_t... I>
+    size_type capacity(IndexSequence<I...>) const noexcept;
+    template<std::size_t... I>
+    void reserve(size_type count, IndexSequence<I...>)
+    { (void)swallow{0, (std::get<I>(columns).reserve(count), 0)...}; }
+    template<std::size_t... I>
+    void shrink_to_fit(IndexSequence<I...>)
+    { (void)swallow{0, (std::get<I>(columns).shrink_to_fit(), 0)...}; }
+    template<std::size_t... I>
+    void resize(size_type count, IndexSequence<I...>)
+    { (void)swallow{0, (std::get<I>(columns).resize(count), 0)...}; }
+    template<typename Row, std::size_t... I>
+    void insert_row(const Row& row, IndexSequence<I...>);
+    template<std::size_t... I>
+    void remove_back(IndexSequence<I...>)
+    { (void)swallow{0, (std::get<I>(columns).remove_back(), 0)...}; }
+    template<std::size_t... I>
+    void clear(IndexSequence<I...>) noexcept
+    { (void)swallow{0, (std::get<I>(columns).clear(), 0)...}; }
+    template<std::size_t... I>
+    reference row(size_type i, IndexSequence<I...>) noexcept
+    { return reference(std::get<I>(columns)[i]...); }
+    template<std::size_t... I>
+    const_reference row(size_type i, IndexSequence<I...>) const noexcept
+    { return const_reference(std::get<I>(columns)[i]...); }
+    template<std::size_t... I>
+    bool equal(const BasicSoAVector& that, IndexSequence<I...>) const;
+
+    std::tuple<Vector<Fields, Policy, ALIGNMENT>...> columns; // 每个字段一列
+    size_type n;                                              // 行数
+
+    template<typename P, typename... F>
+    friend bool operator==(const BasicSoAVector<P, F...>& lhs, const BasicSoAVector<P, F...>& rhs);
+};
+
+template<typename Policy, typename... Fields>
+constexpr std::size_t BasicSoAVector<Policy, Fields...>::COLUMNS;
+template<typename Policy, typename... Fields>
+constexpr std::size_t BasicSoAVector<Policy, Fields...>::ALIGNMENT;
+
+// 使用默认增长策略的列存储Vector
+template<typename... Fields>
+using SoAVector = BasicSoAVector<GrowthFactor<>, Fields...>;
+
+/**
+ * SoAVector的随机访问迭代器.
+ * 保存容器指针和行号，解引用时返回一行的代理对象.
+ * 代理对象是右值，不能用于std::sort等需要交换元素的算法.
+ */
+template<typename SoA, typename Ref>
+class SoAIterator
+{
+public:
+    // 成员类型定义
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename SoA::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = Ref;
+    using size_type         = std::size_t;
+    // 迭代器定义
+    using iterator          = SoAIterator<typename std::remove_const<SoA>::type,
+                                          typename std::remove_const<SoA>::type::reference>;
+public:
+    SoAIterator() noexcept : pv(nullptr), i(0) {}
+    SoAIterator(SoA* pv, size_type i) noexcept : pv(pv), i(i) {}
+    SoAIterator(const iterator& that) noexcept : pv(that.pv), i(that.i) {}
+    SoAIterator& operator=(const SoAIterator& that) noexcept = default;
+
+    reference operator*() const noexcept { return (*pv)[i]; }
+    reference operator[](difference_type k) const noexcept { return (*pv)[i + k]; }
+    SoAIterator& operator++() noexcept { ++i; return *this; }
+    SoAIterator operator++(int) noexcept { SoAIterator tmp(*this); ++i; return tmp; }
+    SoAIterator& operator--() noexcept { --i; return *this; }
+    SoAIterator operator--(int) noexcept { SoAIterator tmp(*this); --i; return tmp; }
+    SoAIterator& operator+=(difference_type k) noexcept { i += k; return *this; }
+    SoAIterator& operator-=(difference_type k) noexcept { i -= k; return *this; }
+    SoAIterator operator+(difference_type k) const noexcept { return SoAIterator(pv, i + k); }
+    SoAIterator operator-(difference_type k) const noexcept { return SoAIterator(pv, i - k); }
+    difference_type operator-(const SoAIterator& that) const noexcept
+    { return difference_type(i) - difference_type(that.i); }
+    bool operator==(const SoAIterator& that) const noexcept { return i == that.i; }
+    bool operator!=(const SoAIterator& that) const noexcept { return i != that.i; }
+    bool operator<(const SoAIterator& that) const noexcept { return i < that.i; }
+    bool operator>(const SoAIterator& that) const noexcept { return i > that.i; }
+    bool operator<=(const SoAIterator& that) const noexcept { return i <= that.i; }
+    bool operator>=(const SoAIterator& that) const noexcept { return i >= that.i; }
+    // 返回行号
+    size_type index() const noexcept { return i; }
+private:
+    SoA* pv;     // 所属的容器
+    size_type i; // 行号
+
+    template<typename S, typename R>
+    friend class SoAIterator;
+};
+
+/**
+ * 返回所有列中最小的容量.
+ * 各列的容量向上取整为各自的向量通道数，可能略有不同.
+ *
+ * @return 不重新分配时可容纳的行数
+ */
+template<typename Policy, typename... Fields>
+template<std::size_t... I>
+typename BasicSoAVector<Policy, Fields...>::size_type
+BasicSoAVector<Policy, Fields...>::capacity(IndexSequence<I...>) const noexcept
+{
+    size_type result = size_type(-1);
+    (void)swallow{0, (result = std::min(result, std::get<I>(columns).capacity()), 0)...};
+    return result;
+}
+
+/**
+ * 添加一行到尾部.
+ * 先按增长策略为所有列预留空间，再逐列添加，
+ * 字段的复制构造不抛出异常时，失败不会使各列的元素个数不一致.
+ * 字段的值可能引用对象中的元素，需要扩容时先复制整行再扩容.
+ *
+ * @param row: 各字段的值组成的tuple
+ */
+template<typename Policy, typename... Fields>
+template<typename Row, std::size_t... I>
+void BasicSoAVector<Policy, Fields...>::insert_row(const Row& row, IndexSequence<I...>)
+{
+    if (n == capacity())
+    {
+        value_type tmp(std::get<I>(row)...);
+        reserve(Policy::grow(capacity(), n + 1));
+        (void)swallow{0, (std::get<I>(columns).insert_back(std::move(std::get<I>(tmp))), 0)...};
+    }
+    else
+        (void)swallow{0, (std::get<I>(columns).insert_back(std::get<I>(row)), 0)...};
+    ++n;
+}
+
+/**
+ * 移除尾部的一行.
+ *
+ * @throws std::out_of_range: 为空
+ */
+template<typename Policy, typename... Fields>
+void BasicSoAVector<Policy, Fields...>::remove_back()
+{
+    if (n == 0)
+        throw std::out_of_range("SoAVector::remove_back() failed, vector is empty");
+    remove_back(indices());
+    --n;
+}
+
+/**
+ * 返回第i行，带边界检查.
+ *
+ * @param i: 行号
+ * @return 由各字段引用组成的一行
+ * @throws std::out_of_range: 行号越界
+ */
+template<typename Policy, typename... Fields>
+typename BasicSoAVector<Policy, Fields...>::reference BasicSoAVector<Policy, Fields...>::at(size_type i)
+{
+    if (i >= n)
+        throw std::out_of_range("SoAVector::at() index out of range");
+    return (*this)[i];
+}
+
+/**
+ * 返回第i行，带边界检查.
+ *
+ * @param i: 行号
+ * @return 由各字段const引用组成的一行
+ * @throws std::out_of_range: 行号越界
+ */
+template<typename Policy, typename... Fields>
+typename BasicSoAVector<Policy, Fields...>::const_reference
+BasicSoAVector<Policy, Fields...>::at(size_type i) const
+{
+    if (i >= n)
+        throw std::out_of_range("SoAVector::at() index out of range");
+    return (*this)[i];
+}
+
+/**
+ * 逐列比较.
+ *
+ * @param that: 行数相同的另一个SoAVector对象
+ * @return 所有列都相等返回true，否则返回false
+ */
+template<typename Policy, typename... Fields>
+template<std::size_t... I>
+bool BasicSoAVector<Policy, Fields...>::equal(const BasicSoAVector& that, IndexSequence<I...>) const
+{
+    bool result = true;
+    (void)swallow{0, (result = result && std::get<I>(columns) == std::get<I>(that.columns), 0)...};
+    return result;
+}
+
+/**
+ * 判断两个SoAVector对象是否相等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 相等返回true，否则返回false
+ */
+template<typename Policy, typename... Fields>
+bool operator==(const BasicSoAVector<Policy, Fields...>& lhs, const BasicSoAVector<Policy, Fields...>& rhs)
+{
+    return lhs.n == rhs.n && lhs.equal(rhs, typename BasicSoAVector<Policy, Fields...>::indices());
+}
+
+/**
+ * 判断两个SoAVector对象是否不等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 不等返回true，否则返回false
+ */
+template<typename Policy, typename... Fields>
+bool operator!=(const BasicSoAVector<Policy, Fields...>& lhs, const BasicSoAVector<Policy, Fields...>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * 交换两个SoAVector对象.
+ *
+ * @param lhs: 要交换的对象
+ *        rhs: 要交换的对象
+ */
+template<typename Policy, typename... Fields>
+void swap(BasicSoAVector<Policy, Fields...>& lhs, BasicSoAVector<Policy, Fields...>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace cpplib
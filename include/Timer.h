@@ -10,7 +10,7 @@
 
 /**
  * 计时器，用于测量程序运行时间.
- * 提供了产生毫秒精度时间戳的静态方法.
+ * 提供了产生毫秒精度时间戳和纳秒精度单调时间戳的静态方法.
  */
 class Timer
 {
@@ -21,6 +21,8 @@ public:
     
     // 产生毫秒精度的时间戳
     static size_t time_millis();
+    // 产生纳秒精度的单调时间戳，用于测量短操作的延迟
+    static size_t time_nanos();
     // 开始计时
     void start() { time = time_millis(); } 
     // 重新计时
@@ -41,4 +43,15 @@ size_t Timer::time_millis()
     return std::chrono::duration_cast<millis>(system_clock::now().time_since_epoch()).count();
 }
 
-
+/**
+ * 产生纳秒精度的单调时间戳.
+ * 使用steady_clock，不受系统时间调整的影响，只适合计算时间间隔.
+ *
+ * @return 纳秒精度的时间戳
+ */
+size_t Timer::time_nanos()
+{
+    using nanos = std::chrono::nanoseconds;
+    using steady_clock = std::chrono::steady_clock;
+    return std::chrono::duration_cast<nanos>(steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,650 @@
+/*******************************************************************************
+ * UnrolledList.h
+ *
+ * Author: zhangyu
+ * Date: 2026.10.16
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cpplib
+{
+
+// 展开链表结点的链接部分，哨兵结点只有链接部分，元素个数为0
+struct UnrolledNodeBase
+{
+    UnrolledNodeBase* prev;
+    UnrolledNodeBase* next;
+    std::size_t count; // 结点中的元素个数
+
+    UnrolledNodeBase() noexcept : prev(this), next(this), count(0) {}
+};
+
+// 展开链表结点，元素连续存放在未初始化的数组中，只有前count个元素被构造
+template<typename E, std::size_t Capacity>
+struct UnrolledNode : UnrolledNodeBase
+{
+    typename std::aligned_storage<sizeof(E), alignof(E)>::type storage[Capacity];
+
+    E* data() noexcept { return reinterpret_cast<E*>(storage); }
+};
+
+// 默认的结点容量，每个结点约256字节，在16到64个元素之间
+template<typename E>
+constexpr std::size_t unrolled_capacity()
+{
+    return 256 / sizeof(E) < 16 ? 16 : 256 / sizeof(E) > 64 ? 64 : 256 / sizeof(E);
+}
+
+// 展开链表的双向迭代器
+template<typename E, typename Ptr, typename Ref, std::size_t Capacity>
+class UnrolledListIterator;
+
+/**
+ * 使用模板实现的展开链表.
+ * 双向循环链表的每个结点存放最多Capacity个连续的元素，哨兵结点是链表对象的成员.
+ * 遍历时每个结点只有一次缓存缺失，结点内的元素按顺序读取；
+ * 每个元素分摊的指针开销是List的1 / Capacity.
+ * 在迭代器位置添加元素时只移动所在结点内的元素，结点满时分裂为两个半满的结点；
+ * 移除元素后结点不足半满时，从后继结点借入元素或与后继结点合并，
+ * 除最后一个结点外每个结点至少半满.
+ * 添加和移除都是O(Capacity)，但会使同一结点内及相邻结点的迭代器失效.
+ */
+template<typename E, std::size_t Capacity = unrolled_capacity<E>()>
+class UnrolledList
+{
+    static_assert(Capacity >= 2, "node capacity must be at least 2");
+public:
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    // 迭代器定义
+    using iterator               = UnrolledListIterator<E, E*, E&, Capacity>;
+    using const_iterator         = UnrolledListIterator<E, const E*, const E&, Capacity>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // 每个结点的最大元素个数
+    static constexpr size_type NODE_CAPACITY = Capacity;
+private:
+    using Node                  = UnrolledNode<E, Capacity>;
+    using node_allocator_type   = std::allocator<Node>;
+    using node_allocator_traits = typename std::allocator_traits<node_allocator_type>;
+public:
+    UnrolledList() noexcept : n(0) {}
+    UnrolledList(const UnrolledList& that);
+    UnrolledList(UnrolledList&& that) noexcept : UnrolledList() { take(that); }
+    ~UnrolledList() { clear(); }
+    UnrolledList& operator=(UnrolledList that);
+
+    iterator begin() noexcept { return iterator(sentinel.next, 0); }
+    iterator end()   noexcept { return iterator(&sentinel, 0); }
+    const_iterator begin()  const noexcept { return const_iterator(sentinel.next, 0); }
+    const_iterator end()    const noexcept { return const_iterator(&sentinel, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 返回元素的数量
+    size_type size() const noexcept { return n; }
+    // 判断是否为空
+    bool empty() const noexcept { return n == 0; }
+    // 返回可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(E); }
+
+    // 返回头部元素的const引用
+    const E& front() const;
+    // 返回尾部元素的const引用
+    const E& back() const;
+    // 返回指定位置元素的const引用，带边界检查
+    const E& at(size_type i) const;
+    // 返回头部元素的引用
+    E& front() { return const_cast<E&>(static_cast<const UnrolledList&>(*this).front()); }
+    // 返回尾部元素的引用
+    E& back() { return const_cast<E&>(static_cast<const UnrolledList&>(*this).back()); }
+    // 返回指定位置元素的引用，带边界检查
+    E& at(size_type i) { return const_cast<E&>(static_cast<const UnrolledList&>(*this).at(i)); }
+
+    // 在头部直接构造元素
+    template<typename... Args>
+    void emplace_front(Args&&... args) { emplace(cbegin(), std::forward<Args>(args)...); }
+    // 在尾部直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args) { emplace(cend(), std::forward<Args>(args)...); }
+    // 在迭代器指定的位置直接构造元素，返回指向新元素的迭代器
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    // 添加元素到迭代器指定的位置，返回指向新元素的迭代器
+    iterator insert(const_iterator pos, E elem) { return emplace(pos, std::move(elem)); }
+    // 添加元素到头部
+    void insert_front(const E& elem) { emplace_front(elem); }
+    void insert_front(E&& elem) { emplace_front(std::move(elem)); }
+    // 添加元素到尾部
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
+    // 移除迭代器指定位置的元素，返回指向下一个元素的迭代器
+    iterator remove(const_iterator pos);
+    // 移除头部元素
+    void remove_front();
+    // 移除尾部元素
+    void remove_back();
+    // 内容与另一个UnrolledList对象交换
+    void swap(UnrolledList& that) noexcept;
+    // 清空链表
+    void clear() noexcept;
+
+    UnrolledList& operator+=(const UnrolledList& that);
+private:
+    // 在pos之前创建并链接一个空结点
+    Node* create_node(UnrolledNodeBase* pos);
+    // 断开并释放一个空结点
+    void destroy_node(UnrolledNodeBase* node) noexcept;
+    // 把node中从first起的元素移动到to结点的尾部
+    static void transfer(Node* node, size_type first, size_type count, Node* to);
+    // 移动另一个链表的结点，that变为空链表
+    void take(UnrolledList& that) noexcept;
+private:
+    UnrolledNodeBase sentinel; // 哨兵结点
+    size_type n;               // 元素的数量
+    node_allocator_type allocator;
+};
+
+template<typename E, std::size_t Capacity>
+constexpr typename UnrolledList<E, Capacity>::size_type UnrolledList<E, Capacity>::NODE_CAPACITY;
+
+/**
+ * 展开链表的双向迭代器.
+ * 由结点和元素在结点中的下标组成，尾迭代器指向哨兵结点.
+ */
+template<typename E, typename Ptr, typename Ref, std::size_t Capacity>
+class UnrolledListIterator
+{
+public:
+    // 成员类型定义
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = E;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    // 迭代器定义
+    using iterator          = UnrolledListIterator<E, E*, E&, Capacity>;
+    using const_iterator    = UnrolledListIterator<E, const E*, const E&, Capacity>;
+private:
+    using node_pointer      = UnrolledNodeBase*;
+public:
+    UnrolledListIterator() noexcept : node(nullptr), index(0) {}
+    UnrolledListIterator(const UnrolledNodeBase* node, std::size_t index) noexcept
+    : node(const_cast<node_pointer>(node)), index(index) {}
+    UnrolledListIterator(const iterator& that) noexcept : node(that.node), index(that.index) {}
+    UnrolledListIterator& operator=(const UnrolledListIterator& that) noexcept = default;
+
+    reference operator*() const noexcept
+    { return static_cast<UnrolledNode<E, Capacity>*>(node)->data()[index]; }
+    pointer operator->() const noexcept
+    { return &**this; }
+    UnrolledListIterator& operator++() noexcept
+    {
+        // 到达结点尾部时跳到下一个结点的头部
+        if (++index == node->count)
+        {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+    UnrolledListIterator operator++(int) noexcept
+    {
+        UnrolledListIterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+    UnrolledListIterator& operator--() noexcept
+    {
+        if (index == 0)
+        {
+            node = node->prev;
+            index = node->count;
+        }
+        --index;
+        return *this;
+    }
+    UnrolledListIterator operator--(int) noexcept
+    {
+        UnrolledListIterator tmp(*this);
+        --*this;
+        return tmp;
+    }
+    bool operator==(const UnrolledListIterator& that) const noexcept
+    { return node == that.node && index == that.index; }
+    bool operator!=(const UnrolledListIterator& that) const noexcept
+    { return !(*this == that); }
+private:
+    node_pointer node; // 当前结点
+    std::size_t index; // 元素在结点中的下标
+
+    template<typename T, std::size_t C>
+    friend class UnrolledList;
+    friend class UnrolledListIterator<E, E*, E&, Capacity>;
+    friend class UnrolledListIterator<E, const E*, const E&, Capacity>;
+};
+
+/**
+ * 复制构造函数.
+ * 按顺序添加到尾部，除最后一个结点外每个结点都是满的.
+ *
+ * @param that: 被复制的链表
+ */
+template<typename E, std::size_t Capacity>
+UnrolledList<E, Capacity>::UnrolledList(const UnrolledList& that) : UnrolledList()
+{
+    // 委托构造已经完成，复制抛出异常时析构函数会释放已复制的结点
+    for (auto& elem : that)
+        insert_back(elem);
+}
+
+/**
+ * 移动另一个链表的所有结点到这个空链表，that变为空链表.
+ *
+ * @param that: 被移动的链表
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::take(UnrolledList& that) noexcept
+{
+    if (that.empty())
+        return;
+    sentinel.next = that.sentinel.next;
+    sentinel.prev = that.sentinel.prev;
+    sentinel.next->prev = &sentinel;
+    sentinel.prev->next = &sentinel;
+    n = that.n;
+    that.sentinel.next = that.sentinel.prev = &that.sentinel;
+    that.n = 0;
+}
+
+/**
+ * 在pos之前创建并链接一个空结点.
+ *
+ * @param pos: 链接位置的后继结点
+ * @return 新结点
+ */
+template<typename E, std::size_t Capacity>
+typename UnrolledList<E, Capacity>::Node* UnrolledList<E, Capacity>::create_node(UnrolledNodeBase* pos)
+{
+    Node* node = node_allocator_traits::allocate(allocator, 1);
+    ::new(static_cast<void*>(node)) Node;
+    UnrolledNodeBase* prec = pos->prev;
+    prec->next = node;
+    node->prev = prec;
+    node->next = pos;
+    pos->prev = node;
+    return node;
+}
+
+/**
+ * 断开并释放一个空结点.
+ *
+ * @param node: 要释放的结点，元素已经析构
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::destroy_node(UnrolledNodeBase* node) noexcept
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node_allocator_traits::deallocate(allocator, static_cast<Node*>(node), 1);
+}
+
+/**
+ * 把node中从first起的count个元素移动到to结点的尾部，node中之后的元素前移.
+ *
+ * @param node: 源结点
+ *        first: 第一个移动的元素的下标
+ *        count: 移动的元素个数
+ *        to: 目标结点，剩余容量不小于count
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::transfer(Node* node, size_type first, size_type count, Node* to)
+{
+    E* src = node->data();
+    E* dst = to->data() + to->count;
+    for (size_type i = 0; i < count; ++i)
+        ::new(static_cast<void*>(dst + i)) E(std::move(src[first + i]));
+    to->count += count;
+    std::move(src + first + count, src + node->count, src + first);
+    for (size_type i = node->count - count; i < node->count; ++i)
+        src[i].~E();
+    node->count -= count;
+}
+
+/**
+ * 在迭代器指定的位置直接构造元素.
+ * 位置为尾迭代器时添加到最后一个结点，最后一个结点满时创建新结点；
+ * 所在结点满时把后一半元素移动到新的后继结点，再添加到相应的一半中.
+ * 先构造临时元素再移动结点内的元素，参数可以引用链表中的元素.
+ *
+ * @param pos: 要添加元素的位置
+ *        args: 用于构造元素的参数
+ * @return 指向新元素的迭代器
+ */
+template<typename E, std::size_t Capacity>
+template<typename... Args>
+typename UnrolledList<E, Capacity>::iterator
+UnrolledList<E, Capacity>::emplace(const_iterator pos, Args&&... args)
+{
+    E elem(std::forward<Args>(args)...);
+    UnrolledNodeBase* base = pos.node;
+    size_type i = pos.index;
+    if (base == &sentinel)
+    {
+        base = sentinel.prev;
+        i = base->count;
+        if (base == &sentinel || i == Capacity)
+        {
+            base = create_node(&sentinel);
+            i = 0;
+        }
+    }
+    else if (base->count == Capacity)
+    {
+        Node* right = create_node(base->next);
+        transfer(static_cast<Node*>(base), Capacity / 2, Capacity - Capacity / 2, right);
+        if (i > Capacity / 2)
+        {
+            base = right;
+            i -= Capacity / 2;
+        }
+    }
+
+    Node* node = static_cast<Node*>(base);
+    E* data = node->data();
+    if (i == node->count)
+    {
+        ::new(static_cast<void*>(data + i)) E(std::move(elem));
+    }
+    else
+    {
+        ::new(static_cast<void*>(data + node->count)) E(std::move(data[node->count - 1]));
+        std::move_backward(data + i, data + node->count - 1, data + node->count);
+        data[i] = std::move(elem);
+    }
+    ++node->count;
+    ++n;
+    return iterator(node, i);
+}
+
+/**
+ * 移除迭代器指定位置的元素.
+ * 结点变空时释放结点；不足半满时从后继结点借入元素补到半满，
+ * 两个结点的元素合起来不超过Capacity时合并为一个结点.
+ *
+ * @param pos: 要移除元素的位置
+ * @return 指向下一个元素的迭代器
+ * @throws std::out_of_range: 位置为尾迭代器
+ */
+template<typename E, std::size_t Capacity>
+typename UnrolledList<E, Capacity>::iterator UnrolledList<E, Capacity>::remove(const_iterator pos)
+{
+    if (pos.node == &sentinel)
+        throw std::out_of_range("UnrolledList::remove");
+    Node* node = static_cast<Node*>(pos.node);
+    size_type i = pos.index;
+    E* data = node->data();
+    std::move(data + i + 1, data + node->count, data + i);
+    data[--node->count].~E();
+    --n;
+
+    UnrolledNodeBase* next = node->next;
+    if (node->count == 0)
+    {
+        destroy_node(node);
+        return iterator(next, 0);
+    }
+    if (node->count < Capacity / 2 && next != &sentinel)
+    {
+        size_type count = node->count + next->count <= Capacity
+                          ? next->count : Capacity / 2 - node->count;
+        transfer(static_cast<Node*>(next), 0, count, node);
+        if (next->count == 0)
+            destroy_node(next);
+    }
+    return i < node->count ? iterator(node, i) : iterator(node->next, 0);
+}
+
+/**
+ * 移除头部元素.
+ *
+ * @throws std::out_of_range: 链表为空
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::remove_front()
+{
+    if (empty())
+        throw std::out_of_range("UnrolledList::remove_front");
+    remove(cbegin());
+}
+
+/**
+ * 移除尾部元素.
+ *
+ * @throws std::out_of_range: 链表为空
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::remove_back()
+{
+    if (empty())
+        throw std::out_of_range("UnrolledList::remove_back");
+    remove(std::prev(cend()));
+}
+
+/**
+ * 返回头部元素的const引用.
+ *
+ * @return 头部元素的const引用
+ * @throws std::out_of_range: 链表为空
+ */
+template<typename E, std::size_t Capacity>
+const E& UnrolledList<E, Capacity>::front() const
+{
+    if (empty())
+        throw std::out_of_range("UnrolledList::front");
+    return *begin();
+}
+
+/**
+ * 返回尾部元素的const引用.
+ *
+ * @return 尾部元素的const引用
+ * @throws std::out_of_range: 链表为空
+ */
+template<typename E, std::size_t Capacity>
+const E& UnrolledList<E, Capacity>::back() const
+{
+    if (empty())
+        throw std::out_of_range("UnrolledList::back");
+    return *std::prev(end());
+}
+
+/**
+ * 返回指定位置元素的const引用，并进行越界检查.
+ * 从较近的一端按结点跳过，只在目标结点内按下标访问.
+ *
+ * @param i: 指定元素的索引
+ * @return 指定位置元素的const引用
+ * @throws std::out_of_range: 索引不合法
+ */
+template<typename E, std::size_t Capacity>
+const E& UnrolledList<E, Capacity>::at(size_type i) const
+{
+    if (i >= n)
+        throw std::out_of_range("UnrolledList::at");
+    const UnrolledNodeBase* node;
+    if (i < n / 2)
+    {
+        node = sentinel.next;
+        for (; i >= node->count; node = node->next)
+            i -= node->count;
+    }
+    else
+    {
+        // 从尾部计算，i变为元素之后的元素个数
+        i = n - 1 - i;
+        node = sentinel.prev;
+        for (; i >= node->count; node = node->prev)
+            i -= node->count;
+        i = node->count - 1 - i;
+    }
+    return *const_iterator(node, i);
+}
+
+/**
+ * 交换当前对象和另一个对象.
+ *
+ * @param that: 要交换的对象
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::swap(UnrolledList& that) noexcept
+{
+    UnrolledList tmp;
+    tmp.take(that);
+    that.take(*this);
+    take(tmp);
+}
+
+/**
+ * 清空链表，析构所有元素并释放所有结点.
+ */
+template<typename E, std::size_t Capacity>
+void UnrolledList<E, Capacity>::clear() noexcept
+{
+    UnrolledNodeBase* current = sentinel.next;
+    while (current != &sentinel)
+    {
+        UnrolledNodeBase* next = current->next;
+        Node* node = static_cast<Node*>(current);
+        for (size_type i = 0; i < node->count; ++i)
+            node->data()[i].~E();
+        node_allocator_traits::deallocate(allocator, node, 1);
+        current = next;
+    }
+    sentinel.next = sentinel.prev = &sentinel;
+    n = 0;
+}
+
+/**
+ * 赋值运算符.
+ *
+ * @param that: 要复制或移动的对象
+ * @return 当前对象
+ */
+template<typename E, std::size_t Capacity>
+UnrolledList<E, Capacity>& UnrolledList<E, Capacity>::operator=(UnrolledList that)
+{
+    clear();
+    take(that);
+    return *this;
+}
+
+/**
+ * 复制另一个对象的所有元素，添加到当前对象的尾部.
+ *
+ * @param that: 要复制的对象
+ * @return 当前对象
+ */
+template<typename E, std::size_t Capacity>
+UnrolledList<E, Capacity>& UnrolledList<E, Capacity>::operator+=(const UnrolledList& that)
+{
+    // that与当前对象相同时，只复制原有的元素
+    size_type count = that.size();
+    auto it = that.begin();
+    for (size_type i = 0; i < count; ++i, ++it)
+        insert_back(*it);
+    return *this;
+}
+
+/**
+ * 返回一个包含lhs和rhs所有元素的对象.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 包含lhs和rhs所有元素的对象
+ */
+template<typename E, std::size_t Capacity>
+UnrolledList<E, Capacity> operator+(UnrolledList<E, Capacity> lhs, const UnrolledList<E, Capacity>& rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+/**
+ * 判断两个UnrolledList对象是否相等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 相等返回true，否则返回false
+ */
+template<typename E, std::size_t Capacity>
+bool operator==(const UnrolledList<E, Capacity>& lhs, const UnrolledList<E, Capacity>& rhs)
+{
+    if (&lhs == &rhs)             return true;
+    if (lhs.size() != rhs.size()) return false;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * 判断两个UnrolledList对象是否不等.
+ *
+ * @param lhs: 左操作数
+ *        rhs: 右操作数
+ * @return 不等返回true，否则返回false
+ */
+template<typename E, std::size_t Capacity>
+bool operator!=(const UnrolledList<E, Capacity>& lhs, const UnrolledList<E, Capacity>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * 输出所有元素.
+ *
+ * @param os: 输出流
+ *        list: 要输出的链表
+ * @return 输出流
+ */
+template<typename E, std::size_t Capacity>
+std::ostream& operator<<(std::ostream& os, const UnrolledList<E, Capacity>& list)
+{
+    for (auto& i : list)
+        os << i << " ";
+    return os;
+}
+
+/**
+ * 交换两个UnrolledList对象.
+ *
+ * @param lhs: 要交换的对象
+ *        rhs: 要交换的对象
+ */
+template<typename E, std::size_t Capacity>
+void swap(UnrolledList<E, Capacity>& lhs, UnrolledList<E, Capacity>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace cpplib
@@ -6,56 +6,187 @@
  ******************************************************************************/
 
 #pragma once
-#include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "Simd.h"
+
+namespace cpplib
+{
+
+/**
+ * 判断元素类型是否可以平凡重定位.
+ * 可以平凡重定位的对象，移动构造到新地址再析构原对象，等价于按字节复制到新地址并丢弃原对象，
+ * Vector扩容时可以用realloc或mremap整体搬移，不需要逐个移动构造和析构.
+ * 平凡可复制的类型总是可以平凡重定位；只持有堆指针、不含指向自身的指针的类型
+ * 可以特化为std::true_type启用这个路径.
+ */
+template<typename E>
+struct is_trivially_relocatable : std::is_trivially_copyable<E> {};
+
+/**
+ * 按比例扩容和收缩的增长策略.
+ * 容量不足时扩容到原来的Numerator / Denominator倍，且不小于MinCapacity；
+ * 元素个数不超过容量的1 / ShrinkDivisor时收缩到一半容量，但不小于MinCapacity.
+ * 扩容后元素约占容量的Denominator / Numerator，收缩后约占2 / ShrinkDivisor，
+ * 两者相差越大，元素个数在边界附近来回变化时越不容易反复重新分配.
+ * ShrinkDivisor为0时从不自动收缩.
+ */
+template<std::size_t Numerator = 2, std::size_t Denominator = 1,
+         std::size_t MinCapacity = 10, std::size_t ShrinkDivisor = 4>
+struct GrowthFactor
+{
+    static_assert(Denominator > 0 && Numerator > Denominator, "growth factor must be greater than 1");
+    static_assert(ShrinkDivisor == 0 || ShrinkDivisor > 2, "shrink divisor must be 0 or greater than 2");
+
+    // 最小容量，也是默认构造的容量
+    static constexpr std::size_t min_capacity = MinCapacity;
+    // 容量不足时的新容量，至少容纳required个元素
+    static constexpr std::size_t grow(std::size_t capacity, std::size_t required)
+    {
+        return max(max(capacity * Numerator / Denominator, capacity + 1),
+                   max(required, MinCapacity));
+    }
+    // 移除元素后的新容量，不收缩时返回原容量
+    static constexpr std::size_t shrink(std::size_t size, std::size_t capacity)
+    {
+        return ShrinkDivisor != 0 && size <= capacity / ShrinkDivisor && capacity / 2 >= MinCapacity
+               ? capacity / 2 : capacity;
+    }
+private:
+    static constexpr std::size_t max(std::size_t a, std::size_t b) { return a < b ? b : a; }
+};
+
+template<std::size_t Numerator, std::size_t Denominator, std::size_t MinCapacity, std::size_t ShrinkDivisor>
+constexpr std::size_t GrowthFactor<Numerator, Denominator, MinCapacity, ShrinkDivisor>::min_capacity;
+
+// 从不自动收缩的增长策略，容量只在shrink_to_fit时减小
+using NeverShrink = GrowthFactor<2, 1, 10, 0>;
 
 /**
  * 使用模板实现的Vector.
  * 由动态连续数组存储Vector.
- * 实现了Vector的随机访问迭代器.
+ * 数组是未初始化的原始空间，只有[0, n)范围内的元素被构造，
+ * 剩余的容量不构造元素，也不会被访问.
+ * 扩容和收缩的时机由增长策略Policy在编译期确定.
+ * 数组的起始地址按Alignment字节对齐，容量向上取整为整数个向量通道，
+ * 向量化的代码可以使用对齐的加载和存储指令，处理到容量末尾也不会越界.
  */
-template<typename E>
+template<typename E, typename Policy = GrowthFactor<>, std::size_t Alignment = alignof(E)>
 class Vector
 {
-    static const int DEFAULT_CAPACITY = 10; // 默认的Vector容量
-
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "alignment must be a power of 2");
+    static_assert(Alignment <= 4096, "alignment must not exceed the page size");
+public:
+    // 成员类型定义
+    using value_type      = E;
+    using pointer         = E*;
+    using reference       = E&;
+    using const_pointer   = const E*;
+    using const_reference = const E&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = std::allocator<E>;
+    using growth_policy   = Policy;
     // 原生指针具备随机访问迭代器的一切特征
-    using iterator = E*;
-    using const_iterator = const E* ;
+    using iterator               = E*;
+    using const_iterator         = const E*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // 元素空间起始地址的对齐字节数
+    static constexpr std::size_t ALIGNMENT = Alignment > alignof(E) ? Alignment : alignof(E);
+    // 一个对齐单位可容纳的元素个数，容量总是它的整数倍
+    static constexpr size_type LANES = ALIGNMENT % sizeof(E) == 0 ? ALIGNMENT / sizeof(E) : 1;
 private:
-    int n; // Vector大小
-    int N; // Vector容量
-    E* pv; // Vector指针
+    using allocator_traits = typename std::allocator_traits<allocator_type>;
+    // 扩容时元素的移动方式，移动构造可能抛出异常且可以复制时使用复制，保证强异常安全
+    using relocate_iterator = typename std::conditional<
+            std::is_nothrow_move_constructible<E>::value || !std::is_copy_constructible<E>::value,
+            std::move_iterator<E*>, const E*>::type;
+    // 元素可以平凡重定位时，扩容按字节整体搬移，使用realloc或mremap
+    using is_relocatable = std::integral_constant<bool, is_trivially_relocatable<E>::value>;
+    // 对齐要求超过malloc的保证，不能使用realloc
+    using is_over_aligned = std::integral_constant<bool, (ALIGNMENT > alignof(std::max_align_t))>;
+    // 空间由malloc或mmap管理，否则由allocator管理
+    using is_raw_storage = std::integral_constant<bool,
+            is_relocatable::value || is_over_aligned::value>;
 
-    // 调整Vector容量
-    void reserve(int count);
-    // 检查索引是否合法
-    bool valid(int i) const { return i >= 0 && i < n; }
+    static constexpr size_type DEFAULT_CAPACITY = Policy::min_capacity; // 默认的Vector容量
+    static constexpr std::size_t MMAP_THRESHOLD = std::size_t(1) << 25; // 直接映射空间的最小字节数
 public:
-    explicit Vector(int count = DEFAULT_CAPACITY);
+    explicit Vector(size_type count = DEFAULT_CAPACITY);
     Vector(const Vector& that);
     Vector(Vector&& that) noexcept;
-    ~Vector() { delete[] pv; }
+    ~Vector();
+    allocator_type get_allocator() const noexcept { return allocator_type(); }
+
+    iterator begin() noexcept { return pv; }
+    iterator end()   noexcept { return pv + n; }
+    const_iterator begin()  const noexcept { return pv; }
+    const_iterator end()    const noexcept { return pv + n; }
+    const_iterator cbegin() const noexcept { return pv; }
+    const_iterator cend()   const noexcept { return pv + n; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
 
     // 返回Vector元素的数量
-    int size() const { return n; }
+    size_type size() const noexcept { return n; }
     // 返回Vector容量
-    int capacity() const { return N; }
+    size_type capacity() const noexcept { return N; }
+    // 返回Vector可容纳的最大元素数量
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(E); }
     // 判断是否为空Vector
-    bool empty() const { return n == 0; }
+    bool empty() const noexcept { return n == 0; }
+    // 预留至少容纳count个元素的容量，不会减小容量
+    void reserve(size_type count) { if (count > N) reallocate(count); }
+    // 收缩Vector，移除过剩容量
+    void shrink_to_fit() { if (n < N) reallocate(n); }
+    // 改变元素的数量，新增的元素值初始化
+    void resize(size_type count);
+    // 改变元素的数量，新增的元素复制value
+    void resize(size_type count, const E& value);
+    // 在Vector尾部直接构造元素
+    template<typename... Args>
+    void emplace_back(Args&&... args);
     // 添加元素到指定位置
-    void insert(iterator pos, E elem);
+    void insert(const_iterator pos, E elem);
+    // 添加迭代器范围内的元素到指定位置，返回指向第一个添加的元素的迭代器
+    template<typename InputIt,
+             typename Category = typename std::iterator_traits<InputIt>::iterator_category>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    { return insert(pos, first, last, Category()); }
+    // 添加迭代器范围内的元素到Vector尾部，范围不能是当前Vector的元素
+    template<typename InputIt,
+             typename Category = typename std::iterator_traits<InputIt>::iterator_category>
+    void append(InputIt first, InputIt last) { append(first, last, Category()); }
     // 添加元素到Vector尾部
-    void insert_back(E elem);
+    void insert_back(const E& elem) { emplace_back(elem); }
+    void insert_back(E&& elem) { emplace_back(std::move(elem)); }
     // 移除指定位置的元素
-    void remove(iterator pos);
+    void remove(const_iterator pos);
     // 移除Vector尾部元素
     void remove_back();
     // 返回指定位置元素的引用，带边界检查
-    E& at(int i) { return const_cast<E&>(static_cast<const Vector&>(*this).at(i)); }
+    E& at(size_type i) { return const_cast<E&>(static_cast<const Vector&>(*this).at(i)); }
     // 返回指定位置元素的const引用，带边界检查
-    const E& at(int i) const;
+    const E& at(size_type i) const;
     // 返回Vector头部元素的引用
     E& front() { return const_cast<E&>(static_cast<const Vector&>(*this).front()); }
     // 返回Vector头部元素的const引用
@@ -64,44 +195,122 @@ public:
     E& back() { return const_cast<E&>(static_cast<const Vector&>(*this).back()); }
     // 返回Vector尾部元素的const引用
     const E& back() const;
+    // 查找第一个等于value的元素，没有时返回end()
+    iterator find(const E& value) { return pv + simd::find(cbegin(), n, value); }
+    const_iterator find(const E& value) const { return pv + simd::find(cbegin(), n, value); }
+    // 统计等于value的元素个数
+    size_type count(const E& value) const { return simd::count(cbegin(), n, value); }
+    // 返回最小的元素
+    E min() const;
+    // 返回最大的元素
+    E max() const;
+    // 返回所有元素的和，整数扩展到64位累加
+    typename simd::sum_type<E>::type sum() const { return simd::sum(cbegin(), n); }
     // 内容与另一个Vector对象交换
-    void swap(Vector& that);
+    void swap(Vector& that) noexcept;
     // 清空Vector，不释放空间，Vector容量不变
-    void clear() { n = 0; }
+    void clear() noexcept { destroy(pv, pv + n); n = 0; }
 
     // 返回指定位置元素的引用，无边界检查
-    E& operator[](int i) { return const_cast<E&>(static_cast<const Vector&>(*this)[i]); }
+    E& operator[](size_type i) { return pv[i]; }
     // 返回指定位置元素的const引用，无边界检查
-    const E& operator[](int i) const;
+    const E& operator[](size_type i) const { return pv[i]; }
     Vector& operator=(Vector that);
     Vector& operator+=(const Vector& that);
-    template<typename T>
-    friend Vector<T> operator+(Vector<T> lhs, const Vector<T>& rhs);
-    template <typename T>
-    friend bool operator==(const Vector<T>& lhs, const Vector<T>& rhs);
-    template <typename T>
-    friend bool operator!=(const Vector<T>& lhs, const Vector<T>& rhs);
-    template<typename T>
-    friend std::ostream& operator<<(std::ostream& os, const Vector<T>& vector);
-
-    iterator begin() { return pv; }
-    iterator end() { return pv + n; }
-    const_iterator begin() const { return pv; }
-    const_iterator end() const { return pv + n; }
+    Vector& operator+=(Vector&& that);
+    template<typename T, typename P, std::size_t A>
+    friend bool operator==(const Vector<T, P, A>& lhs, const Vector<T, P, A>& rhs);
+    template<typename T, typename P, std::size_t A>
+    friend bool operator!=(const Vector<T, P, A>& lhs, const Vector<T, P, A>& rhs);
+    template<typename T, typename P, std::size_t A>
+    friend std::ostream& operator<<(std::ostream& os, const Vector<T, P, A>& vector);
+private:
+    // 调整Vector容量，只移动已构造的元素
+    void reallocate(size_type count) { reallocate(count, is_relocatable()); }
+    void reallocate(size_type count, std::false_type);
+    void reallocate(size_type count, std::true_type);
+    // 按增长策略扩容后的Vector容量，至少容纳required个元素
+    size_type grow_capacity(size_type required) const noexcept
+    { return pad(Policy::grow(N, required)); }
+    // 移除元素后按增长策略收缩Vector
+    void shrink()
+    {
+        size_type count = Policy::shrink(n, N);
+        if (count < N)
+            reallocate(count);
+    }
+    // 扩容并在新空间的尾部构造元素
+    template<typename... Args>
+    void emplace_back_grow(std::false_type, Args&&... args);
+    template<typename... Args>
+    void emplace_back_grow(std::true_type, Args&&... args);
+    // 容量向上取整为LANES的整数倍
+    static size_type pad(size_type count) noexcept
+    {
+        return count % LANES == 0 || count > size_type(-1) - LANES
+               ? count : count + (LANES - count % LANES);
+    }
+    // 分配容纳count个元素的未初始化空间
+    pointer allocate(size_type count) { return allocate(count, is_raw_storage()); }
+    pointer allocate(size_type count, std::false_type)
+    { return count > 0 ? allocator_traits::allocate(allocator, count) : nullptr; }
+    pointer allocate(size_type count, std::true_type);
+    // 释放容纳count个元素的空间
+    void deallocate(pointer p, size_type count) noexcept { deallocate(p, count, is_raw_storage()); }
+    void deallocate(pointer p, size_type count, std::false_type) noexcept
+    { if (p != nullptr) allocator_traits::deallocate(allocator, p, count); }
+    void deallocate(pointer p, size_type count, std::true_type) noexcept;
+    // 判断容纳count个元素的空间是否由mmap直接映射
+    static bool is_mapped(size_type count) noexcept;
+    // 容纳count个元素的映射空间按页大小向上取整的字节数
+    static std::size_t mapped_bytes(size_type count) noexcept;
+    // 分配按ALIGNMENT对齐的bytes字节空间，原始地址保存在对齐地址之前
+    static void* aligned_malloc(std::size_t bytes) noexcept;
+    // 释放aligned_malloc分配的空间
+    static void aligned_free(void* p) noexcept;
+    // 析构迭代器范围内的元素
+    void destroy(pointer first, pointer last) noexcept;
+    // 按迭代器类别添加范围内的元素，前向迭代器可以预先求出元素个数，只扩容一次
+    template<typename InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last, std::input_iterator_tag);
+    template<typename ForwardIt>
+    iterator insert(const_iterator pos, ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+    template<typename InputIt>
+    void append(InputIt first, InputIt last, std::input_iterator_tag);
+    template<typename ForwardIt>
+    void append(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+    // 检查索引是否合法
+    bool valid(size_type i) const noexcept { return i < n; }
+private:
+    size_type n;  // Vector大小
+    size_type N;  // Vector容量
+    E* pv;  // Vector指针
+    allocator_type allocator;
 };
 
+template<typename E, typename Policy, std::size_t Alignment>
+constexpr typename Vector<E, Policy, Alignment>::size_type Vector<E, Policy, Alignment>::DEFAULT_CAPACITY;
+template<typename E, typename Policy, std::size_t Alignment>
+constexpr std::size_t Vector<E, Policy, Alignment>::MMAP_THRESHOLD;
+template<typename E, typename Policy, std::size_t Alignment>
+constexpr std::size_t Vector<E, Policy, Alignment>::ALIGNMENT;
+template<typename E, typename Policy, std::size_t Alignment>
+constexpr typename Vector<E, Policy, Alignment>::size_type Vector<E, Policy, Alignment>::LANES;
+
+// 起始地址按Alignment字节对齐的Vector，默认对齐到64字节的缓存行
+template<typename E, std::size_t Alignment = 64, typename Policy = GrowthFactor<>>
+using AlignedVector = Vector<E, Policy, Alignment>;
+
 /**
  * Vector构造函数，初始化Vector.
- * Vector默认初始容量为10.
+ * 只分配容量，不构造元素，Vector默认初始容量为10，按LANES向上取整.
  *
  * @param count: 指定Vector容量
  */
-template<typename E>
-Vector<E>::Vector(int count)
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>::Vector(size_type count) : n(0), N(pad(count)), pv(nullptr)
 {
-    n = 0;
-    N = count;
-    pv = new E[N]();
+    pv = allocate(N);
 }
 
 /**
@@ -110,13 +319,12 @@ Vector<E>::Vector(int count)
  *
  * @param that: 被复制的Vector
  */
-template<typename E>
-Vector<E>::Vector(const Vector& that)
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>::Vector(const Vector& that) : Vector(that.N)
 {
+    // 委托构造已经完成，复制抛出异常时析构函数会释放空间
+    std::uninitialized_copy(that.begin(), that.end(), pv);
     n = that.n;
-    N = that.N;
-    pv = new E[N];
-    std::copy(that.begin(), that.end(), begin());
 }
 
 /**
@@ -125,110 +333,532 @@ Vector<E>::Vector(const Vector& that)
  *
  * @param that: 被移动的Vector
  */
-template<typename E>
-Vector<E>::Vector(Vector&& that) noexcept
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>::Vector(Vector&& that) noexcept : n(that.n), N(that.N), pv(that.pv)
 {
-    n = that.n;
-    N = that.N;
-    pv = that.pv;
     that.pv = nullptr; // 指向空指针，退出被析构
+    that.n = 0;
+    that.N = 0;
+}
+
+/**
+ * Vector析构函数.
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>::~Vector()
+{
+    if (pv == nullptr)
+        return;
+    destroy(pv, pv + n);
+    deallocate(pv, N);
 }
 
 /**
- * 创建指定容量的新Vector，并移动所有元素到新Vector当中.
+ * 分配指定容量的新空间，并移动所有元素到新空间当中.
+ * 新空间只构造n个元素，剩余的容量保持未初始化.
  *
- * @param size: 新Vector容量
+ * @param count: 新Vector容量，按LANES向上取整
+ * @throws std::length_error: 容量超过max_size()
  */
-template<typename E>
-void Vector<E>::reserve(int count)
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::reallocate(size_type count, std::false_type)
 {
     // 保证新的容量不小于Vector元素的数量
-    assert(count >= size());
+    if (count < n)
+        count = n;
+    if (count > max_size())
+        throw std::length_error("Vector::reserve");
+    count = pad(count);
+    if (count == N)
+        return;
+    pointer p = allocate(count);
+    try
+    {
+        std::uninitialized_copy(relocate_iterator(begin()), relocate_iterator(end()), p);
+    }
+    catch (...)
+    {
+        deallocate(p, count);
+        throw;
+    }
+    destroy(pv, pv + n);
+    deallocate(pv, N);
+    pv = p;
+    N = count;
+}
+
+/**
+ * 调整可以平凡重定位的元素的空间容量.
+ * 元素按字节整体搬移，不调用移动构造和析构：
+ * 普通空间使用realloc，可以原地扩展；映射空间使用mremap，只移动页表项而不复制数据；
+ * realloc不保证超过malloc的对齐，此时和在普通空间与映射空间之间转换时一样，分配新空间并复制一次.
+ *
+ * @param count: 新Vector容量，按LANES向上取整
+ * @throws std::length_error: 容量超过max_size()
+ *         std::bad_alloc: 内存不足，此时Vector保持不变
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::reallocate(size_type count, std::true_type)
+{
+    if (count < n)
+        count = n;
+    if (count > max_size())
+        throw std::length_error("Vector::reserve");
+    count = pad(count);
+    if (count == N)
+        return;
+
+    pointer p = nullptr;
+    if (pv == nullptr || count == 0)
+    {
+        // 容量为0时Vector为空，没有需要搬移的元素
+        p = allocate(count);
+        deallocate(pv, N);
+    }
+    else if (!is_over_aligned::value && !is_mapped(N) && !is_mapped(count))
+    {
+        p = static_cast<pointer>(std::realloc(static_cast<void*>(pv), count * sizeof(E)));
+        if (p == nullptr)
+            throw std::bad_alloc();
+    }
+#if defined(__linux__)
+    else if (is_mapped(N) && is_mapped(count))
+    {
+        void* q = mremap(static_cast<void*>(pv), mapped_bytes(N), mapped_bytes(count), MREMAP_MAYMOVE);
+        if (q == MAP_FAILED)
+            throw std::bad_alloc();
+        p = static_cast<pointer>(q);
+    }
+#endif
+    else
+    {
+        p = allocate(count);
+        std::memcpy(static_cast<void*>(p), static_cast<const void*>(pv), n * sizeof(E));
+        deallocate(pv, N);
+    }
+    pv = p;
+    N = count;
+}
+
+/**
+ * 分配由malloc或mmap管理的未初始化空间.
+ * 达到映射阈值的空间由mmap直接映射，按页对齐；其余空间由malloc分配，
+ * 对齐要求超过malloc的保证时多分配ALIGNMENT字节再调整起始地址.
+ *
+ * @param count: 元素个数
+ * @return 分配的空间，count为0时返回空指针
+ * @throws std::length_error: 元素个数超过max_size()
+ *         std::bad_alloc: 内存不足
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+typename Vector<E, Policy, Alignment>::pointer Vector<E, Policy, Alignment>::allocate(size_type count, std::true_type)
+{
+    if (count == 0)
+        return nullptr;
+    if (count > max_size())
+        throw std::length_error("Vector::allocate");
+    void* p = nullptr;
+#if defined(__linux__)
+    if (is_mapped(count))
+    {
+        p = mmap(nullptr, mapped_bytes(count), PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        return static_cast<pointer>(p);
+    }
+#endif
+    p = is_over_aligned::value ? aligned_malloc(count * sizeof(E)) : std::malloc(count * sizeof(E));
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return static_cast<pointer>(p);
+}
+
+/**
+ * 释放由malloc或mmap管理的空间.
+ *
+ * @param p: 要释放的空间
+ *        count: 空间可容纳的元素个数
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::deallocate(pointer p, size_type count, std::true_type) noexcept
+{
+    if (p == nullptr)
+        return;
+#if defined(__linux__)
+    if (is_mapped(count))
+    {
+        munmap(static_cast<void*>(p), mapped_bytes(count));
+        return;
+    }
+#endif
+    if (is_over_aligned::value)
+        aligned_free(static_cast<void*>(p));
+    else
+        std::free(static_cast<void*>(p));
+}
+
+/**
+ * 判断容纳count个元素的空间是否由mmap直接映射.
+ * 只有由malloc或mmap管理的空间在Linux上使用映射空间.
+ *
+ * @param count: 元素个数
+ * @return true: 映射空间
+ *         false: 普通空间
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+bool Vector<E, Policy, Alignment>::is_mapped(size_type count) noexcept
+{
+#if defined(__linux__)
+    return is_raw_storage::value && count * sizeof(E) >= MMAP_THRESHOLD;
+#else
+    (void)count;
+    return false;
+#endif
+}
+
+/**
+ * 返回容纳count个元素的映射空间的字节数，按页大小向上取整.
+ *
+ * @param count: 元素个数
+ * @return 映射空间的字节数
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+std::size_t Vector<E, Policy, Alignment>::mapped_bytes(size_type count) noexcept
+{
+    std::size_t bytes = count * sizeof(E);
+#if defined(__linux__)
+    std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+    bytes = (bytes + page - 1) / page * page;
+#endif
+    return bytes;
+}
+
+/**
+ * 分配按ALIGNMENT对齐的空间.
+ * 多分配ALIGNMENT字节，把起始地址向上调整到对齐边界，并在对齐地址之前保存malloc返回的地址.
+ * 只在ALIGNMENT超过malloc的对齐时使用，调整的距离至少为alignof(std::max_align_t)，足以保存一个指针.
+ *
+ * @param bytes: 字节数
+ * @return 对齐的空间，内存不足时返回空指针
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+void* Vector<E, Policy, Alignment>::aligned_malloc(std::size_t bytes) noexcept
+{
+    if (bytes > std::size_t(-1) - ALIGNMENT)
+        return nullptr;
+    void* raw = std::malloc(bytes + ALIGNMENT);
+    if (raw == nullptr)
+        return nullptr;
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+    address = (address + ALIGNMENT) & ~std::uintptr_t(ALIGNMENT - 1);
+    void* p = reinterpret_cast<void*>(address);
+    static_cast<void**>(p)[-1] = raw;
+    return p;
+}
+
+/**
+ * 释放aligned_malloc分配的空间.
+ *
+ * @param p: aligned_malloc返回的地址
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::aligned_free(void* p) noexcept
+{
+    std::free(static_cast<void**>(p)[-1]);
+}
+
+/**
+ * 改变Vector元素的数量.
+ * 元素数量增加时，新增的元素值初始化；减少时，析构多余的元素.
+ *
+ * @param count: 新的元素数量
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::resize(size_type count)
+{
+    if (count < n)
+    {
+        destroy(pv + count, pv + n);
+        n = count;
+        return;
+    }
+    if (count > N)
+        reallocate(grow_capacity(count));
+    for (; n < count; ++n)
+        allocator_traits::construct(allocator, pv + n);
+}
+
+/**
+ * 改变Vector元素的数量.
+ * 元素数量增加时，新增的元素复制value；减少时，析构多余的元素.
+ *
+ * @param count: 新的元素数量
+ *        value: 新增元素的值
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::resize(size_type count, const E& value)
+{
+    if (count < n)
+    {
+        destroy(pv + count, pv + n);
+        n = count;
+        return;
+    }
+    if (count > N)
+    {
+        // value可能引用Vector中的元素，先复制再扩容
+        E tmp(value);
+        reallocate(grow_capacity(count));
+        std::uninitialized_fill(pv + n, pv + count, tmp);
+    }
+    else
+        std::uninitialized_fill(pv + n, pv + count, value);
+    n = count;
+}
 
-    Vector tmp(count);
-    // 将所有元素移动到临时Vector
-    std::move(begin(), end(), tmp.begin());
-    tmp.n = n; // 设置临时Vector的大小
-    swap(tmp); // *this与tmp互相交换，退出时tmp被析构
+/**
+ * 在Vector尾部直接构造元素.
+ * 当Vector达到最大容量，按增长策略扩容后，再构造元素.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename... Args>
+void Vector<E, Policy, Alignment>::emplace_back(Args&&... args)
+{
+    if (n == N)
+        return emplace_back_grow(is_relocatable(), std::forward<Args>(args)...);
+    allocator_traits::construct(allocator, pv + n, std::forward<Args>(args)...);
+    ++n;
+}
+
+/**
+ * 扩容Vector并在新空间的尾部构造元素.
+ * 先构造新元素再移动原有元素，参数引用Vector中的元素时也是安全的.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename... Args>
+void Vector<E, Policy, Alignment>::emplace_back_grow(std::false_type, Args&&... args)
+{
+    size_type count = grow_capacity(n + 1);
+    pointer p = allocate(count);
+    try
+    {
+        allocator_traits::construct(allocator, p + n, std::forward<Args>(args)...);
+        try
+        {
+            std::uninitialized_copy(relocate_iterator(begin()), relocate_iterator(end()), p);
+        }
+        catch (...)
+        {
+            allocator_traits::destroy(allocator, p + n);
+            throw;
+        }
+    }
+    catch (...)
+    {
+        deallocate(p, count);
+        throw;
+    }
+    destroy(pv, pv + n);
+    deallocate(pv, N);
+    pv = p;
+    N = count;
+    ++n;
+}
+
+/**
+ * 扩容可以平凡重定位的元素的Vector，并在尾部构造元素.
+ * 参数可能引用Vector中的元素，而realloc会使其失效，
+ * 因此先在临时空间构造新元素，扩容后再按字节搬移到尾部.
+ *
+ * @param args: 用于构造元素的参数
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename... Args>
+void Vector<E, Policy, Alignment>::emplace_back_grow(std::true_type, Args&&... args)
+{
+    typename std::aligned_storage<sizeof(E), alignof(E)>::type buffer;
+    pointer tmp = reinterpret_cast<pointer>(&buffer);
+    allocator_traits::construct(allocator, tmp, std::forward<Args>(args)...);
+    try
+    {
+        reallocate(grow_capacity(n + 1));
+    }
+    catch (...)
+    {
+        allocator_traits::destroy(allocator, tmp);
+        throw;
+    }
+    std::memcpy(static_cast<void*>(pv + n), static_cast<const void*>(tmp), sizeof(E));
+    ++n;
 }
 
 /**
  * 添加元素到Vector指定位置.
- * 当Vector达到最大容量，扩容Vector到两倍容量后，再添加元素.
+ * 当Vector达到最大容量，按增长策略扩容后，再添加元素.
  *
- * @param i: 要添加元素的索引
+ * @param pos: 要添加元素的位置
  *        elem: 要添加的元素
- * @throws std::out_of_range: 索引不合法
+ * @throws std::out_of_range: 位置不合法
  */
-template<typename E>
-void Vector<E>::insert(iterator pos, E elem)
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::insert(const_iterator pos, E elem)
 {
+    size_type i = size_type(pos - cbegin());
     if (i == n)
-        insert_back(elem);
-    else if (!valid(i))
-        throw std::out_of_range("Vector::insert() i out of range.");
+        return emplace_back(std::move(elem));
+    if (!valid(i))
+        throw std::out_of_range("Vector::insert");
+    if (n == N)
+        reallocate(grow_capacity(n + 1));
+    // 在尾部构造最后一个元素的副本，再将pv[i]后面的元素向后迁移一个位置
+    allocator_traits::construct(allocator, pv + n, std::move(pv[n - 1]));
+    ++n;
+    std::move_backward(pv + i, pv + n - 2, pv + n - 1);
+    pv[i] = std::move(elem);
+}
+
+/**
+ * 添加单遍输入迭代器范围内的元素到指定位置.
+ * 元素个数未知，先逐个添加到尾部，再旋转到指定位置.
+ *
+ * @param pos: 要添加元素的位置
+ *        first: 范围的起始位置
+ *        last: 范围的结束位置
+ * @return 指向第一个添加的元素的迭代器
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename InputIt>
+typename Vector<E, Policy, Alignment>::iterator
+Vector<E, Policy, Alignment>::insert(const_iterator pos, InputIt first, InputIt last, std::input_iterator_tag)
+{
+    size_type i = size_type(pos - cbegin());
+    if (i > n)
+        throw std::out_of_range("Vector::insert");
+    size_type old = n;
+    append(first, last, std::input_iterator_tag());
+    std::rotate(pv + i, pv + old, pv + n);
+    return pv + i;
+}
+
+/**
+ * 添加前向迭代器范围内的元素到指定位置.
+ * 容量不足时按增长策略一次扩容，再把pv[i]后面的元素整体向后迁移，范围不能是当前Vector的元素.
+ *
+ * @param pos: 要添加元素的位置
+ *        first: 范围的起始位置
+ *        last: 范围的结束位置
+ * @return 指向第一个添加的元素的迭代器
+ * @throws std::out_of_range: 位置不合法
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename ForwardIt>
+typename Vector<E, Policy, Alignment>::iterator
+Vector<E, Policy, Alignment>::insert(const_iterator pos, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    size_type i = size_type(pos - cbegin());
+    if (i > n)
+        throw std::out_of_range("Vector::insert");
+    size_type count = size_type(std::distance(first, last));
+    if (count == 0)
+        return pv + i;
+    if (n + count > N)
+        reallocate(grow_capacity(n + count));
+    size_type old = n;
+    size_type after = old - i;
+    if (after > count)
+    {
+        // 后面的元素比添加的元素多：尾部count个元素移动到未初始化的空间，其余的向后迁移
+        std::uninitialized_copy(std::make_move_iterator(pv + old - count),
+                                std::make_move_iterator(pv + old), pv + old);
+        n += count;
+        std::move_backward(pv + i, pv + old - count, pv + old);
+        std::copy(first, last, pv + i);
+    }
     else
     {
-        if (n == N) reserve(N * 2);
-        // 将pl[i]后面的所有元素向数组后面迁移一个位置
-        std::move_backward(std::next(begin(), i), end(),
-                           std::next(begin(), n + 1));
-        (*this)[i] = std::move(elem);
-        n++;
+        // 添加的元素超出原来的尾部：超出部分直接构造，后面的元素移动到它们之后
+        ForwardIt mid = first;
+        std::advance(mid, after);
+        std::uninitialized_copy(mid, last, pv + old);
+        n += count - after;
+        std::uninitialized_copy(std::make_move_iterator(pv + i),
+                                std::make_move_iterator(pv + old), pv + n);
+        n += after;
+        std::copy(first, mid, pv + i);
     }
+    return pv + i;
 }
 
 /**
- * 添加元素到Vector尾部.
- * 当Vector达到最大容量，扩容Vector到两倍容量后，再添加元素.
+ * 添加单遍输入迭代器范围内的元素到Vector尾部.
  *
- * @param elem: 要添加的元素
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
  */
-template<typename E>
-void Vector<E>::insert_back(E elem)
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename InputIt>
+void Vector<E, Policy, Alignment>::append(InputIt first, InputIt last, std::input_iterator_tag)
 {
-    if (n == N)
-        reserve(N * 2);
-    (*this)[n++] = std::move(elem);
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+/**
+ * 添加前向迭代器范围内的元素到Vector尾部.
+ * 容量不足时按增长策略一次扩容，反复添加的总代价与元素个数成正比.
+ *
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+template<typename ForwardIt>
+void Vector<E, Policy, Alignment>::append(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    size_type count = size_type(std::distance(first, last));
+    if (n + count > N)
+        reallocate(grow_capacity(n + count));
+    std::uninitialized_copy(first, last, pv + n);
+    n += count;
 }
 
 /**
  * 移除Vector中指定位置的元素.
- * 当Vector达到1/4容量，缩小Vector容量.
+ * 移除后按增长策略收缩Vector容量.
  *
- * @param i: 要移除元素的索引
- * @throws std::out_of_range: 索引不合法
+ * @param pos: 要移除元素的位置
+ * @throws std::out_of_range: 位置不合法
  */
-template<typename E>
-void Vector<E>::remove(iterator pos)
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::remove(const_iterator pos)
 {
-    if (i == n - 1)
-        return remove_back();
+    size_type i = size_type(pos - cbegin());
     if (!valid(i))
-        throw std::out_of_range("Vector::remove() i out of range.");
-    // 将pl[i]后面的所有元素向前迁移一个位置
-    std::move(std::next(begin(), i + 1), end(),
-              std::next(begin(), i));
-    n--;
-    // 保证约为半满状态，保证n>0
-    if (n > 0 && n == N / 4)
-        reserve(N / 2);
+        throw std::out_of_range("Vector::remove");
+    // 将pv[i]后面的所有元素向前迁移一个位置
+    std::move(pv + i + 1, pv + n, pv + i);
+    allocator_traits::destroy(allocator, pv + --n);
+    shrink();
 }
 
 /**
  * 移除Vector尾部元素.
- * 当Vector达到1/4容量，缩小Vector容量.
+ * 移除后按增长策略收缩Vector容量.
  *
  * @throws std::out_of_range: Vector为空
  */
-template<typename E>
-void Vector<E>::remove_back()
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::remove_back()
 {
     if (empty())
         throw std::out_of_range("Vector::remove_back");
-    // 保证Vector始终约为半满状态，保证n>0
-    if (n > 0 && n == N / 4)
-        reserve(N / 2);
+    allocator_traits::destroy(allocator, pv + --n);
+    shrink();
 }
 
 /**
@@ -237,8 +867,8 @@ void Vector<E>::remove_back()
  * @return Vector头部元素的const引用
  * @throws std::out_of_range: Vector为空
  */
-template<typename E>
-const E& Vector<E>::front() const
+template<typename E, typename Policy, std::size_t Alignment>
+const E& Vector<E, Policy, Alignment>::front() const
 {
     if (empty())
         throw std::out_of_range("Vector::front");
@@ -251,8 +881,8 @@ const E& Vector<E>::front() const
  * @return Vector尾部元素的引用
  * @throws std::out_of_range: Vector为空
  */
-template<typename E>
-const E& Vector<E>::back() const
+template<typename E, typename Policy, std::size_t Alignment>
+const E& Vector<E, Policy, Alignment>::back() const
 {
     if (empty())
         throw std::out_of_range("Vector::back");
@@ -265,21 +895,51 @@ const E& Vector<E>::back() const
  * @return 指定位置元素的const引用
  * @throws std::out_of_range: 索引不合法
  */
-template<typename E>
-const E& Vector<E>::at(int i) const
+template<typename E, typename Policy, std::size_t Alignment>
+const E& Vector<E, Policy, Alignment>::at(size_type i) const
 {
     if (!valid(i))
         throw std::out_of_range("Vector::at");
     return (*this)[i];
 }
 
+/**
+ * 返回Vector最小的元素.
+ * int32_t、float和uint8_t元素使用SIMD指令扫描，浮点数中有NaN时结果未指定.
+ *
+ * @return 最小的元素
+ * @throws std::out_of_range: Vector为空
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+E Vector<E, Policy, Alignment>::min() const
+{
+    if (empty())
+        throw std::out_of_range("Vector::min");
+    return simd::min(cbegin(), n);
+}
+
+/**
+ * 返回Vector最大的元素.
+ * int32_t、float和uint8_t元素使用SIMD指令扫描，浮点数中有NaN时结果未指定.
+ *
+ * @return 最大的元素
+ * @throws std::out_of_range: Vector为空
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+E Vector<E, Policy, Alignment>::max() const
+{
+    if (empty())
+        throw std::out_of_range("Vector::max");
+    return simd::max(cbegin(), n);
+}
+
 /**
  * 交换当前Vector对象和另一个Vector对象.
  *
  * @param that: Vector对象that
  */
-template<typename E>
-void Vector<E>::swap(Vector<E>& that)
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::swap(Vector<E, Policy, Alignment>& that) noexcept
 {
     using std::swap;
     swap(n, that.n);
@@ -288,15 +948,16 @@ void Vector<E>::swap(Vector<E>& that)
 }
 
 /**
- * []操作符重载.
+ * 析构迭代器范围内的元素，不释放空间.
  *
- * @param i: []操作符内索引
- * @return 索引指向元素的const引用
+ * @param first: 范围的起始位置
+ *        last: 范围的结束位置
  */
-template<typename E>
-const E& Vector<E>::operator[](int i) const
+template<typename E, typename Policy, std::size_t Alignment>
+void Vector<E, Policy, Alignment>::destroy(pointer first, pointer last) noexcept
 {
-    return *std::next(begin(), i);
+    for (; first != last; ++first)
+        allocator_traits::destroy(allocator, first);
 }
 
 /**
@@ -306,8 +967,8 @@ const E& Vector<E>::operator[](int i) const
  * @param that: Vector对象that
  * @return 当前Vector对象
  */
-template<typename E>
-Vector<E>& Vector<E>::operator=(Vector<E> that)
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>& Vector<E, Policy, Alignment>::operator=(Vector<E, Policy, Alignment> that)
 {
     swap(that);
     return *this;
@@ -316,32 +977,112 @@ Vector<E>& Vector<E>::operator=(Vector<E> that)
 /**
  * +=操作符重载.
  * 复制另一个对象所有元素,添加到当前对象.
+ * 容量不足时按增长策略扩容，反复添加的总代价与元素个数成正比.
  *
  * @param that: Vector对象that
  * @return 当前Vector对象
  */
-template<typename E>
-Vector<E>& Vector<E>::operator+=(const Vector<E>& that)
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>& Vector<E, Policy, Alignment>::operator+=(const Vector<E, Policy, Alignment>& that)
+{
+    // that与当前对象相同时，扩容后从新空间复制
+    size_type count = that.n;
+    if (n + count > N)
+        reallocate(grow_capacity(n + count));
+    std::uninitialized_copy(that.pv, that.pv + count, pv + n);
+    n += count;
+    return *this;
+}
+
+/**
+ * +=操作符重载.
+ * 移动另一个对象所有元素,添加到当前对象，that变为空.
+ * 当前对象为空时直接接管that的空间.
+ *
+ * @param that: Vector对象that
+ * @return 当前Vector对象
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment>& Vector<E, Policy, Alignment>::operator+=(Vector<E, Policy, Alignment>&& that)
 {
-    reserve(N + that.N);
-    std::copy(that.begin(), that.end(), end());
-    n += that.n;
+    if (this == &that)
+        return *this += static_cast<const Vector&>(that);
+    if (empty())
+    {
+        swap(that);
+        return *this;
+    }
+    append(std::make_move_iterator(that.begin()), std::make_move_iterator(that.end()));
+    that.clear();
     return *this;
 }
 
 /**
  * +操作符重载.
- * 返回一个包含lhs和rhs所有元素的对象.
+ * 返回一个包含lhs和rhs所有元素的对象，只分配一次空间.
  *
  * @param lhs: Vector对象lhs
  *        rhs: Vector对象rhs
  * @return 包含lhs和rhs所有元素的Vector对象
  */
-template<typename E>
-Vector<E> operator+(Vector<E> lhs, const Vector<E>& rhs)
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment> operator+(const Vector<E, Policy, Alignment>& lhs,
+                                       const Vector<E, Policy, Alignment>& rhs)
+{
+    Vector<E, Policy, Alignment> result(lhs.size() + rhs.size());
+    result += lhs;
+    result += rhs;
+    return result;
+}
+
+/**
+ * +操作符重载.
+ * lhs是临时对象时，rhs的元素添加到lhs的空间.
+ *
+ * @param lhs: Vector对象lhs
+ *        rhs: Vector对象rhs
+ * @return 包含lhs和rhs所有元素的Vector对象
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment> operator+(Vector<E, Policy, Alignment>&& lhs,
+                                       const Vector<E, Policy, Alignment>& rhs)
 {
     lhs += rhs;
-    return lhs;
+    return std::move(lhs);
+}
+
+/**
+ * +操作符重载.
+ * rhs是临时对象时，lhs的元素添加到rhs的空间的头部.
+ *
+ * @param lhs: Vector对象lhs
+ *        rhs: Vector对象rhs
+ * @return 包含lhs和rhs所有元素的Vector对象
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment> operator+(const Vector<E, Policy, Alignment>& lhs,
+                                       Vector<E, Policy, Alignment>&& rhs)
+{
+    if (&lhs == &rhs)
+        return lhs + static_cast<const Vector<E, Policy, Alignment>&>(rhs);
+    rhs.insert(rhs.begin(), lhs.begin(), lhs.end());
+    return std::move(rhs);
+}
+
+/**
+ * +操作符重载.
+ * 两个操作数都是临时对象时，rhs的元素移动到lhs的空间.
+ *
+ * @param lhs: Vector对象lhs
+ *        rhs: Vector对象rhs
+ * @return 包含lhs和rhs所有元素的Vector对象
+ */
+template<typename E, typename Policy, std::size_t Alignment>
+Vector<E, Policy, Alignment> operator+(Vector<E, Policy, Alignment>&& lhs,
+                                       Vector<E, Policy, Alignment>&& rhs)
+{
+    lhs += std::move(rhs);
+    return std::move(lhs);
 }
 
 /**
@@ -352,12 +1093,12 @@ Vector<E> operator+(Vector<E> lhs, const Vector<E>& rhs)
  * @return true: 相等
  *         false: 不等
  */
-template<typename E>
-bool operator==(const Vector<E>& lhs, const Vector<E>& rhs)
+template<typename E, typename Policy, std::size_t Alignment>
+bool operator==(const Vector<E, Policy, Alignment>& lhs, const Vector<E, Policy, Alignment>& rhs)
 {
     if (&lhs == &rhs)             return true;
     if (lhs.size() != rhs.size()) return false;
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    return simd::equal(lhs.begin(), rhs.begin(), lhs.size());
 }
 
 /**
@@ -368,8 +1109,8 @@ bool operator==(const Vector<E>& lhs, const Vector<E>& rhs)
  * @return true: 不等
  *         false: 相等
  */
-template<typename E>
-bool operator!=(const Vector<E>& lhs, const Vector<E>& rhs)
+template<typename E, typename Policy, std::size_t Alignment>
+bool operator!=(const Vector<E, Policy, Alignment>& lhs, const Vector<E, Policy, Alignment>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -381,10 +1122,10 @@ bool operator!=(const Vector<E>& lhs, const Vector<E>& rhs)
  *        vector: 要输出的Vector
  * @return 输出流对象
  */
-template<typename E>
-std::ostream& operator<<(std::ostream& os, const Vector<E>& vector)
+template<typename E, typename Policy, std::size_t Alignment>
+std::ostream& operator<<(std::ostream& os, const Vector<E, Policy, Alignment>& vector)
 {
-    for (auto i : vector)
+    for (auto& i : vector)
         os << i << " ";
     return os;
 }
@@ -395,8 +1136,10 @@ std::ostream& operator<<(std::ostream& os, const Vector<E>& vector)
  * @param lhs: Vector对象lhs
  *        rhs: Vector对象rhs
  */
-template<typename E>
-void swap(Vector<E>& lhs, Vector<E>& rhs)
+template<typename E, typename Policy, std::size_t Alignment>
+void swap(Vector<E, Policy, Alignment>& lhs, Vector<E, Policy, Alignment>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
+
+} // namespace cpplib
@@ -0,0 +1,322 @@
+/*******************************************************************************
+ * Compilation:  g++ -O2 -IDeque -ITimer DequeBenchmark.cpp -o benchmark
+ * Execution:    ./benchmark
+ * Dependencies: Deque.h Queue.h RingBuffer.h Timer.h
+ *
+ * % ./benchmark
+ * Running time of random access in sliding window (10000000 reads):
+ * CONTAINER\WINDOW 1000   10000  100000 1000000
+ * cpplib::Deque    0.029  0.031  0.032  0.071
+ * std::deque       0.047  0.049  0.047  0.089
+ * array            0.024  0.023  0.023  0.044
+ * Running time of copy and destruction of int deque:
+ * CONTAINER\SIZE   1000000   10000000  100000000
+ * cpplib::Deque    0.003     0.032     0.33
+ * std::deque       0.001     0.033     0.388
+ * Latency of insert_back in nanoseconds (16777216 inserts):
+ * GROWTH\PERCENT   50      99.9    99.99   99.999  max
+ * amortized        32      66      69      207     1157193
+ * incremental      32      71      318     469     5098
+ * Running time of inserting and removing 1000 times in deque of 1000000 elements:
+ * CONTAINER\POS    front   1%      25%     50%     75%     99%     back
+ * cpplib::Deque*1  0       0.002   0.059   0.152   0.068   0.002   0
+ * std::deque*1     0       0.006   0.142   0.324   0.121   0.005   0
+ * cpplib::Deque*64 0       0.003   0.057   0.14    0.059   0.002   0
+ * std::deque*64    0       0.005   0.123   0.283   0.12    0.004   0
+ * Running time of bounded queue (100000000 operations):
+ * CONTAINER\DEPTH  16      256     4096    65536
+ * cpplib::Deque    0.219   0.204   0.203   0.205
+ * RingBuffer       0.179   0.181   0.175   0.155
+ ******************************************************************************/
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Deque.h"
+#include "Queue.h"
+#include "RingBuffer.h"
+#include "Timer.h"
+
+using namespace std;
+
+const size_t READS = 10000000;
+
+// 窗口在队尾加入一个元素，在队首删除一个元素
+void slide(cpplib::Deque<int>& dq, int elem) { dq.insert_back(elem); dq.remove_front(); }
+void slide(std::deque<int>& dq, int elem) { dq.push_back(elem); dq.pop_front(); }
+// 在位置i添加count个元素后再移除
+void edit(cpplib::Deque<int>& dq, size_t i, size_t count)
+{
+    dq.insert(dq.begin() + i, count, 0);
+    dq.remove(dq.begin() + i, dq.begin() + (i + count));
+}
+void edit(std::deque<int>& dq, size_t i, size_t count)
+{
+    dq.insert(dq.begin() + i, count, 0);
+    dq.erase(dq.begin() + i, dq.begin() + (i + count));
+}
+
+template<typename Container>
+double timeOfWindow(size_t window, string name);
+
+double timeOfArray(size_t window, string name);
+
+template<typename Container>
+double timeOfCopy(size_t n);
+
+void latencyOfInsert(size_t n, bool incremental);
+
+template<typename Container>
+double timeOfEdit(size_t n, size_t i, size_t count);
+
+template<typename Container>
+double timeOfBoundedQueue(Container c, size_t depth);
+
+int main()
+{
+    cout << "Running time of random access in sliding window ("
+         << READS << " reads):" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\WINDOW";
+    for (size_t w = 1000; w <= 1000000; w *= 10)
+        cout << std::left << setw(7) << w;
+    cout << endl;
+    cout << std::left << setw(17) << "cpplib::Deque";
+    for (size_t w = 1000; w <= 1000000; w *= 10)
+        cout << std::left << setw(7) << timeOfWindow<cpplib::Deque<int>>(w, "cpplib::Deque");
+    cout << endl;
+    cout << std::left << setw(17) << "std::deque";
+    for (size_t w = 1000; w <= 1000000; w *= 10)
+        cout << std::left << setw(7) << timeOfWindow<std::deque<int>>(w, "std::deque");
+    cout << endl;
+    cout << std::left << setw(17) << "array";
+    for (size_t w = 1000; w <= 1000000; w *= 10)
+        cout << std::left << setw(7) << timeOfArray(w, "array");
+    cout << endl;
+
+    cout << "Running time of copy and destruction of int deque:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\SIZE";
+    for (size_t n = 1000000; n <= 100000000; n *= 10)
+        cout << std::left << setw(10) << n;
+    cout << endl;
+    cout << std::left << setw(17) << "cpplib::Deque";
+    for (size_t n = 1000000; n <= 100000000; n *= 10)
+        cout << std::left << setw(10) << timeOfCopy<cpplib::Deque<int>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "std::deque";
+    for (size_t n = 1000000; n <= 100000000; n *= 10)
+        cout << std::left << setw(10) << timeOfCopy<std::deque<int>>(n);
+    cout << endl;
+
+    cout << "Latency of insert_back in nanoseconds (16777216 inserts):" << endl;
+    cout << std::left << setw(17) << "GROWTH\\PERCENT"
+         << setw(8) << "50" << setw(8) << "99.9" << setw(8) << "99.99"
+         << setw(8) << "99.999" << "max" << endl;
+    latencyOfInsert(16777216, false);
+    latencyOfInsert(16777216, true);
+
+    const size_t n = 1000000;
+    const size_t positions[] = {0, n / 100, n / 4, n / 2, n * 3 / 4, n - n / 100, n};
+    cout << "Running time of inserting and removing 1000 times in deque of "
+         << n << " elements:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\POS" << setw(8) << "front" << setw(8) << "1%"
+         << setw(8) << "25%" << setw(8) << "50%" << setw(8) << "75%" << setw(8) << "99%"
+         << "back" << endl;
+    for (size_t count = 1; count <= 64; count *= 64)
+    {
+        cout << std::left << setw(17) << ("cpplib::Deque*" + std::to_string(count));
+        for (size_t i : positions)
+            cout << std::left << setw(8) << timeOfEdit<cpplib::Deque<int>>(n, i, count);
+        cout << endl;
+        cout << std::left << setw(17) << ("std::deque*" + std::to_string(count));
+        for (size_t i : positions)
+            cout << std::left << setw(8) << timeOfEdit<std::deque<int>>(n, i, count);
+        cout << endl;
+    }
+
+    cout << "Running time of bounded queue (100000000 operations):" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\DEPTH";
+    for (size_t depth = 16; depth <= 65536; depth *= 16)
+        cout << std::left << setw(8) << depth;
+    cout << endl;
+    cout << std::left << setw(17) << "cpplib::Deque";
+    for (size_t depth = 16; depth <= 65536; depth *= 16)
+        cout << std::left << setw(8) << timeOfBoundedQueue(cpplib::Deque<int>(), depth);
+    cout << endl;
+    cout << std::left << setw(17) << "RingBuffer";
+    for (size_t depth = 16; depth <= 65536; depth *= 16)
+        cout << std::left << setw(8) << timeOfBoundedQueue(cpplib::RingBuffer<int>(depth), depth);
+    cout << endl;
+
+    return 0;
+}
+
+/**
+ * 测量滑动窗口中随机访问的时间.
+ * 窗口每次在队尾加入一个元素，在队首删除一个元素，
+ * 然后按跨越区块的步长读取窗口中的元素，队首偏移随之不断变化.
+ *
+ * @param window: 窗口大小
+ * @param name: 容器名称
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfWindow(size_t window, string name)
+{
+    Container dq(window, 0);
+    size_t step = 4099 % window;
+    size_t pos = 0;
+    long long sum = 0;
+    Timer timer;
+    for (size_t i = 0; i < READS; ++i)
+    {
+        if (i % 16 == 0)
+            slide(dq, int(i));
+        pos += step;
+        if (pos >= window)
+            pos -= window;
+        sum += dq[pos];
+    }
+    double elapsed = timer.elapsed();
+    if (sum == 0)
+        cerr << name << " checksum: " << sum << endl;
+    return elapsed;
+}
+
+/**
+ * 测量普通数组中相同访问模式的时间，作为随机访问的下界.
+ *
+ * @param window: 窗口大小
+ * @param name: 容器名称
+ * @return 运行时间，单位为秒
+ */
+double timeOfArray(size_t window, string name)
+{
+    vector<int> a(window + READS / 16 + 1);
+    for (size_t i = 0; i < window; ++i)
+        a[i] = int(i);
+    size_t first = 0;
+    size_t step = 4099 % window;
+    size_t pos = 0;
+    long long sum = 0;
+    Timer timer;
+    for (size_t i = 0; i < READS; ++i)
+    {
+        if (i % 16 == 0)
+        {
+            a[first + window] = int(i);
+            ++first;
+        }
+        pos += step;
+        if (pos >= window)
+            pos -= window;
+        sum += a[first + pos];
+    }
+    double elapsed = timer.elapsed();
+    if (sum == 0)
+        cerr << name << " checksum: " << sum << endl;
+    return elapsed;
+}
+
+/**
+ * 测量复制一个双端队列并析构副本的时间.
+ *
+ * @param n: 元素个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfCopy(size_t n)
+{
+    Container dq(n, 1);
+    Timer timer;
+    {
+        Container copy(dq);
+        if (copy.size() != n)
+            cerr << "copy size: " << copy.size() << endl;
+    }
+    return timer.elapsed();
+}
+
+/**
+ * 测量双端队列逐个添加元素时每次添加的延迟分布.
+ * 摊还扩容时，映射满的那一次添加需要复制整个映射，延迟的最大值随规模线性增长；
+ * 增量扩容把映射的复制分摊到之后的多次添加，最大值只受区块分配影响.
+ * 重复测量3次，每次添加取3次中的最小值，滤掉调度等偶然因素造成的延迟.
+ *
+ * @param n: 添加的元素个数
+ * @param incremental: 是否增量扩容映射
+ */
+void latencyOfInsert(size_t n, bool incremental)
+{
+    vector<size_t> latency(n, size_t(-1));
+    for (int round = 0; round < 3; ++round)
+    {
+        // 较小的区块使映射更大，扩容映射的代价更明显
+        cpplib::Deque<int, cpplib::BlockElements<16>> dq;
+        dq.set_incremental_growth(incremental);
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t start = Timer::time_nanos();
+            dq.insert_back(int(i));
+            latency[i] = std::min(latency[i], Timer::time_nanos() - start);
+        }
+    }
+    std::sort(latency.begin(), latency.end());
+    cout << std::left << setw(17) << (incremental ? "incremental" : "amortized")
+         << setw(8) << latency[n / 2]
+         << setw(8) << latency[n - n / 1000]
+         << setw(8) << latency[n - n / 10000]
+         << setw(8) << latency[n - n / 100000]
+         << latency[n - 1] << endl;
+}
+
+/**
+ * 测量在指定位置反复添加和移除元素的时间.
+ * 较短一侧的元素个数为min(i, n - i)，运行时间应随之线性变化，
+ * 两端的添加和移除不需要移动元素.
+ *
+ * @param n: 双端队列的元素个数
+ * @param i: 添加和移除的位置
+ * @param count: 每次添加和移除的元素个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfEdit(size_t n, size_t i, size_t count)
+{
+    Container dq(n, 1);
+    Timer timer;
+    for (size_t k = 0; k < 1000; ++k)
+        edit(dq, i, count);
+    return timer.elapsed();
+}
+
+/**
+ * 测量有界队列的运行时间.
+ * 队列保持depth个元素，每次出队一个元素后入队一个元素.
+ * 环形缓冲区在构造后不再分配内存，双端队列需要不断回收和申请区块.
+ *
+ * @param c: 队列使用的容器
+ * @param depth: 队列深度
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfBoundedQueue(Container c, size_t depth)
+{
+    Queue<int, Container> queue(std::move(c));
+    long long sum = 0;
+    for (size_t i = 0; i < depth; ++i)
+        queue.enqueue(int(i));
+    Timer timer;
+    for (size_t i = 0; i < 100000000; ++i)
+    {
+        sum += queue.front();
+        queue.dequeue();
+        queue.enqueue(int(i));
+    }
+    double elapsed = timer.elapsed();
+    if (sum == 0)
+        cerr << "checksum: " << sum << endl;
+    return elapsed;
+}
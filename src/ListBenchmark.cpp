@@ -0,0 +1,428 @@
+/*******************************************************************************
+ * Compilation:  g++ -O2 -IList -ITimer ListBenchmark.cpp -o benchmark
+ * Execution:    ./benchmark
+ * Dependencies: List.h PoolAllocator.h SkipList.h UnrolledList.h Vector.h Timer.h
+ *
+ * % ./benchmark
+ * Running time of churning lists (100000000 inserts and removes):
+ * CONTAINER\SIZE   1000      100000    10000000
+ * std::list        3.069     3.232     3.183
+ * List(malloc)     2.761     2.634     2.477
+ * List(pool)       1.115     1.153     1.276
+ * Running time of copying a list into a fragmented heap and traversing it 10 times:
+ * CONTAINER\SIZE   100000    1000000   10000000
+ * std::list        0.028     0.344     3.59
+ * List(malloc)     0.06      0.638     9.093
+ * List(pool)       0.005     0.072     0.945
+ * Running time of summing 100000000 elements:
+ * CONTAINER\SIZE   10000     1000000   10000000
+ * List(pool)       0.239     0.543     0.515
+ * UnrolledList     0.17      0.155     0.175
+ * Vector           0.082     0.08      0.094
+ * Running time of inserting 1000 elements at random positions:
+ * CONTAINER\SIZE   10000     100000    1000000
+ * List(pool)       0.012     0.122     2.034
+ * UnrolledList     0.008     0.082     0.764
+ * Vector           0         0.006     0.102
+ * Running time of erasing 1000 elements at random positions:
+ * CONTAINER\SIZE   10000     100000    1000000
+ * List(pool)       0.01      0.119     1.945
+ * UnrolledList     0.009     0.069     0.747
+ * Vector           0.001     0.006     0.101
+ * Running time of sorting a list of random integers:
+ * METHOD\SIZE      100000    1000000   10000000
+ * std::list::sort  0.035     0.666     14.963
+ * List::sort       0.027     0.742     15.046
+ * via Vector       0.012     0.155     1.697
+ * Running time of editor-like traces on 1000000 elements:
+ * CONTAINER\EDITS  1000      10000     100000
+ * List(pool)       1.168     9.719     -
+ * UnrolledList     0.576     4.785     -
+ * Vector           0.074     0.813     8.594
+ * SkipList         0.002     0.02      0.123
+ ******************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include "List.h"
+#include "SkipList.h"
+#include "Timer.h"
+#include "UnrolledList.h"
+#include "Vector.h"
+
+using namespace std;
+
+// 使用标准库分配器的链表，每个结点单独调用malloc和free
+using MallocList = cpplib::List<int, std::allocator<int>>;
+
+template<typename Container>
+double timeOfChurn(size_t n);
+
+template<typename Container>
+double timeOfCopyAndTraverse(size_t n);
+
+template<typename Container>
+double timeOfTraverse(size_t n);
+
+template<typename Container>
+double timeOfRandomEdit(size_t n, bool insert);
+
+double timeOfSort(const string& method, size_t n);
+
+template<typename Container>
+double timeOfEditTrace(size_t n, size_t edits);
+
+int main()
+{
+    cout << "Running time of churning lists (100000000 inserts and removes):" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\SIZE";
+    for (size_t n : {1000, 100000, 10000000})
+        cout << std::left << setw(10) << n;
+    cout << endl;
+    cout << std::left << setw(17) << "std::list";
+    for (size_t n : {1000, 100000, 10000000})
+        cout << std::left << setw(10) << timeOfChurn<std::list<int>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "List(malloc)";
+    for (size_t n : {1000, 100000, 10000000})
+        cout << std::left << setw(10) << timeOfChurn<MallocList>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "List(pool)";
+    for (size_t n : {1000, 100000, 10000000})
+        cout << std::left << setw(10) << timeOfChurn<cpplib::List<int>>(n);
+    cout << endl;
+
+    cout << "Running time of copying a list into a fragmented heap and traversing it 10 times:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\SIZE";
+    for (size_t n : {100000, 1000000, 10000000})
+        cout << std::left << setw(10) << n;
+    cout << endl;
+    cout << std::left << setw(17) << "std::list";
+    for (size_t n : {100000, 1000000, 10000000})
+        cout << std::left << setw(10) << timeOfCopyAndTraverse<std::list<int>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "List(malloc)";
+    for (size_t n : {100000, 1000000, 10000000})
+        cout << std::left << setw(10) << timeOfCopyAndTraverse<MallocList>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "List(pool)";
+    for (size_t n : {100000, 1000000, 10000000})
+        cout << std::left << setw(10) << timeOfCopyAndTraverse<cpplib::List<int>>(n);
+    cout << endl;
+
+    cout << "Running time of summing 100000000 elements:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\SIZE";
+    for (size_t n : {10000, 1000000, 10000000})
+        cout << std::left << setw(10) << n;
+    cout << endl;
+    cout << std::left << setw(17) << "List(pool)";
+    for (size_t n : {10000, 1000000, 10000000})
+        cout << std::left << setw(10) << timeOfTraverse<cpplib::List<int>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "UnrolledList";
+    for (size_t n : {10000, 1000000, 10000000})
+        cout << std::left << setw(10) << timeOfTraverse<cpplib::UnrolledList<int>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "Vector";
+    for (size_t n : {10000, 1000000, 10000000})
+        cout << std::left << setw(10) << timeOfTraverse<cpplib::Vector<int>>(n);
+    cout << endl;
+
+    for (bool insert : {true, false})
+    {
+        cout << "Running time of " << (insert ? "inserting" : "erasing")
+             << " 1000 elements at random positions:" << endl;
+        cout << std::left << setw(17) << "CONTAINER\\SIZE";
+        for (size_t n : {10000, 100000, 1000000})
+            cout << std::left << setw(10) << n;
+        cout << endl;
+        cout << std::left << setw(17) << "List(pool)";
+        for (size_t n : {10000, 100000, 1000000})
+            cout << std::left << setw(10) << timeOfRandomEdit<cpplib::List<int>>(n, insert);
+        cout << endl;
+        cout << std::left << setw(17) << "UnrolledList";
+        for (size_t n : {10000, 100000, 1000000})
+            cout << std::left << setw(10) << timeOfRandomEdit<cpplib::UnrolledList<int>>(n, insert);
+        cout << endl;
+        cout << std::left << setw(17) << "Vector";
+        for (size_t n : {10000, 100000, 1000000})
+            cout << std::left << setw(10) << timeOfRandomEdit<cpplib::Vector<int>>(n, insert);
+        cout << endl;
+    }
+
+    cout << "Running time of sorting a list of random integers:" << endl;
+    cout << std::left << setw(17) << "METHOD\\SIZE";
+    for (size_t n : {100000, 1000000, 10000000})
+        cout << std::left << setw(10) << n;
+    cout << endl;
+    for (string method : {"std::list::sort", "List::sort", "via Vector"})
+    {
+        cout << std::left << setw(17) << method;
+        for (size_t n : {100000, 1000000, 10000000})
+            cout << std::left << setw(10) << timeOfSort(method, n);
+        cout << endl;
+    }
+
+    // 按位置修改链表需要线性的查找，太慢的组合不测量
+    const size_t elements = 1000000;
+    cout << "Running time of editor-like traces on " << elements << " elements:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\EDITS";
+    for (size_t edits : {1000, 10000, 100000})
+        cout << std::left << setw(10) << edits;
+    cout << endl;
+    cout << std::left << setw(17) << "List(pool)";
+    for (size_t edits : {1000, 10000, 100000})
+        if (edits <= 10000)
+            cout << std::left << setw(10) << timeOfEditTrace<cpplib::List<int>>(elements, edits);
+        else
+            cout << std::left << setw(10) << "-";
+    cout << endl;
+    cout << std::left << setw(17) << "UnrolledList";
+    for (size_t edits : {1000, 10000, 100000})
+        if (edits <= 10000)
+            cout << std::left << setw(10) << timeOfEditTrace<cpplib::UnrolledList<int>>(elements, edits);
+        else
+            cout << std::left << setw(10) << "-";
+    cout << endl;
+    cout << std::left << setw(17) << "Vector";
+    for (size_t edits : {1000, 10000, 100000})
+        cout << std::left << setw(10) << timeOfEditTrace<cpplib::Vector<int>>(elements, edits);
+    cout << endl;
+    cout << std::left << setw(17) << "SkipList";
+    for (size_t edits : {1000, 10000, 100000})
+        cout << std::left << setw(10) << timeOfEditTrace<cpplib::SkipList<int>>(elements, edits);
+    cout << endl;
+
+    return 0;
+}
+
+// 统一不同链表的接口
+void push_back(std::list<int>& list, int i) { list.push_back(i); }
+void pop_front(std::list<int>& list) { list.pop_front(); }
+template<typename List>
+void push_back(List& list, int i) { list.insert_back(i); }
+template<typename List>
+void pop_front(List& list) { list.remove_front(); }
+
+/**
+ * 测量链表在保持n个元素的同时反复在尾部添加、在头部移除的时间.
+ * 每次添加都分配一个结点，每次移除都释放一个结点.
+ *
+ * @param n: 链表的元素个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfChurn(size_t n)
+{
+    Container list;
+    for (size_t i = 0; i < n; ++i)
+        push_back(list, int(i));
+    Timer timer;
+    for (int i = 0; i < 100000000; ++i)
+    {
+        push_back(list, i);
+        pop_front(list);
+    }
+    double elapsed = timer.elapsed();
+    if (list.size() != n)
+        cerr << "size: " << list.size() << endl;
+    return elapsed;
+}
+
+/**
+ * 测量堆中有大量空洞时复制链表、再遍历副本10次的时间.
+ * 先添加2n个元素，再按伪随机的顺序移除约一半，释放的结点在堆中留下分散的空洞；
+ * 逐个分配结点的副本会填进这些空洞，遍历时几乎每次都缓存缺失，
+ * 内存池一次预留所有结点，副本的结点连续排列.
+ *
+ * @param n: 副本的元素个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfCopyAndTraverse(size_t n)
+{
+    Container list;
+    for (size_t i = 0; i < 2 * n; ++i)
+        push_back(list, int(i));
+    // 用线性同余生成器选择移除的元素
+    unsigned seed = 1;
+    for (size_t i = 0; i < 2 * n; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        int value = list.front();
+        pop_front(list);
+        if (seed >> 31)
+            push_back(list, value);
+    }
+    Timer timer;
+    long long sum = 0;
+    {
+        Container copy(list);
+        for (int round = 0; round < 10; ++round)
+            for (int value : copy)
+                sum += value;
+    }
+    double elapsed = timer.elapsed();
+    if (sum < 0)
+        cerr << "sum: " << sum << endl;
+    return elapsed;
+}
+
+/**
+ * 测量按顺序遍历并累加元素的时间，总共累加100000000个元素.
+ * List的每个元素都要经过一次指针跳转，UnrolledList每个结点只跳转一次.
+ *
+ * @param n: 容器的元素个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfTraverse(size_t n)
+{
+    Container container;
+    for (size_t i = 0; i < n; ++i)
+        push_back(container, int(i));
+    Timer timer;
+    long long sum = 0;
+    for (size_t round = 0; round < 100000000 / n; ++round)
+        for (int value : container)
+            sum += value;
+    double elapsed = timer.elapsed();
+    if (sum < 0)
+        cerr << "sum: " << sum << endl;
+    return elapsed;
+}
+
+/**
+ * 测量在伪随机的下标处添加或移除1000个元素的时间.
+ * 链表从头部走到下标处再修改，Vector直接定位但要移动之后的所有元素.
+ *
+ * @param n: 容器的元素个数
+ *        insert: 为true时添加元素，否则移除元素
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfRandomEdit(size_t n, bool insert)
+{
+    Container container;
+    for (size_t i = 0; i < n; ++i)
+        push_back(container, int(i));
+    unsigned seed = 1;
+    Timer timer;
+    for (int i = 0; i < 1000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t pos = (seed >> 8) % container.size();
+        auto it = std::next(container.cbegin(), pos);
+        if (insert)
+            container.insert(it, i);
+        else
+            container.remove(it);
+    }
+    double elapsed = timer.elapsed();
+    if (container.size() != (insert ? n + 1000 : n - 1000))
+        cerr << "size: " << container.size() << endl;
+    return elapsed;
+}
+
+/**
+ * 测量排序n个伪随机整数的链表的时间.
+ * std::list::sort和List::sort只修改指针；
+ * via Vector把元素复制到Vector，用std::sort排序后再写回链表.
+ *
+ * @param method: 排序方法
+ *        n: 链表的元素个数
+ * @return 运行时间，单位为秒
+ */
+double timeOfSort(const string& method, size_t n)
+{
+    cpplib::List<int> list;
+    std::list<int> std_list;
+    unsigned seed = 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        if (method == "std::list::sort")
+            std_list.push_back(int(seed >> 1));
+        else
+            list.insert_back(int(seed >> 1));
+    }
+    Timer timer;
+    if (method == "std::list::sort")
+    {
+        std_list.sort();
+    }
+    else if (method == "List::sort")
+    {
+        list.sort();
+    }
+    else
+    {
+        cpplib::Vector<int> vector;
+        for (int value : list)
+            vector.insert_back(value);
+        std::sort(vector.begin(), vector.end());
+        auto it = vector.begin();
+        for (int& value : list)
+            value = *it++;
+    }
+    double elapsed = timer.elapsed();
+    if (!std::is_sorted(list.begin(), list.end()) || !std::is_sorted(std_list.begin(), std_list.end()))
+        cerr << "not sorted" << endl;
+    return elapsed;
+}
+
+// 统一按位置添加和移除的接口，链表从较近的一端走到指定位置
+template<typename Container>
+typename Container::const_iterator position(const Container& c, size_t i)
+{
+    return i <= c.size() / 2 ? std::next(c.cbegin(), i) : std::prev(c.cend(), c.size() - i);
+}
+template<typename Container>
+void insert_at(Container& c, size_t i, int value) { c.insert(position(c, i), value); }
+template<typename Container>
+void remove_at(Container& c, size_t i) { c.remove(position(c, i)); }
+void insert_at(cpplib::SkipList<int>& c, size_t i, int value) { c.insert(i, value); }
+void remove_at(cpplib::SkipList<int>& c, size_t i) { c.remove(i); }
+
+/**
+ * 测量在n个元素上执行模拟编辑器的按位置修改序列的时间.
+ * 光标大多在附近移动，偶尔随机跳转，在光标处等概率地添加或移除元素；
+ * 每次修改都只给出位置，不保留迭代器.
+ *
+ * @param n: 初始的元素个数
+ *        edits: 修改的次数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfEditTrace(size_t n, size_t edits)
+{
+    Container container;
+    for (size_t i = 0; i < n; ++i)
+        push_back(container, int(i));
+    unsigned seed = 1;
+    size_t cursor = n / 2;
+    Timer timer;
+    for (size_t i = 0; i < edits; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t size = container.size();
+        size_t step = (seed >> 8) % 201;
+        if ((seed >> 28) == 0)
+            cursor = (seed >> 4) % (size + 1);
+        else
+            cursor = cursor + step >= 100 ? std::min(size, cursor + step - 100) : 0;
+        if ((seed >> 27) & 1)
+            insert_at(container, cursor, int(i));
+        else if (cursor < size)
+            remove_at(container, cursor);
+    }
+    double elapsed = timer.elapsed();
+    if (container.size() > n + edits)
+        cerr << "size: " << container.size() << endl;
+    return elapsed;
+}
@@ -0,0 +1,495 @@
+/*******************************************************************************
+ * Compilation:  g++ -O2 -IVector -ITimer VectorBenchmark.cpp -o benchmark
+ * Execution:    ./benchmark
+ * Dependencies: Vector.h SmallVector.h PackedVector.h SoAVector.h Simd.h Timer.h
+ *
+ * % ./benchmark
+ * Running time of insert_back of 16-byte records:
+ * CONTAINER\SIZE   1000000   10000000  40000000
+ * std::vector      0.016     0.214     1.077
+ * Vector(move)     0.02      0.178     0.771
+ * Vector(relocate) 0.007     0.087     0.324
+ * Running time of size oscillating between 1/8 and full (100000000 operations):
+ * POLICY\HIGH      64        2048      65536
+ * shrink at 1/4    1.484     1.216     1.214
+ * shrink at 1/16   0.569     0.554     0.549
+ * never shrink     0.525     0.556     0.522
+ * Running time of building 10000000 short-lived vectors of ints:
+ * CONTAINER\LENGTH 4         12        48
+ * std::vector      1.104     1.964     3.237
+ * Vector           0.278     0.826     1.753
+ * SmallVector<16>  0.079     0.193     1.281
+ * Running time of concatenating chunks of 16 ints:
+ * CONTAINER\CHUNKS 100000    1000000   4000000
+ * std::vector      0.003     0.085     0.402
+ * Vector           0.002     0.049     0.171
+ * Running time of scanning 1000000000 ints:
+ * LEVEL\ALGORITHM  equal     find      count     min       sum
+ * std algorithm    0.339     0.314     0.82      2.95      1.064
+ * scalar           0.344     0.357     0.776     0.869     0.794
+ * SSE4.2           0.394     0.357     0.293     0.241     0.44
+ * AVX2             0.415     0.224     0.23      0.221     0.27
+ * Running time of summing 50000000 ids 10 times:
+ * METHOD\BITS      10        16        20
+ * Vector<uint32_t> 0.311     0.326     0.319
+ * get              1.541     1.065     0.755
+ * unpack(scalar)   1.383     1.065     1.007
+ * unpack           0.404     0.406     0.448
+ * Running time of summing one field of 32-byte points (1000000000 rows):
+ * LAYOUT\ROWS      100000    1000000   10000000
+ * Vector<Point>    1.294     3.49      3.409
+ * SoAVector        0.322     0.344     0.895
+ ******************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "PackedVector.h"
+#include "SmallVector.h"
+#include "SoAVector.h"
+#include "Timer.h"
+#include "Vector.h"
+
+using namespace std;
+
+// 可以平凡重定位的记录，扩容时整体搬移
+struct Record
+{
+    long key;
+    double value;
+
+    Record(long key, double value) : key(key), value(value) {}
+};
+
+// 相同布局的记录，自定义的移动构造使扩容只能逐个移动
+struct MovableRecord
+{
+    long key;
+    double value;
+
+    MovableRecord(long key, double value) : key(key), value(value) {}
+    MovableRecord(MovableRecord&& that) noexcept : key(that.key), value(that.value) {}
+};
+
+// 32字节的点，按行存储时求一个字段的和也要读取整个记录
+struct Point
+{
+    double x;
+    double y;
+    double z;
+    long id;
+};
+
+// 统一不同容器添加元素的接口
+template<typename E>
+void append(std::vector<E>& v, long key) { v.emplace_back(key, 0.5); }
+template<typename E>
+void append(cpplib::Vector<E>& v, long key) { v.emplace_back(key, 0.5); }
+
+// 统一不同容器添加整数的接口
+void push(std::vector<int>& v, int i) { v.push_back(i); }
+template<typename Container>
+void push(Container& v, int i) { v.insert_back(i); }
+
+// 统一不同容器拼接的接口
+void concatenate(std::vector<int>& v, const std::vector<int>& chunk) { v.insert(v.end(), chunk.begin(), chunk.end()); }
+void concatenate(cpplib::Vector<int>& v, const cpplib::Vector<int>& chunk) { v += chunk; }
+
+template<typename Container>
+double timeOfInsert(int n);
+
+template<typename Policy>
+double timeOfOscillation(int high);
+
+template<typename Container>
+double timeOfShortLived(int length);
+
+double timeOfScan(const std::string& algorithm, int level);
+
+template<typename Container>
+double timeOfConcatenation(int chunks);
+
+template<unsigned Bits>
+double timeOfIdScan(const std::string& method);
+
+double timeOfFieldSum(const std::string& layout, int rows);
+
+int main()
+{
+    cout << "Running time of insert_back of 16-byte records:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\SIZE";
+    for (int n : {1000000, 10000000, 40000000})
+        cout << std::left << setw(10) << n;
+    cout << endl;
+    cout << std::left << setw(17) << "std::vector";
+    for (int n : {1000000, 10000000, 40000000})
+        cout << std::left << setw(10) << timeOfInsert<std::vector<Record>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "Vector(move)";
+    for (int n : {1000000, 10000000, 40000000})
+        cout << std::left << setw(10) << timeOfInsert<cpplib::Vector<MovableRecord>>(n);
+    cout << endl;
+    cout << std::left << setw(17) << "Vector(relocate)";
+    for (int n : {1000000, 10000000, 40000000})
+        cout << std::left << setw(10) << timeOfInsert<cpplib::Vector<Record>>(n);
+    cout << endl;
+
+    cout << "Running time of size oscillating between 1/8 and full (100000000 operations):" << endl;
+    cout << std::left << setw(17) << "POLICY\\HIGH";
+    for (int high = 64; high <= 65536; high *= 32)
+        cout << std::left << setw(10) << high;
+    cout << endl;
+    cout << std::left << setw(17) << "shrink at 1/4";
+    for (int high = 64; high <= 65536; high *= 32)
+        cout << std::left << setw(10) << timeOfOscillation<cpplib::GrowthFactor<>>(high);
+    cout << endl;
+    cout << std::left << setw(17) << "shrink at 1/16";
+    for (int high = 64; high <= 65536; high *= 32)
+        cout << std::left << setw(10) << timeOfOscillation<cpplib::GrowthFactor<2, 1, 10, 16>>(high);
+    cout << endl;
+    cout << std::left << setw(17) << "never shrink";
+    for (int high = 64; high <= 65536; high *= 32)
+        cout << std::left << setw(10) << timeOfOscillation<cpplib::NeverShrink>(high);
+    cout << endl;
+
+    cout << "Running time of building 10000000 short-lived vectors of ints:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\LENGTH";
+    for (int length : {4, 12, 48})
+        cout << std::left << setw(10) << length;
+    cout << endl;
+    cout << std::left << setw(17) << "std::vector";
+    for (int length : {4, 12, 48})
+        cout << std::left << setw(10) << timeOfShortLived<std::vector<int>>(length);
+    cout << endl;
+    cout << std::left << setw(17) << "Vector";
+    for (int length : {4, 12, 48})
+        cout << std::left << setw(10) << timeOfShortLived<cpplib::Vector<int>>(length);
+    cout << endl;
+    cout << std::left << setw(17) << "SmallVector<16>";
+    for (int length : {4, 12, 48})
+        cout << std::left << setw(10) << timeOfShortLived<cpplib::SmallVector<int, 16>>(length);
+    cout << endl;
+
+    cout << "Running time of concatenating chunks of 16 ints:" << endl;
+    cout << std::left << setw(17) << "CONTAINER\\CHUNKS";
+    for (int chunks : {100000, 1000000, 4000000})
+        cout << std::left << setw(10) << chunks;
+    cout << endl;
+    cout << std::left << setw(17) << "std::vector";
+    for (int chunks : {100000, 1000000, 4000000})
+        cout << std::left << setw(10) << timeOfConcatenation<std::vector<int>>(chunks);
+    cout << endl;
+    cout << std::left << setw(17) << "Vector";
+    for (int chunks : {100000, 1000000, 4000000})
+        cout << std::left << setw(10) << timeOfConcatenation<cpplib::Vector<int>>(chunks);
+    cout << endl;
+
+    // level为-1时使用标准库算法，否则为simd::Level的值
+    cout << "Running time of scanning 1000000000 ints:" << endl;
+    cout << std::left << setw(17) << "LEVEL\\ALGORITHM";
+    for (const char* algorithm : {"equal", "find", "count", "min", "sum"})
+        cout << std::left << setw(10) << algorithm;
+    cout << endl;
+    const char* names[] = {"std algorithm", "scalar", "SSE4.2", "AVX2"};
+    for (int level = -1; level <= int(cpplib::simd::supported_level()); ++level)
+    {
+        cout << std::left << setw(17) << names[level + 1];
+        for (const char* algorithm : {"equal", "find", "count", "min", "sum"})
+            cout << std::left << setw(10) << timeOfScan(algorithm, level);
+        cout << endl;
+    }
+
+    cout << "Running time of summing 50000000 ids 10 times:" << endl;
+    cout << std::left << setw(17) << "METHOD\\BITS";
+    for (int bits : {10, 16, 20})
+        cout << std::left << setw(10) << bits;
+    cout << endl;
+    for (const char* method : {"Vector<uint32_t>", "get", "unpack(scalar)", "unpack"})
+    {
+        cout << std::left << setw(17) << method;
+        cout << std::left << setw(10) << timeOfIdScan<10>(method);
+        cout << std::left << setw(10) << timeOfIdScan<16>(method);
+        cout << std::left << setw(10) << timeOfIdScan<20>(method);
+        cout << endl;
+    }
+
+    cout << "Running time of summing one field of 32-byte points (1000000000 rows):" << endl;
+    cout << std::left << setw(17) << "LAYOUT\\ROWS";
+    for (int rows : {100000, 1000000, 10000000})
+        cout << std::left << setw(10) << rows;
+    cout << endl;
+    for (const char* layout : {"Vector<Point>", "SoAVector"})
+    {
+        cout << std::left << setw(17) << layout;
+        for (int rows : {100000, 1000000, 10000000})
+            cout << std::left << setw(10) << timeOfFieldSum(layout, rows);
+        cout << endl;
+    }
+
+    return 0;
+}
+
+/**
+ * 测量逐个添加n个记录的时间，包括所有扩容的时间.
+ *
+ * @param n: 添加的记录个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfInsert(int n)
+{
+    Timer timer;
+    {
+        Container v;
+        for (int i = 0; i < n; ++i)
+            append(v, i);
+        if (v[n - 1].key != n - 1)
+            cerr << "last key: " << v[n - 1].key << endl;
+    }
+    return timer.elapsed();
+}
+
+/**
+ * 测量元素个数在high / 8和high之间来回变化的时间.
+ * 默认策略在元素个数降到1/4容量时收缩，每个来回都要重新分配多次；
+ * 收缩阈值低于1/8或从不收缩时，稳定后不再分配内存.
+ *
+ * @param high: 元素个数的上界
+ * @return 运行时间，单位为秒
+ */
+template<typename Policy>
+double timeOfOscillation(int high)
+{
+    cpplib::Vector<std::string, Policy> v;
+    int low = high / 8;
+    for (int i = 0; i < low; ++i)
+        v.insert_back("");
+    Timer timer;
+    for (int round = 0; round < 100000000 / (high - low) / 2; ++round)
+    {
+        for (int i = low; i < high; ++i)
+            v.insert_back("");
+        for (int i = low; i < high; ++i)
+            v.remove_back();
+    }
+    return timer.elapsed();
+}
+
+/**
+ * 测量反复构造、填充和销毁短小容器的时间.
+ * 元素个数不超过内联容量时，SmallVector不分配堆内存.
+ *
+ * @param length: 每个容器的元素个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfShortLived(int length)
+{
+    long sum = 0;
+    Timer timer;
+    for (int round = 0; round < 10000000; ++round)
+    {
+        Container v;
+        for (int i = 0; i < length; ++i)
+            push(v, round + i);
+        sum += v[length - 1];
+    }
+    double elapsed = timer.elapsed();
+    if (sum == 0)
+        cerr << "sum: " << sum << endl;
+    return elapsed;
+}
+
+/**
+ * 测量在两个各有1000000个int的Vector上反复扫描的时间，共扫描1000000000个元素.
+ * 要查找的值不存在，find扫描全部元素.
+ *
+ * @param algorithm: 算法名称
+ *        level: 指令集级别，-1表示使用标准库算法
+ * @return 运行时间，单位为秒
+ */
+double timeOfScan(const std::string& algorithm, int level)
+{
+    const int n = 1000000;
+    cpplib::Vector<int> a(n);
+    for (int i = 0; i < n; ++i)
+        a.insert_back(i % 1000);
+    cpplib::Vector<int> b(a);
+    if (level >= 0)
+        cpplib::simd::level() = cpplib::simd::Level(level);
+    long long result = 0;
+    Timer timer;
+    for (int round = 0; round < 1000; ++round)
+    {
+        if (level < 0)
+        {
+            if (algorithm == "equal")      result += std::equal(a.begin(), a.end(), b.begin());
+            else if (algorithm == "find")  result += std::find(a.begin(), a.end(), -1) - a.begin();
+            else if (algorithm == "count") result += std::count(a.begin(), a.end(), round % 1000);
+            else if (algorithm == "min")   result += *std::min_element(a.begin(), a.end());
+            else                           result += std::accumulate(a.begin(), a.end(), 0LL);
+        }
+        else
+        {
+            if (algorithm == "equal")      result += a == b;
+            else if (algorithm == "find")  result += a.find(-1) - a.begin();
+            else if (algorithm == "count") result += a.count(round % 1000);
+            else if (algorithm == "min")   result += a.min();
+            else                           result += a.sum();
+        }
+    }
+    double elapsed = timer.elapsed();
+    cpplib::simd::level() = cpplib::simd::supported_level();
+    if (result < 0)
+        cerr << "result: " << result << endl;
+    return elapsed;
+}
+
+/**
+ * 测量把chunks个含16个整数的块依次拼接到一个容器的时间.
+ * 拼接按增长策略扩容，总时间与元素个数成正比.
+ *
+ * @param chunks: 块的个数
+ * @return 运行时间，单位为秒
+ */
+template<typename Container>
+double timeOfConcatenation(int chunks)
+{
+    Container chunk;
+    for (int i = 0; i < 16; ++i)
+        push(chunk, i);
+    Timer timer;
+    Container v;
+    for (int i = 0; i < chunks; ++i)
+        concatenate(v, chunk);
+    double elapsed = timer.elapsed();
+    if (v.size() != std::size_t(chunks) * 16)
+        cerr << "size: " << v.size() << endl;
+    return elapsed;
+}
+
+/**
+ * 测量对50000000个Bits位的id反复求和10次的时间.
+ * Vector<uint32_t>逐个读取未压缩的数组；get逐个读取PackedVector；
+ * unpack每次把1024个元素批量解压到缓冲区再求和，scalar表示不使用向量指令.
+ *
+ * @param method: 读取方式
+ * @return 运行时间，单位为秒
+ */
+template<unsigned Bits>
+double timeOfIdScan(const std::string& method)
+{
+    const std::size_t n = 50000000;
+    const std::size_t chunk = 1024;
+    unsigned long long result = 0;
+    double elapsed = 0;
+    if (method == "Vector<uint32_t>")
+    {
+        cpplib::Vector<std::uint32_t> v(n);
+        for (std::size_t i = 0; i < n; ++i)
+            v.insert_back(std::uint32_t(i * 2654435761ULL) & ((1U << Bits) - 1));
+        Timer timer;
+        for (int round = 0; round < 10; ++round)
+            for (std::size_t i = 0; i < n; ++i)
+                result += v[i];
+        elapsed = timer.elapsed();
+    }
+    else
+    {
+        cpplib::PackedVector<Bits> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            v.insert_back(std::uint32_t(i * 2654435761ULL) & ((1U << Bits) - 1));
+        if (method == "unpack(scalar)")
+            cpplib::simd::level() = cpplib::simd::Level::Scalar;
+        std::uint32_t buffer[chunk];
+        Timer timer;
+        for (int round = 0; round < 10; ++round)
+        {
+            if (method == "get")
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    result += v.get(i);
+                continue;
+            }
+            for (std::size_t i = 0; i < n; i += chunk)
+            {
+                std::size_t count = std::min(chunk, n - i);
+                v.unpack(i, count, buffer);
+                for (std::size_t j = 0; j < count; ++j)
+                    result += buffer[j];
+            }
+        }
+        elapsed = timer.elapsed();
+        cpplib::simd::level() = cpplib::simd::supported_level();
+    }
+    if (result == 0)
+        cerr << "result: " << result << endl;
+    return elapsed;
+}
+
+/**
+ * 用4路累加求n个值的和，打破浮点加法的依赖链，使两种存储方式都受限于内存访问.
+ *
+ * @param value: 返回第i个值的函数对象
+ *        n: 值的个数
+ * @return 所有值的和
+ */
+template<typename Function>
+double sum4(Function value, std::size_t n)
+{
+    double s[4] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        for (int k = 0; k < 4; ++k)
+            s[k] += value(i + k);
+    for (; i < n; ++i)
+        s[0] += value(i);
+    return s[0] + s[1] + s[2] + s[3];
+}
+
+/**
+ * 测量反复对点的x字段求和的时间，共访问1000000000行.
+ * 按行存储时每个缓存行只有1 / 4的数据有用；
+ * 按列存储时只读取x列，循环可以向量化.
+ *
+ * @param layout: 存储方式
+ *        rows: 点的个数
+ * @return 运行时间，单位为秒
+ */
+double timeOfFieldSum(const std::string& layout, int rows)
+{
+    const int rounds = 1000000000 / rows;
+    double result = 0;
+    double elapsed = 0;
+    if (layout == "Vector<Point>")
+    {
+        cpplib::Vector<Point> v(rows);
+        for (int i = 0; i < rows; ++i)
+            v.insert_back(Point{i * 0.5, 1.0, 2.0, i});
+        Timer timer;
+        for (int round = 0; round < rounds; ++round)
+            result += sum4([&v](std::size_t i) { return v[i].x; }, v.size());
+        elapsed = timer.elapsed();
+    }
+    else
+    {
+        cpplib::SoAVector<double, double, double, long> v;
+        v.reserve(rows);
+        for (int i = 0; i < rows; ++i)
+            v.insert_back(i * 0.5, 1.0, 2.0, i);
+        Timer timer;
+        for (int round = 0; round < rounds; ++round)
+        {
+            auto x = v.column<0>();
+            result += sum4([&x](std::size_t i) { return x[i]; }, x.size());
+        }
+        elapsed = timer.elapsed();
+    }
+    if (result < 0)
+        cerr << "result: " << result << endl;
+    return elapsed;
+}
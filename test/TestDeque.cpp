@@ -1,9 +1,16 @@
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <vector>
 #include "Deque.h"
 #include "gtest/gtest.h"
 
 using std::string;
+using cpplib::Deque;
 
 class TestDeque : public testing::Test
 {
@@ -52,7 +59,7 @@ TEST_F(TestDeque, Basic)
         Deque<string> s2(scale);
         Deque<string> s3(scale, "Hello World!");
         Deque<string> s4(s1);
-        Deque<string> s5(Deque<string>());
+        Deque<string> s5(std::move(s3));
 
         s1 = s2;
         s2 = Deque<string>(scale);
@@ -169,21 +176,21 @@ TEST_F(TestDeque, Modifiers)
             EXPECT_EQ(std::to_string(i), deque.back());
             deque.remove_back();
         }
-//
-//        for (size_t i = 0; i < scale; ++i)
-//            deque.insert(deque.begin(), std::to_string(i));
-//        for (size_t i = 0; i < scale; ++i)
-//        {
-//            EXPECT_EQ(std::to_string(i), deque.back());
-//            deque.remove(std::prev(deque.end());
-//        }
-//        for (size_t i = 0; i < scale; ++i)
-//            deque.insert(deque.end(), std::to_string(i));
-//        for (size_t i = 0; i < scale; ++i)
-//        {
-//            EXPECT_EQ(std::to_string(i), deque.front());
-//            deque.remove(deque.begin());
-//        }
+
+        for (size_t i = 0; i < scale; ++i)
+            deque.insert(deque.begin(), std::to_string(i));
+        for (size_t i = 0; i < scale; ++i)
+        {
+            EXPECT_EQ(std::to_string(i), deque.back());
+            deque.remove(std::prev(deque.end()));
+        }
+        for (size_t i = 0; i < scale; ++i)
+            deque.insert(deque.end(), std::to_string(i));
+        for (size_t i = 0; i < scale; ++i)
+        {
+            EXPECT_EQ(std::to_string(i), deque.front());
+            deque.remove(deque.begin());
+        }
     });
     EXPECT_THROW(deque.remove_back(), std::out_of_range);
     EXPECT_THROW(deque.remove_front(), std::out_of_range);
@@ -205,6 +212,534 @@ TEST_F(TestDeque, Modifiers)
     }
 }
 
+TEST_F(TestDeque, BlockCache)
+{
+    EXPECT_EQ(size_t(0), deque.block_cache_size());
+
+    // 队列稳定在固定长度时，队首释放的区块被队尾复用
+    insert_n(deque, scale * 64);
+    for (size_t i = 0; i < scale * 64; ++i)
+    {
+        deque.remove_front();
+        deque.insert_back(std::to_string(i));
+        EXPECT_LE(deque.block_cache_size(), size_t(1));
+    }
+    for (size_t i = 0; i < scale * 64; ++i)
+    {
+        EXPECT_EQ(std::to_string(i), deque.front());
+        deque.remove_front();
+    }
+    EXPECT_EQ(deque.block_cache_limit(), deque.block_cache_size());
+
+    deque.set_block_cache_limit(1);
+    EXPECT_EQ(size_t(1), deque.block_cache_limit());
+    EXPECT_EQ(size_t(1), deque.block_cache_size());
+    deque.trim_block_cache();
+    EXPECT_EQ(size_t(0), deque.block_cache_size());
+
+    deque.set_block_cache_limit(8);
+    insert_n(deque, scale * 64, false);
+    remove_n(deque, scale * 64, true);
+    EXPECT_EQ(size_t(8), deque.block_cache_size());
+    insert_n(deque, scale);
+    deque.shrink_to_fit();
+    EXPECT_EQ(size_t(0), deque.block_cache_size());
+    EXPECT_EQ(scale, deque.size());
+
+    deque.set_block_cache_limit(0);
+    insert_n(deque, scale * 64);
+    deque.clear();
+    EXPECT_EQ(size_t(0), deque.block_cache_size());
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(TestDeque, MapRecenter)
+{
+    // 队列式使用时区块映射不断向一端移动，需要平移回映射中央
+    size_t window = scale * 4;
+    size_t rounds = scale * 256;
+
+    insert_n(deque, window);
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        deque.insert_back(std::to_string(window + i));
+        deque.remove_front();
+    }
+    EXPECT_EQ(window, deque.size());
+    for (size_t i = 0; i < window; ++i)
+        EXPECT_EQ(std::to_string(rounds + i), deque[i]);
+
+    deque.clear();
+    insert_n(deque, window, false);
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        deque.insert_front(std::to_string(window + i));
+        deque.remove_back();
+    }
+    EXPECT_EQ(window, deque.size());
+    for (size_t i = 0; i < window; ++i)
+        EXPECT_EQ(std::to_string(rounds + i), deque[window - 1 - i]);
+}
+
+TEST_F(TestDeque, Algorithms)
+{
+    // 元素跨越多个区块，且首尾都不在区块边界上
+    Deque<int> x;
+    Deque<int> y;
+    size_t n = scale * 100;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        x.insert_back(int(i));
+        y.insert_front(0);
+    }
+    x.remove_front();
+    y.remove_back();
+
+    cpplib::copy(x.cbegin(), x.cend(), y.begin());
+    EXPECT_TRUE(x == y);
+    EXPECT_TRUE(cpplib::equal(x.begin(), x.end(), y.cbegin()));
+    y.back() = -1;
+    EXPECT_FALSE(x == y);
+    y.front() = -1;
+    EXPECT_FALSE(cpplib::equal(x.cbegin(), x.cend(), y.begin()));
+
+    std::vector<int> v(x.size());
+    cpplib::copy(x.begin(), x.end(), v.begin());
+    EXPECT_TRUE(cpplib::equal(x.begin(), x.end(), v.begin()));
+    for (size_t i = 0; i < v.size(); ++i)
+        EXPECT_EQ(int(i + 1), v[i]);
+
+    EXPECT_EQ(std::next(x.begin(), 499), cpplib::find(x.begin(), x.end(), 500));
+    EXPECT_EQ(x.cend(), cpplib::find(x.cbegin(), x.cend(), 0));
+    EXPECT_EQ(long(n * (n - 1) / 2), cpplib::accumulate(x.begin(), x.end(), 0L));
+
+    size_t count = 0;
+    cpplib::for_each(x.cbegin(), x.cend(), [&count](int) { ++count; });
+    EXPECT_EQ(x.size(), count);
+
+    cpplib::fill(std::next(y.begin()), std::prev(y.end()), 7);
+    EXPECT_EQ(-1, y.front());
+    EXPECT_EQ(-1, y.back());
+    EXPECT_EQ(y.end() - 1, cpplib::find(std::next(y.begin()), y.end(), -1));
+
+    insert_n(a, n);
+    Deque<string> d(a);
+    EXPECT_TRUE(a == d);
+    Deque<string> e(n, "Hello World!");
+    EXPECT_EQ(e.end(), cpplib::find(e.begin(), e.end(), string()));
+}
+
+TEST_F(TestDeque, BlockPolicy)
+{
+    using cpplib::BlockBytes;
+    using cpplib::BlockElements;
+
+    // 默认策略的区块大小向下取整到2的幂
+    EXPECT_EQ(size_t(128), Deque<int>::BLOCK_SIZE);
+    EXPECT_EQ(size_t(16), (Deque<char[24]>::BLOCK_SIZE));
+    EXPECT_EQ(size_t(1), (Deque<char[1024]>::BLOCK_SIZE));
+    EXPECT_EQ(size_t(1024), (Deque<int, BlockBytes<4096>>::BLOCK_SIZE));
+    EXPECT_EQ(size_t(3), (Deque<int, BlockElements<3>>::BLOCK_SIZE));
+
+    // 区块大小不是2的幂时，迭代器仍能正确跨越区块
+    Deque<int, BlockElements<3>> x;
+    for (size_t i = 0; i < scale; ++i)
+    {
+        x.insert_back(int(i));
+        x.insert_front(-int(i) - 1);
+    }
+    for (size_t i = 0; i < 2 * scale; ++i)
+        EXPECT_EQ(int(i) - int(scale), x[i]);
+    EXPECT_EQ(-1, *(x.end() - int(scale) - 1));
+    EXPECT_EQ(x.begin() + 5, x.end() - int(2 * scale - 5));
+    Deque<int, BlockElements<3>> y(x);
+    EXPECT_TRUE(x == y);
+
+    // 区块按策略指定的字节数对齐
+    Deque<char, BlockBytes<256, 64>> z;
+    for (size_t i = 0; i < scale * 64; ++i)
+    {
+        z.insert_back(char(i));
+        if (i % 256 == 0)
+        {
+            EXPECT_EQ(uintptr_t(0), reinterpret_cast<uintptr_t>(&z.back()) % 64);
+        }
+    }
+    for (size_t i = 0; i < scale * 64; ++i)
+    {
+        EXPECT_EQ(char(i), z.front());
+        z.remove_front();
+    }
+}
+
+TEST_F(TestDeque, RandomAccess)
+{
+    // 队首偏移不断变化时，移位和掩码定位与迭代器定位一致
+    Deque<int, cpplib::BlockElements<4>> x;
+    Deque<int, cpplib::BlockElements<5>> y;
+    for (size_t i = 0; i < scale; ++i)
+    {
+        x.insert_back(int(i));
+        y.insert_back(int(i));
+    }
+    for (size_t i = 0; i < scale; ++i)
+    {
+        x.remove_front();
+        y.remove_front();
+        x.insert_back(int(i + scale));
+        y.insert_back(int(i + scale));
+        for (size_t j = 0; j < scale; j += 7)
+        {
+            EXPECT_EQ(int(i + j + 1), x[j]);
+            EXPECT_EQ(int(i + j + 1), y[j]);
+            EXPECT_EQ(*(x.begin() + int(j)), x[j]);
+        }
+    }
+    x[0] = -1;
+    EXPECT_EQ(-1, x.front());
+}
+
+TEST_F(TestDeque, TrivialCopy)
+{
+    // 平凡可复制的元素按区块复制，队首偏移在区块中间
+    Deque<int, cpplib::BlockElements<8>> x;
+    for (size_t i = 0; i < scale * 4; ++i)
+        x.insert_back(int(i));
+    for (size_t i = 0; i < 3; ++i)
+        x.remove_front();
+    Deque<int, cpplib::BlockElements<8>> y(x);
+    EXPECT_EQ(x.size(), y.size());
+    EXPECT_TRUE(x == y);
+    y.insert_front(-1);
+    y.insert_back(-1);
+    EXPECT_EQ(x.size() + 2, y.size());
+    EXPECT_EQ(3, y[1]);
+
+    // 不是平凡可复制的元素逐个复制构造
+    insert_n(a, scale * 4);
+    remove_n(a, 3, false);
+    Deque<string> d(a);
+    EXPECT_TRUE(a == d);
+    EXPECT_EQ("3", d.front());
+
+    // 空双端队列和只有部分区块的双端队列
+    Deque<int> e;
+    Deque<int> f(e);
+    EXPECT_TRUE(f.empty());
+    Deque<int, cpplib::BlockElements<8>> g;
+    g.insert_back(1);
+    g.insert_front(0);
+    Deque<int, cpplib::BlockElements<8>> h(g);
+    EXPECT_EQ(0, h.front());
+    EXPECT_EQ(1, h.back());
+}
+
+TEST_F(TestDeque, IncrementalGrowth)
+{
+    Deque<int, cpplib::BlockElements<2>> x;
+    EXPECT_FALSE(x.incremental_growth());
+    x.set_incremental_growth(true);
+    EXPECT_TRUE(x.incremental_growth());
+
+    // 两端交替添加，映射在添加过程中增量扩容
+    for (size_t i = 0; i < scale * 64; ++i)
+    {
+        x.insert_back(int(i));
+        x.insert_front(-int(i) - 1);
+    }
+    for (size_t i = 0; i < scale * 128; ++i)
+        EXPECT_EQ(int(i) - int(scale * 64), x[i]);
+
+    // 队列用法，区块映射不断向一端漂移
+    Deque<int, cpplib::BlockElements<2>> y;
+    y.set_incremental_growth(true);
+    for (size_t i = 0; i < scale * 64; ++i)
+        y.insert_back(int(i));
+    for (size_t i = scale * 64; i < scale * 1024; ++i)
+    {
+        y.insert_back(int(i));
+        EXPECT_EQ(int(i - scale * 64), y.front());
+        y.remove_front();
+    }
+
+    // 扩容进行中复制、移动、交换、收缩和清空
+    Deque<int, cpplib::BlockElements<2>> z;
+    z.set_incremental_growth(true);
+    for (size_t n = 1; n < scale * 16; ++n)
+    {
+        z.insert_back(int(n));
+        Deque<int, cpplib::BlockElements<2>> copy(z);
+        EXPECT_TRUE(copy == z);
+        Deque<int, cpplib::BlockElements<2>> moved(std::move(copy));
+        moved.insert_front(0);
+        EXPECT_EQ(z.size() + 1, moved.size());
+        moved.swap(copy);
+        copy.shrink_to_fit();
+        copy.insert_back(1);
+        EXPECT_EQ(0, copy.front());
+        copy.clear();
+        copy.insert_front(1);
+        EXPECT_EQ(size_t(1), copy.size());
+    }
+    z.set_incremental_growth(false);
+    for (size_t i = 0; i < scale * 16 - 1; ++i)
+        EXPECT_EQ(int(i + 1), z[i]);
+}
+
+TEST_F(TestDeque, IncrementalGrowthBulkInsert)
+{
+    // 区块映射向一端漂移，每次添加区块都可能正在增量扩容；
+    // 同时在另一端或靠近另一端的位置批量添加，添加的区块数超过影子映射预留的空闲位置
+    std::vector<int> chunk(scale * 8);
+    for (size_t i = 0; i < chunk.size(); ++i)
+        chunk[i] = -int(i) - 1;
+    for (int c = 0; c < 6; ++c)
+    {
+        bool to_back = c < 3;
+        Deque<int, cpplib::BlockElements<2>> x;
+        std::deque<int> expected;
+        x.set_incremental_growth(true);
+        for (int i = 0; i < int(scale * 8); ++i)
+        {
+            x.insert_back(i);
+            expected.push_back(i);
+        }
+        for (int i = 0; i < int(scale * 32); ++i)
+        {
+            size_t pos = to_back ? x.size() / 4 : x.size() - x.size() / 4;
+            if (to_back)
+            {
+                x.insert_back(i);
+                x.remove_front();
+                expected.push_back(i);
+                expected.pop_front();
+            }
+            else
+            {
+                x.insert_front(i);
+                x.remove_back();
+                expected.push_front(i);
+                expected.pop_back();
+            }
+            switch (c % 3)
+            {
+            case 0:
+                if (to_back)
+                    x.insert_front(chunk.begin(), chunk.end());
+                else
+                    x.insert_back(chunk.begin(), chunk.end());
+                break;
+            case 1:
+                x.insert(x.begin() + pos, chunk.begin(), chunk.end());
+                break;
+            default:
+                x.insert(x.begin() + pos, chunk.size(), -1);
+                break;
+            }
+            if (c % 3 == 2)
+                expected.insert(expected.begin() + pos, chunk.size(), -1);
+            else if (c % 3 == 1)
+                expected.insert(expected.begin() + pos, chunk.begin(), chunk.end());
+            else if (to_back)
+                expected.insert(expected.begin(), chunk.begin(), chunk.end());
+            else
+                expected.insert(expected.end(), chunk.begin(), chunk.end());
+            ASSERT_EQ(expected.size(), x.size());
+            if (i % 64 == 0)
+            {
+                ASSERT_TRUE(std::equal(expected.begin(), expected.end(), x.begin()));
+            }
+            // 从映射的空闲一端移除，元素个数恢复
+            for (size_t k = 0; k < chunk.size(); ++k)
+            {
+                if (to_back)
+                {
+                    x.remove_front();
+                    expected.pop_front();
+                }
+                else
+                {
+                    x.remove_back();
+                    expected.pop_back();
+                }
+            }
+        }
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), x.begin()));
+    }
+}
+
+TEST_F(TestDeque, IncrementalGrowthMixed)
+{
+    // 增量扩容期间交替进行逐个添加和批量添加、移除，区块映射向尾部漂移
+    Deque<int, cpplib::BlockElements<2>> x;
+    std::deque<int> expected;
+    x.set_incremental_growth(true);
+    unsigned seed = 1;
+    for (int i = 0; i < int(scale * 256); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t pos = (seed >> 8) % (expected.size() / 4 + 1);
+        size_t count = (seed >> 4) % (scale * 8);
+        x.insert_back(i);
+        expected.push_back(i);
+        switch ((seed >> 24) % 4)
+        {
+        case 0:
+            x.insert(x.begin() + pos, {i, i + 1, i + 2, i + 3, i + 4});
+            expected.insert(expected.begin() + pos, {i, i + 1, i + 2, i + 3, i + 4});
+            break;
+        case 1:
+            x.insert(x.begin() + pos, count, i);
+            expected.insert(expected.begin() + pos, count, i);
+            break;
+        case 2:
+            count = std::min(expected.size(), count);
+            x.remove(x.begin(), x.begin() + count);
+            expected.erase(expected.begin(), expected.begin() + count);
+            break;
+        default:
+            x.remove_front();
+            expected.pop_front();
+            break;
+        }
+        ASSERT_EQ(expected.size(), x.size());
+    }
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), x.begin()));
+    Deque<int, cpplib::BlockElements<2>> copy;
+    copy = x;
+    EXPECT_TRUE(copy == x);
+}
+
+TEST_F(TestDeque, Emplace)
+{
+    Deque<std::pair<int, string>> x;
+    x.emplace_back(1, "b");
+    x.emplace_front(0, "a");
+    x.emplace_back(3, "d");
+    auto it = x.emplace(x.begin() + 2, 2, "c");
+    EXPECT_EQ(2, it->first);
+    EXPECT_EQ(size_t(4), x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_EQ(int(i), x[i].first);
+        EXPECT_EQ(string(1, char('a' + i)), x[i].second);
+    }
+
+    // 在前半部分和后半部分插入，跨越区块
+    Deque<int, cpplib::BlockElements<4>> y;
+    for (size_t i = 0; i < scale; i += 2)
+        y.insert_back(int(i));
+    for (size_t i = 1; i < scale; i += 2)
+        y.emplace(y.begin() + int(i), int(i));
+    for (size_t i = 0; i < scale; ++i)
+        EXPECT_EQ(int(i), y[i]);
+}
+
+TEST_F(TestDeque, RangeInsert)
+{
+    std::vector<int> v;
+    for (size_t i = 0; i < scale * 8; ++i)
+        v.push_back(int(i));
+
+    // 由迭代器范围和初始化列表构造
+    Deque<int, cpplib::BlockElements<4>> x(v.begin(), v.end());
+    EXPECT_EQ(v.size(), x.size());
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), x.begin()));
+    Deque<int> y = {0, 1, 2};
+    EXPECT_EQ(size_t(3), y.size());
+    EXPECT_EQ(2, y.back());
+    y = {3, 4};
+    EXPECT_EQ(3, y.front());
+
+    // 两端批量添加，保持元素顺序
+    Deque<int, cpplib::BlockElements<4>> z;
+    z.insert_back(v.begin() + int(scale * 4), v.end());
+    z.insert_front(v.begin(), v.begin() + int(scale * 4));
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), z.begin()));
+    z.insert(z.begin(), size_t(5), -1);
+    z.insert(z.end(), size_t(5), -2);
+    EXPECT_EQ(v.size() + 10, z.size());
+    EXPECT_EQ(-1, z[4]);
+    EXPECT_EQ(int(0), z[5]);
+    EXPECT_EQ(-2, z.back());
+
+    // 中间位置插入
+    Deque<int, cpplib::BlockElements<4>> w = {0, 5};
+    w.insert(w.begin() + 1, {1, 2, 3, 4});
+    w.insert(w.end() - 1, size_t(2), w[4]);
+    for (size_t i = 0; i < 5; ++i)
+        EXPECT_EQ(int(i), w[i]);
+    EXPECT_EQ(4, w[5]);
+    EXPECT_EQ(4, w[6]);
+    EXPECT_EQ(5, w[7]);
+
+    // 单遍迭代器
+    std::istringstream in("1 2 3");
+    Deque<int> u;
+    u.insert_front(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    EXPECT_EQ(size_t(3), u.size());
+    EXPECT_EQ(1, u.front());
+    EXPECT_EQ(3, u.back());
+
+    // 不是平凡可复制的元素
+    Deque<string> s(3, "x");
+    std::vector<string> t(scale * 4, "y");
+    s.insert_front(t.begin(), t.end());
+    s.insert_back(t.begin(), t.end());
+    EXPECT_EQ(scale * 8 + 3, s.size());
+    EXPECT_EQ("x", s[scale * 4 + 1]);
+}
+
+TEST_F(TestDeque, MiddleModifiers)
+{
+    // 与std::deque对照，在随机位置添加和移除元素
+    Deque<string, cpplib::BlockElements<4>> x;
+    std::deque<string> y;
+    unsigned seed = 1;
+    for (size_t k = 0; k < scale * 64; ++k)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t r = seed >> 8;
+        size_t i = y.empty() ? 0 : r % (y.size() + 1);
+        size_t n = r / 7 % 9 + 1;
+        string value = std::to_string(k);
+        switch (r % 5)
+        {
+        case 0:
+            x.insert(x.begin() + int(i), value);
+            y.insert(y.begin() + int(i), value);
+            break;
+        case 1:
+            x.insert(x.begin() + int(i), n, value);
+            y.insert(y.begin() + int(i), n, value);
+            break;
+        case 2:
+        {
+            std::vector<string> v(n, value);
+            for (size_t j = 0; j < n; ++j)
+                v[j] += std::to_string(j);
+            x.insert(x.begin() + int(i), v.begin(), v.end());
+            y.insert(y.begin() + int(i), v.begin(), v.end());
+            break;
+        }
+        default:
+            n = std::min(n - 1, y.size() - i);
+            x.remove(x.begin() + int(i), x.begin() + int(i + n));
+            y.erase(y.begin() + int(i), y.begin() + int(i + n));
+            break;
+        }
+        ASSERT_EQ(y.size(), x.size());
+        ASSERT_TRUE(std::equal(y.begin(), y.end(), x.begin()));
+    }
+    x.insert(x.begin() + 1, size_t(0), "");
+    EXPECT_EQ(y.size(), x.size());
+    EXPECT_THROW(x.remove(x.end(), x.end() + 1), std::out_of_range);
+    EXPECT_THROW(x.remove(x.begin() + 1, x.begin()), std::out_of_range);
+    x.remove(x.begin(), x.end());
+    EXPECT_TRUE(x.empty());
+}
+
 TEST_F(TestDeque, Other)
 {
     using std::swap;
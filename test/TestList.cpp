@@ -1,46 +1,55 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 #include "List.h"
 #include "gtest/gtest.h"
 
 using std::string;
+using cpplib::List;
+using cpplib::PoolAllocator;
 
-class TestList : public testing::Test 
+class TestList : public testing::Test
 {
 protected:
     List<string> list;
     List<string> a;
     List<string> b;
     List<string> c;
-    string str;    
-    int scale;
+    string str;
+    size_t scale;
 public:
     virtual void SetUp() { scale = 32; }
     virtual void TearDown() {}
 
-    void insert_n(List<string>& s, int n, bool from_back = true)
+    void insert_n(List<string>& s, size_t n, bool from_back = true)
     {
         if (from_back)
         {
-            for (int i = 0; i < n; ++i) 
+            for (size_t i = 0; i < n; ++i)
                 s.insert_back(std::to_string(i));
         }
         else
         {
-            for (int i = 0; i < n; ++i) 
+            for (size_t i = 0; i < n; ++i)
                 s.insert_front(std::to_string(i));
         }
     }
-    void remove_n(List<string>& s, int n, bool from_back = true)
+    void remove_n(List<string>& s, size_t n, bool from_back = true)
     {
         if (from_back)
         {
-            for (int i = 0; i < n; ++i) 
+            for (size_t i = 0; i < n; ++i)
                 s.remove_back();
         }
         else
         {
-            for (int i = 0; i < n; ++i) 
+            for (size_t i = 0; i < n; ++i)
                 s.remove_front();
         }
     }
@@ -51,10 +60,11 @@ TEST_F(TestList, Basic)
     EXPECT_NO_THROW({
         List<string> s1;
         List<string> s2(s1);
-        List<string> s3(List<string>());
+        List<string> s3(std::move(s2));
 
         s1 = s2;
         s2 = List<string>();
+        s3 = s1;
     });
 }
 
@@ -63,31 +73,36 @@ TEST_F(TestList, ElementAccess)
     EXPECT_THROW(list.front(), std::out_of_range);
     EXPECT_THROW(list.back(), std::out_of_range);
     EXPECT_NO_THROW({
-        for (int i = 0; i < scale; ++i)
+        for (size_t i = 0; i < scale; ++i)
         {
             str = std::to_string(i);
             list.insert_back(str);
             EXPECT_EQ(str, list.back());
         }
-        for (int i = 0; i < scale; ++i)
+        for (size_t i = 0; i < scale; ++i)
         {
             str = std::to_string(i);
             list.insert_front(str);
             EXPECT_EQ(str, list.front());
         }
-        for (int i = 0; i < scale; ++i)
+        for (size_t i = 0; i < scale; ++i)
         {
-            str = list.front();
-            EXPECT_EQ(str, list.remove_front());
+            EXPECT_EQ(std::to_string(scale - 1 - i), list.front());
+            list.remove_front();
         }
-        for (int i = 0; i < scale; ++i)
+        for (size_t i = 0; i < scale; ++i)
         {
-            str = list.back();
-            EXPECT_EQ(str, list.remove_back());
+            EXPECT_EQ(std::to_string(scale - 1 - i), list.back());
+            list.remove_back();
         }
     });
     EXPECT_THROW(list.front(), std::out_of_range);
     EXPECT_THROW(list.back(), std::out_of_range);
+
+    insert_n(list, scale);
+    for (size_t i = 0; i < scale; ++i)
+        EXPECT_EQ(std::to_string(i), list.at(i));
+    EXPECT_THROW(list.at(scale), std::out_of_range);
 }
 
 TEST_F(TestList, Iterators)
@@ -95,28 +110,33 @@ TEST_F(TestList, Iterators)
     EXPECT_EQ(list.begin(), list.end());
     insert_n(list, scale);
     EXPECT_NE(list.begin(), list.end());
-    
+
     auto bg = list.begin();
     auto ed = list.end();
 
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), *bg++);
     EXPECT_EQ(bg, list.end());
-    for (int i = scale - 1; i >= 0; --i)
-        EXPECT_EQ(std::to_string(i), *--ed);
+    for (size_t i = scale; i > 0; --i)
+        EXPECT_EQ(std::to_string(i - 1), *--ed);
     EXPECT_EQ(ed, list.begin());
+
+    size_t i = scale;
+    for (auto it = list.crbegin(); it != list.crend(); ++it)
+        EXPECT_EQ(std::to_string(--i), *it);
+    EXPECT_EQ(size_t(1), list.cbegin()->size());
 }
 
 TEST_F(TestList, Capacity)
 {
     EXPECT_TRUE(list.empty());
-    EXPECT_EQ(0, list.size());
+    EXPECT_EQ(size_t(0), list.size());
 
     insert_n(list, scale, true);
     EXPECT_EQ(scale, list.size());
     remove_n(list, scale, true);
     EXPECT_TRUE(list.empty());
-    
+
     insert_n(list, scale, false);
     EXPECT_EQ(scale, list.size());
     remove_n(list, scale, false);
@@ -127,42 +147,57 @@ TEST_F(TestList, Modifiers)
 {
     EXPECT_THROW(list.remove_back(), std::out_of_range);
     EXPECT_THROW(list.remove_front(), std::out_of_range);
+    EXPECT_THROW(list.remove(list.end()), std::out_of_range);
     EXPECT_NO_THROW({
-        insert_n(list, scale, true);
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), list.remove_back());
-        insert_n(list, scale, false);
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), list.remove_front());
-
-        for (int i = 0; i < scale; ++i)
-            list.insert(0, std::to_string(i));
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), list.remove(0));
-        for (int i = 0; i < scale; ++i)
-            list.insert(i, std::to_string(i));
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), list.remove(i));
+        for (size_t i = 0; i < scale; ++i)
+            list.insert(list.begin(), std::to_string(i));
+        for (size_t i = scale; i > 0; --i)
+        {
+            EXPECT_EQ(std::to_string(i - 1), list.front());
+            list.remove(list.begin());
+        }
+        for (size_t i = 0; i < scale; ++i)
+            list.insert(list.end(), std::to_string(i));
+        // 在中间位置添加和移除
+        auto it = list.begin();
+        std::advance(it, scale / 2);
+        list.insert(it, "x");
+        EXPECT_EQ("x", list.at(scale / 2));
+        EXPECT_EQ(std::to_string(scale / 2), list.at(scale / 2 + 1));
+        list.remove(std::prev(it));
+        EXPECT_EQ(std::to_string(scale / 2), list.at(scale / 2));
+        auto p = list.emplace(it, 3, 'a');
+        EXPECT_EQ("aaa", *p);
+        list.remove(p);
     });
-    EXPECT_THROW(list.remove_back(), std::out_of_range);
-    EXPECT_THROW(list.remove_front(), std::out_of_range);
+    EXPECT_EQ(scale, list.size());
 
-    insert_n(list, scale);
     list.clear();
     EXPECT_TRUE(list.empty());
-    EXPECT_EQ(0, list.size());
+    EXPECT_EQ(size_t(0), list.size());
     EXPECT_THROW(list.remove_back(), std::out_of_range);
 
     insert_n(list, scale);
     a = a + list;
     b += list;
-    for (int i = 0; i < scale; ++i)
-        EXPECT_EQ(a.remove_back(), b.remove_back());
-    
+    for (size_t i = 0; i < scale; ++i)
+    {
+        EXPECT_EQ(a.back(), b.back());
+        a.remove_back();
+        b.remove_back();
+    }
+    list += list;
+    EXPECT_EQ(scale * 2, list.size());
+    EXPECT_EQ(std::to_string(scale - 1), list.back());
+
     c.swap(list);
-    EXPECT_EQ(scale, c.size());
-    for (int i = scale - 1; i >= 0; --i)
-        EXPECT_EQ(std::to_string(i), c.remove_back());
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(scale * 2, c.size());
+    for (size_t i = scale; i > 0; --i)
+    {
+        EXPECT_EQ(std::to_string(i - 1), c.back());
+        c.remove_back();
+    }
 }
 
 TEST_F(TestList, Other)
@@ -175,4 +210,199 @@ TEST_F(TestList, Other)
     EXPECT_TRUE(c != a && c == b);
     swap(a, b);
     EXPECT_TRUE(c == a && c != b);
-}
\ No newline at end of file
+
+    // 移动后的链表为空，仍然可以使用
+    List<string> d(std::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(c == d);
+    a.insert_back("0");
+    EXPECT_EQ("0", a.front());
+
+    std::ostringstream os;
+    List<int> x;
+    x.insert_back(1);
+    x.insert_back(2);
+    os << x;
+    EXPECT_EQ("1 2 ", os.str());
+}
+
+TEST_F(TestList, Allocator)
+{
+    // 复制的结点来自同一个块组，地址连续
+    insert_n(a, scale);
+    List<string> copy(a);
+    EXPECT_TRUE(copy == a);
+    EXPECT_TRUE(copy.get_allocator() != a.get_allocator());
+    std::ptrdiff_t stride = &*std::next(copy.begin()) - &copy.front();
+    EXPECT_GT(stride, 0);
+    for (auto it = copy.begin(); std::next(it) != copy.end(); ++it)
+        EXPECT_EQ(stride, &*std::next(it) - &*it);
+
+    // 移除的结点被复用，不申请新的空间
+    std::uintptr_t front = reinterpret_cast<std::uintptr_t>(&a.front());
+    a.remove_front();
+    a.insert_back("x");
+    EXPECT_EQ(front, reinterpret_cast<std::uintptr_t>(&a.back()));
+
+    // 分配器随结点一起移动和交换
+    PoolAllocator<string> alloc = a.get_allocator();
+    List<string> moved(std::move(a));
+    EXPECT_TRUE(moved.get_allocator() == alloc);
+    EXPECT_TRUE(a.get_allocator() != alloc);
+    b.insert_back("b");
+    swap(moved, b);
+    EXPECT_TRUE(b.get_allocator() == alloc);
+    EXPECT_EQ(scale, b.size());
+    b = List<string>();
+    a = moved;
+    EXPECT_EQ("b", a.front());
+
+    // 共享分配器的链表
+    List<string> shared(alloc);
+    shared.insert_back("shared");
+    EXPECT_TRUE(shared.get_allocator() == alloc);
+
+    // 标准库分配器
+    List<string, std::allocator<string>> s1;
+    s1.insert_back("1");
+    List<string, std::allocator<string>> s2(s1);
+    s2 += s1;
+    EXPECT_EQ(size_t(2), s2.size());
+}
+
+TEST_F(TestList, Splice)
+{
+    // 转移结点不复制元素，元素的地址不变
+    insert_n(a, scale);
+    insert_n(b, scale);
+    const string* first = &a.front();
+    const string* last = &a.back();
+    list.splice(list.end(), a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(scale, list.size());
+    EXPECT_EQ(first, &list.front());
+    EXPECT_EQ(last, &list.back());
+    EXPECT_TRUE(list.get_allocator() == a.get_allocator());
+
+    // 转移部分结点到中间位置
+    auto from = std::next(b.cbegin(), 10);
+    auto to = std::next(b.cbegin(), 20);
+    const string* ten = &*from;
+    list.splice(std::next(list.cbegin()), b, from, to);
+    EXPECT_EQ(scale + 10, list.size());
+    EXPECT_EQ(scale - 10, b.size());
+    EXPECT_EQ(ten, &list.at(1));
+    EXPECT_EQ("19", list.at(10));
+    EXPECT_EQ("1", list.at(11));
+    EXPECT_EQ("20", b.at(10));
+
+    // 在同一个链表中移动一段结点
+    list.splice(list.cend(), list, list.cbegin(), std::next(list.cbegin(), 11));
+    EXPECT_EQ(scale + 10, list.size());
+    EXPECT_EQ("1", list.front());
+    EXPECT_EQ("19", list.back());
+    list.splice(list.cend(), list);
+    EXPECT_EQ(scale + 10, list.size());
+
+    // 分配器不能共享内存池时逐个移动元素
+    PoolAllocator<string> alloc = b.get_allocator();
+    c.insert_back("c");
+    c.splice(c.cbegin(), b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(scale - 9, c.size());
+    EXPECT_EQ("0", c.front());
+    EXPECT_EQ("c", c.back());
+    EXPECT_TRUE(c.get_allocator() != alloc);
+
+    // 右值的+和+=直接转移结点
+    List<string> d;
+    insert_n(d, scale);
+    first = &d.front();
+    List<string> x;
+    x.insert_back("x");
+    List<string> sum = x + std::move(d);
+    EXPECT_EQ(scale + 1, sum.size());
+    EXPECT_EQ(first, &*std::next(sum.begin()));
+    List<string> y;
+    y.insert_back("y");
+    sum += std::move(y);
+    EXPECT_EQ(scale + 2, sum.size());
+    EXPECT_EQ("y", sum.back());
+}
+
+TEST_F(TestList, MergeAndSort)
+{
+    // 按第一个分量比较，第二个分量记录原来的顺序
+    using Pair = std::pair<int, int>;
+    auto by_key = [](const Pair& x, const Pair& y) { return x.first < y.first; };
+    List<Pair> l1;
+    List<Pair> l2;
+    for (int i = 0; i < 100; ++i)
+    {
+        l1.insert_back(Pair(i / 3 * 2, i));
+        l2.insert_back(Pair(i / 2 * 3, 100 + i));
+    }
+    std::vector<Pair> expected(l1.begin(), l1.end());
+    expected.insert(expected.end(), l2.begin(), l2.end());
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    l1.merge(l2, by_key);
+    EXPECT_TRUE(l2.empty());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), l1.begin()));
+    EXPECT_EQ(expected.size(), l1.size());
+
+    // 稳定排序，结果与std::stable_sort相同
+    List<Pair> l3;
+    unsigned seed = 1;
+    for (int i = 0; i < 1000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        l3.insert_back(Pair(int(seed >> 24), i));
+    }
+    const Pair* front = &l3.front();
+    expected.assign(l3.begin(), l3.end());
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    l3.sort(by_key);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), l3.begin()));
+    EXPECT_EQ(size_t(1000), l3.size());
+    bool found = false;
+    for (auto& p : l3)
+        found = found || &p == front;
+    EXPECT_TRUE(found);
+    // prev指针正确
+    auto it = l3.end();
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit)
+        EXPECT_EQ(*rit, *--it);
+
+    // 默认比较和自定义比较
+    List<int> ints;
+    for (int i = 0; i < 37; ++i)
+        ints.insert_back((i * 17) % 37);
+    ints.sort();
+    for (int i = 0; i < 37; ++i)
+        EXPECT_EQ(i, ints.at(i));
+    ints.sort(std::greater<int>());
+    EXPECT_EQ(36, ints.front());
+    EXPECT_EQ(0, ints.back());
+    List<int> odd;
+    for (int i = 1; i < 10; i += 2)
+        odd.insert_back(i);
+    ints.sort();
+    ints.merge(std::move(odd));
+    EXPECT_EQ(size_t(42), ints.size());
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+
+    // 比较函数抛出异常时不丢失结点
+    int count = 0;
+    auto throwing = [&count](int x, int y)
+    {
+        if (++count == 50)
+            throw std::runtime_error("compare");
+        return x < y;
+    };
+    EXPECT_THROW(ints.sort(throwing), std::runtime_error);
+    EXPECT_EQ(size_t(42), ints.size());
+    EXPECT_EQ(std::ptrdiff_t(42), std::distance(ints.begin(), ints.end()));
+    EXPECT_EQ(std::ptrdiff_t(42), std::distance(ints.rbegin(), ints.rend()));
+    ints.sort();
+    EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+}
@@ -0,0 +1,219 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include "MmapVector.h"
+#include "gtest/gtest.h"
+
+using cpplib::MmapMode;
+using cpplib::MmapVector;
+
+class TestMmapVector : public testing::Test
+{
+protected:
+    std::string path;
+    size_t scale;
+public:
+    virtual void SetUp()
+    {
+        scale = 5000;
+        path = testing::TempDir() + "TestMmapVector.bin";
+        std::remove(path.c_str());
+    }
+    virtual void TearDown() { std::remove(path.c_str()); }
+
+    // 返回文件的字节数
+    size_t file_size()
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return size_t(in.tellg());
+    }
+    // 写入0到n - 1并关闭
+    void write_n(size_t n)
+    {
+        MmapVector<int> v(path);
+        for (size_t i = 0; i < n; ++i)
+            v.insert_back(int(i));
+    }
+};
+
+TEST_F(TestMmapVector, Basic)
+{
+    EXPECT_NO_THROW({
+        MmapVector<int> v1;
+        MmapVector<int> v2(std::move(v1));
+        MmapVector<int> v3(path);
+        v1 = std::move(v3);
+    });
+    EXPECT_THROW(MmapVector<int>("/nonexistent/TestMmapVector.bin"), std::system_error);
+    EXPECT_THROW(MmapVector<int>(path + ".missing", MmapMode::ReadOnly), std::system_error);
+
+    // 文件大小不是元素大小的整数倍
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "abcde";
+    }
+    EXPECT_THROW(MmapVector<int>(path, MmapMode::ReadOnly), std::runtime_error);
+}
+
+TEST_F(TestMmapVector, ReadWrite)
+{
+    write_n(scale);
+    // 析构时文件截断到元素个数
+    EXPECT_EQ(scale * sizeof(int), file_size());
+    {
+        MmapVector<int> v(path);
+        EXPECT_EQ(scale, v.size());
+        EXPECT_EQ(scale, v.capacity());
+        for (size_t i = 0; i < scale; ++i)
+            EXPECT_EQ(int(i), v[i]);
+        v[0] = -1;
+        v.remove_back();
+        v.insert(v.begin() + 1, 100);
+        v.sync();
+    }
+    const MmapVector<int> v(path, MmapMode::ReadOnly);
+    EXPECT_EQ(scale, v.size());
+    EXPECT_EQ(-1, v.front());
+    EXPECT_EQ(100, v.at(1));
+    EXPECT_EQ(1, v.at(2));
+    EXPECT_EQ(int(scale - 2), v.back());
+    EXPECT_THROW(v.at(scale), std::out_of_range);
+}
+
+TEST_F(TestMmapVector, ReadOnly)
+{
+    write_n(scale);
+    MmapVector<int> v(path, MmapMode::ReadOnly);
+    EXPECT_EQ(MmapMode::ReadOnly, v.open_mode());
+    EXPECT_THROW(v.insert_back(0), std::logic_error);
+    EXPECT_THROW(v.remove_back(), std::logic_error);
+    EXPECT_THROW(v.resize(1), std::logic_error);
+    EXPECT_THROW(v.reserve(scale * 2), std::logic_error);
+    EXPECT_THROW(v.clear(), std::logic_error);
+    // 不能取得可修改元素的迭代器或引用
+    EXPECT_THROW(v[0], std::logic_error);
+    EXPECT_THROW(v.at(0), std::logic_error);
+    EXPECT_THROW(v.front(), std::logic_error);
+    EXPECT_THROW(v.back(), std::logic_error);
+    EXPECT_THROW(v.begin(), std::logic_error);
+    EXPECT_THROW(v.rbegin(), std::logic_error);
+    EXPECT_THROW(v.find(7), std::logic_error);
+
+    // 通过const对象读取元素
+    const MmapVector<int>& c = v;
+    EXPECT_EQ(scale, c.size());
+    EXPECT_EQ(0, c[0]);
+    EXPECT_EQ(1, c.at(1));
+    EXPECT_EQ(int(scale - 1), c.back());
+    EXPECT_EQ(c.begin() + 7, c.find(7));
+    EXPECT_EQ(size_t(1), c.count(7));
+    EXPECT_EQ((long long)(scale * (scale - 1) / 2), c.sum());
+    EXPECT_EQ(scale * sizeof(int), file_size());
+
+    // 关闭后不关联文件，可以作为匿名映射的对象使用
+    v.close();
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(MmapMode::ReadWrite, v.open_mode());
+    v.insert_back(1);
+    EXPECT_EQ(1, v[0]);
+    EXPECT_EQ(scale * sizeof(int), file_size());
+}
+
+TEST_F(TestMmapVector, CopyOnWrite)
+{
+    write_n(scale);
+    {
+        MmapVector<int> v(path, MmapMode::CopyOnWrite);
+        v[0] = -1;
+        EXPECT_EQ(-1, v.front());
+        // 扩容后元素复制到匿名映射
+        for (size_t i = 0; i < scale; ++i)
+            v.insert_back(int(i));
+        EXPECT_EQ(scale * 2, v.size());
+        EXPECT_EQ(-1, v[0]);
+        EXPECT_EQ(int(scale - 1), v[scale - 1]);
+        EXPECT_EQ(int(scale - 1), v.back());
+        v.clear();
+        v.shrink_to_fit();
+        EXPECT_EQ(size_t(0), v.capacity());
+    }
+    // 修改不写回文件
+    const MmapVector<int> v(path, MmapMode::ReadOnly);
+    EXPECT_EQ(scale, v.size());
+    EXPECT_EQ(0, v.front());
+    EXPECT_EQ(scale * sizeof(int), file_size());
+}
+
+TEST_F(TestMmapVector, Capacity)
+{
+    MmapVector<int> v(path);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(size_t(0), v.capacity());
+    v.reserve(scale * 4);
+    EXPECT_EQ(scale * 4, v.capacity());
+    EXPECT_EQ(scale * 4 * sizeof(int), file_size());
+    v.resize(scale, 7);
+    EXPECT_EQ(7, v.back());
+    v.resize(scale * 8);
+    EXPECT_EQ(0, v.back());
+    EXPECT_LE(scale * 8 * sizeof(int), file_size());
+    // 显式关闭时截断文件到元素个数
+    {
+        MmapVector<int> w(path + ".close");
+        w.reserve(scale);
+        w.insert_back(1);
+        w.close();
+        EXPECT_TRUE(w.empty());
+        EXPECT_EQ(size_t(0), w.capacity());
+        std::ifstream in(path + ".close", std::ios::binary | std::ios::ate);
+        EXPECT_EQ(sizeof(int), size_t(in.tellg()));
+        std::remove((path + ".close").c_str());
+    }
+    // 移除元素按增长策略收缩，文件随之缩小
+    while (v.size() > 10)
+        v.remove_back();
+    EXPECT_GT(scale, v.capacity());
+    EXPECT_EQ(v.capacity() * sizeof(int), file_size());
+    v.shrink_to_fit();
+    EXPECT_EQ(size_t(10), v.capacity());
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(size_t(0), v.capacity());
+    EXPECT_EQ(size_t(0), file_size());
+    v.insert_back(1);
+    EXPECT_EQ(1, v.front());
+}
+
+TEST_F(TestMmapVector, Other)
+{
+    // 不关联文件的对象使用匿名映射
+    MmapVector<int> a;
+    MmapVector<int> b;
+    int x[] = {1, 2, 3};
+    a.append(x, x + 3);
+    b.append(x, x + 3);
+    EXPECT_TRUE(a == b);
+    b.remove(b.begin());
+    EXPECT_TRUE(a != b);
+    EXPECT_THROW(b.remove(b.end()), std::out_of_range);
+    EXPECT_THROW(b.insert(b.end() + 1, 0), std::out_of_range);
+
+    using std::swap;
+    swap(a, b);
+    EXPECT_EQ(size_t(2), a.size());
+    std::ostringstream os;
+    os << a;
+    EXPECT_EQ("2 3 ", os.str());
+
+    // 移动后文件由新对象负责关闭和截断
+    write_n(3);
+    MmapVector<int> c(path);
+    c.insert_back(3);
+    MmapVector<int> d(std::move(c));
+    EXPECT_TRUE(c.empty());
+    d.insert_back(4);
+    d = MmapVector<int>();
+    EXPECT_EQ(5 * sizeof(int), file_size());
+}
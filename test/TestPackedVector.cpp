@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <vector>
+#include "PackedVector.h"
+#include "gtest/gtest.h"
+
+using cpplib::BlockPackedVector;
+using cpplib::PackedVector;
+using cpplib::simd::Level;
+namespace simd = cpplib::simd;
+
+class TestPackedVector : public testing::Test
+{
+protected:
+    std::vector<Level> levels;
+    size_t scale;
+public:
+    virtual void SetUp()
+    {
+        scale = 1000;
+        for (Level level : {Level::Scalar, Level::AVX2})
+            if (level <= simd::supported_level())
+                levels.push_back(level);
+    }
+    virtual void TearDown() { simd::level() = simd::supported_level(); }
+
+    // 第i个元素的测试值，覆盖0到MAX_VALUE
+    template<typename Packed>
+    static typename Packed::value_type value_of(size_t i)
+    {
+        return typename Packed::value_type(i * 2654435761ULL) & Packed::MAX_VALUE;
+    }
+
+    // 写入scale个元素后逐个读取、修改、批量解压
+    template<typename Packed>
+    void check()
+    {
+        using T = typename Packed::value_type;
+        Packed v;
+        for (size_t i = 0; i < scale; ++i)
+            v.insert_back(value_of<Packed>(i));
+        EXPECT_EQ(scale, v.size());
+        EXPECT_LE(v.bytes(), (scale * Packed::BITS + 63) / 64 * 8);
+        for (size_t i = 0; i < scale; ++i)
+            EXPECT_EQ(value_of<Packed>(i), v[i]);
+
+        // 修改一个元素不影响相邻的元素
+        for (size_t i = 0; i < scale; i += 7)
+        {
+            v.set(i, Packed::MAX_VALUE);
+            EXPECT_EQ(Packed::MAX_VALUE, v.get(i));
+            if (i > 0)
+            {
+                EXPECT_EQ(value_of<Packed>(i - 1), v.get(i - 1));
+            }
+            if (i + 1 < scale)
+            {
+                EXPECT_EQ(value_of<Packed>(i + 1), v.get(i + 1));
+            }
+            v[i] = value_of<Packed>(i);
+        }
+
+        // 每个级别、每个起点的批量解压
+        std::vector<T> out(scale);
+        for (Level level : levels)
+        {
+            simd::level() = level;
+            for (size_t first = 0; first < 20; ++first)
+            {
+                v.unpack(first, scale - first, out.data());
+                for (size_t i = first; i < scale; ++i)
+                    ASSERT_EQ(value_of<Packed>(i), out[i - first]);
+            }
+        }
+    }
+};
+
+TEST_F(TestPackedVector, Basic)
+{
+    EXPECT_NO_THROW({
+        PackedVector<12> v1;
+        PackedVector<12> v2(100, 5);
+        PackedVector<12> v3(v2);
+        PackedVector<12> v4(std::move(v3));
+        v1 = v4;
+        v1 = std::move(v4);
+    });
+    EXPECT_THROW(PackedVector<12>(10, 4096), std::out_of_range);
+
+    // 被移动的对象为空，可以继续使用
+    PackedVector<12> a(100, 5);
+    PackedVector<12> b(std::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_THROW(a.back(), std::out_of_range);
+    a.insert_back(9);
+    EXPECT_EQ(9u, a.back());
+    b = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(size_t(1), b.size());
+    EXPECT_EQ(9u, b.front());
+
+    PackedVector<3> v = {1, 2, 3, 7};
+    EXPECT_EQ(size_t(4), v.size());
+    EXPECT_EQ(7u, v.back());
+    EXPECT_EQ(1u, v.front());
+    EXPECT_EQ(7u, PackedVector<3>::MAX_VALUE);
+    EXPECT_EQ((1ULL << 40) - 1, PackedVector<40>::MAX_VALUE);
+    EXPECT_EQ(~0ULL, PackedVector<64>::MAX_VALUE);
+    EXPECT_THROW(v.insert_back(8), std::out_of_range);
+    EXPECT_THROW(v[0] = 8, std::out_of_range);
+    EXPECT_THROW(v.at(4), std::out_of_range);
+    EXPECT_EQ(size_t(4), v.size());
+}
+
+TEST_F(TestPackedVector, Widths)
+{
+    check<PackedVector<1>>();
+    check<PackedVector<7>>();
+    check<PackedVector<10>>();
+    check<PackedVector<13>>();
+    check<PackedVector<16>>();
+    check<PackedVector<20>>();
+    check<PackedVector<25>>();
+    check<PackedVector<26>>();
+    check<PackedVector<32>>();
+    check<PackedVector<33>>();
+    check<PackedVector<57>>();
+    check<PackedVector<64>>();
+}
+
+TEST_F(TestPackedVector, Modifiers)
+{
+    PackedVector<20> v;
+    v.resize(scale, 12345);
+    EXPECT_EQ(12345u, v.back());
+    EXPECT_GE(v.capacity(), scale);
+    v.resize(10);
+    EXPECT_EQ(size_t(10), v.size());
+    // 收缩后新增的元素不受原来的值影响
+    v.resize(20);
+    EXPECT_EQ(12345u, v[9]);
+    EXPECT_EQ(0u, v[10]);
+    EXPECT_EQ(0u, v[19]);
+    while (!v.empty())
+        v.remove_back();
+    EXPECT_THROW(v.remove_back(), std::out_of_range);
+    EXPECT_THROW(v.front(), std::out_of_range);
+
+    std::vector<int> a(100);
+    std::iota(a.begin(), a.end(), 0);
+    v.append(a.begin(), a.end());
+    std::istringstream is("1 2 3");
+    v.append(std::istream_iterator<int>(is), std::istream_iterator<int>());
+    EXPECT_EQ(size_t(103), v.size());
+    EXPECT_EQ(3u, v.back());
+    std::vector<uint32_t> out(3);
+    EXPECT_THROW(v.unpack(101, 3, out.data()), std::out_of_range);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    v.shrink_to_fit();
+    EXPECT_EQ(size_t(0), v.capacity());
+}
+
+TEST_F(TestPackedVector, Iterators)
+{
+    PackedVector<10> v;
+    for (size_t i = 0; i < scale; ++i)
+        v.insert_back(uint32_t(scale - i));
+    EXPECT_EQ(std::ptrdiff_t(scale), v.end() - v.begin());
+    EXPECT_EQ(v.begin() + 3, v.end() - (scale - 3));
+    EXPECT_EQ(uint32_t(scale - 5), v.cbegin()[5]);
+    EXPECT_EQ(1u, *v.rbegin());
+    EXPECT_EQ(v.begin() + 10, std::find(v.begin(), v.end(), uint32_t(scale - 10)));
+
+    // 通过迭代器修改元素
+    for (auto it = v.begin(); it != v.end(); ++it)
+        *it = *it - 1;
+    const PackedVector<10>& c = v;
+    size_t i = 0;
+    for (auto value : c)
+        EXPECT_EQ(uint32_t(scale - 1 - i++), value);
+    std::reverse(v.begin(), v.end());
+    EXPECT_TRUE(std::is_sorted(v.cbegin(), v.cend()));
+    PackedVector<10>::const_iterator it = v.begin();
+    EXPECT_EQ(0u, *it);
+}
+
+TEST_F(TestPackedVector, BlockPacked)
+{
+    // 有序的大数值，块内差值很小
+    BlockPackedVector<uint32_t> v;
+    for (size_t i = 0; i < scale * 10; ++i)
+        v.insert_back(uint32_t(4000000000u + i * 3));
+    EXPECT_EQ(scale * 10, v.size());
+    EXPECT_LT(v.bytes(), scale * 10 * 2);
+    for (size_t i = 0; i < v.size(); ++i)
+        ASSERT_EQ(uint32_t(4000000000u + i * 3), v[i]);
+    std::vector<uint32_t> out(128);
+    for (Level level : levels)
+    {
+        simd::level() = level;
+        v.unpack(3, out.data());
+        for (size_t i = 0; i < 128; ++i)
+            EXPECT_EQ(uint32_t(4000000000u + (3 * 128 + i) * 3), out[i]);
+    }
+    EXPECT_THROW(v.at(scale * 10), std::out_of_range);
+
+    // 移除元素时解压最后一块
+    for (size_t i = 0; i < 200; ++i)
+        v.remove_back();
+    EXPECT_EQ(uint32_t(4000000000u + (scale * 10 - 201) * 3), v.at(v.size() - 1));
+    v.insert_back(7);
+    EXPECT_EQ(7u, v.at(v.size() - 1));
+
+    // 有符号、相等和全范围的块
+    BlockPackedVector<int64_t, 64> s;
+    for (int i = 0; i < 64; ++i)
+        s.insert_back(-5);
+    for (int i = 0; i < 64; ++i)
+        s.insert_back(i % 2 ? INT64_MIN : INT64_MAX);
+    s.insert_back(1);
+    EXPECT_EQ(size_t(129), s.size());
+    EXPECT_EQ(-5, s[63]);
+    EXPECT_EQ(INT64_MAX, s[64]);
+    EXPECT_EQ(INT64_MIN, s[127]);
+    EXPECT_EQ(1, s[128]);
+    std::vector<int64_t> block(64);
+    s.unpack(1, block.data());
+    EXPECT_EQ(INT64_MIN, block[63]);
+    s.clear();
+    EXPECT_TRUE(s.empty());
+
+    // 相等的块在其他块之后，不占用压缩数组
+    BlockPackedVector<uint32_t, 64> e;
+    for (uint32_t i = 0; i < 64; ++i)
+        e.insert_back(i * 1000);
+    size_t bytes = e.bytes();
+    for (int i = 0; i < 64; ++i)
+        e.insert_back(7);
+    e.insert_back(8);
+    EXPECT_EQ(size_t(129), e.size());
+    EXPECT_EQ(63000u, e[63]);
+    EXPECT_EQ(7u, e[64]);
+    EXPECT_EQ(7u, e[127]);
+    EXPECT_EQ(8u, e[128]);
+    EXPECT_GE(bytes + 64, e.bytes());
+    std::vector<uint32_t> same(64);
+    e.unpack(1, same.data());
+    EXPECT_EQ(std::vector<uint32_t>(64, 7), same);
+    e.remove_back();
+    e.remove_back();
+    EXPECT_EQ(size_t(127), e.size());
+    EXPECT_EQ(7u, e.at(126));
+}
+
+TEST_F(TestPackedVector, Other)
+{
+    PackedVector<5> a = {1, 2, 3};
+    PackedVector<5> b = {1, 2, 3, 4};
+    EXPECT_TRUE(a != b);
+    b.remove_back();
+    EXPECT_TRUE(a == b);
+    b[2] = 31;
+    EXPECT_TRUE(a != b);
+
+    using std::swap;
+    swap(a, b);
+    EXPECT_EQ(31u, a[2]);
+    std::ostringstream os;
+    os << a;
+    EXPECT_EQ("1 2 31 ", os.str());
+}
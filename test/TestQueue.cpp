@@ -34,7 +34,7 @@ TEST_F(TestQueue, Basic)
     EXPECT_NO_THROW({
         Queue<string> s1;
         Queue<string> s2(s1);
-        Queue<string> s3(Queue<string>());
+        Queue<string> s3(std::move(s2));
 
         s1 = s2;
         s2 = Queue<string>();
@@ -96,8 +96,8 @@ TEST_F(TestQueue, Modifiers)
     EXPECT_EQ(scale, b.size());
     for (size_t i = 0; i < scale; ++i)
     {
-        EXPECT_EQ(std::to_string(i), queue.front());
-        queue.dequeue();
+        EXPECT_EQ(std::to_string(i), b.front());
+        b.dequeue();
     }
 }
 
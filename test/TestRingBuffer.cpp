@@ -0,0 +1,210 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "Queue.h"
+#include "RingBuffer.h"
+#include "Stack.h"
+#include "gtest/gtest.h"
+
+using std::string;
+using cpplib::RingBuffer;
+using cpplib::OverwriteOnOverflow;
+
+class TestRingBuffer : public testing::Test
+{
+protected:
+    RingBuffer<string> buffer;
+    RingBuffer<string> a;
+    RingBuffer<string> b;
+    RingBuffer<string> c;
+    size_t scale;
+public:
+    TestRingBuffer() : buffer(32), a(32), b(32), c(32) {}
+    virtual void SetUp() { scale = 32; }
+    virtual void TearDown() {}
+
+    void insert_n(RingBuffer<string>& s, size_t n, bool at_back = true)
+    {
+        if (at_back)
+        {
+            for (size_t i = 0; i < n; ++i)
+                s.insert_back(std::to_string(i));
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+                s.insert_front(std::to_string(i));
+        }
+    }
+};
+
+TEST_F(TestRingBuffer, Basic)
+{
+    EXPECT_NO_THROW({
+        RingBuffer<string> s1;
+        RingBuffer<string> s2(s1);
+        RingBuffer<string> s3(std::move(s2));
+
+        s1 = s3;
+        s2 = RingBuffer<string>(8);
+    });
+    EXPECT_THROW(RingBuffer<string>(0), std::invalid_argument);
+}
+
+TEST_F(TestRingBuffer, Capacity)
+{
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(size_t(0), buffer.size());
+    EXPECT_EQ(scale, buffer.capacity());
+
+    insert_n(buffer, scale);
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(scale, buffer.size());
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(scale, buffer.capacity());
+}
+
+TEST_F(TestRingBuffer, ElementAccess)
+{
+    EXPECT_THROW(buffer.front(), std::out_of_range);
+    EXPECT_THROW(buffer.back(), std::out_of_range);
+    EXPECT_THROW(buffer.at(0), std::out_of_range);
+
+    // 队首位置绕过缓冲区末尾
+    insert_n(buffer, scale / 2, false);
+    insert_n(buffer, scale / 2, true);
+    for (size_t i = 0; i < scale / 2; ++i)
+    {
+        EXPECT_EQ(std::to_string(scale / 2 - 1 - i), buffer[i]);
+        EXPECT_EQ(std::to_string(i), buffer.at(scale / 2 + i));
+    }
+    EXPECT_EQ(std::to_string(scale / 2 - 1), buffer.front());
+    EXPECT_EQ(std::to_string(scale / 2 - 1), buffer.back());
+    EXPECT_THROW(buffer.at(scale), std::out_of_range);
+}
+
+TEST_F(TestRingBuffer, Iterators)
+{
+    insert_n(buffer, scale / 2, false);
+    insert_n(buffer, scale / 2, true);
+    size_t i = 0;
+    for (auto it = buffer.begin(); it != buffer.end(); ++it, ++i)
+        EXPECT_EQ(buffer[i], *it);
+    EXPECT_EQ(scale, i);
+    EXPECT_EQ(int(scale), buffer.end() - buffer.begin());
+    EXPECT_EQ(buffer.back(), *buffer.rbegin());
+    EXPECT_EQ(buffer[5], buffer.cbegin()[5]);
+    EXPECT_TRUE(buffer.begin() < buffer.end());
+}
+
+TEST_F(TestRingBuffer, Modifiers)
+{
+    EXPECT_THROW(buffer.remove_back(), std::out_of_range);
+    EXPECT_THROW(buffer.remove_front(), std::out_of_range);
+
+    // 反复添加和移除，缓冲区循环使用
+    for (size_t k = 0; k < 4; ++k)
+    {
+        insert_n(buffer, scale);
+        EXPECT_THROW(buffer.insert_back("x"), std::overflow_error);
+        EXPECT_THROW(buffer.insert_front("x"), std::overflow_error);
+        for (size_t i = 0; i < scale / 2 + k; ++i)
+        {
+            EXPECT_EQ(std::to_string(i), buffer.front());
+            buffer.remove_front();
+        }
+        for (size_t i = scale; i > scale / 2 + k; --i)
+        {
+            EXPECT_EQ(std::to_string(i - 1), buffer.back());
+            buffer.remove_back();
+        }
+        EXPECT_TRUE(buffer.empty());
+    }
+
+    insert_n(a, scale);
+    b.swap(a);
+    EXPECT_EQ(scale, b.size());
+    EXPECT_TRUE(a.empty());
+}
+
+TEST_F(TestRingBuffer, Overwrite)
+{
+    RingBuffer<string, OverwriteOnOverflow> x(4);
+    for (size_t i = 0; i < scale; ++i)
+        x.insert_back(std::to_string(i));
+    EXPECT_EQ(size_t(4), x.size());
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(std::to_string(scale - 4 + i), x[i]);
+
+    // 在队首添加覆盖队尾元素
+    x.insert_front("a");
+    EXPECT_EQ("a", x.front());
+    EXPECT_EQ(std::to_string(scale - 2), x.back());
+
+    // 参数引用缓冲区内的元素
+    x.insert_back(x.front());
+    EXPECT_EQ("a", x.back());
+    EXPECT_EQ(std::to_string(scale - 4), x.front());
+
+    // 已被移动的缓冲区容量为0，添加的元素立即被覆盖
+    RingBuffer<string, OverwriteOnOverflow> y(std::move(x));
+    EXPECT_EQ(size_t(4), y.size());
+    EXPECT_EQ(size_t(0), x.capacity());
+    x.insert_back("b");
+    x.insert_front("c");
+    EXPECT_TRUE(x.empty());
+    EXPECT_THROW(x.front(), std::out_of_range);
+    x = y;
+    x.insert_back("d");
+    EXPECT_EQ("d", x.back());
+    EXPECT_EQ(size_t(4), x.size());
+
+    // 拒绝策略的缓冲区已被移动后添加抛出异常
+    RingBuffer<string> z(std::move(a));
+    EXPECT_THROW(a.insert_back("e"), std::overflow_error);
+    EXPECT_THROW(a.insert_front("e"), std::overflow_error);
+    EXPECT_TRUE(a.empty());
+}
+
+TEST_F(TestRingBuffer, Adapters)
+{
+    Queue<string, RingBuffer<string>> q(RingBuffer<string>(4));
+    for (size_t i = 0; i < 4; ++i)
+        q.enqueue(std::to_string(i));
+    EXPECT_THROW(q.enqueue("x"), std::overflow_error);
+    EXPECT_EQ("0", q.front());
+    q.dequeue();
+    q.enqueue("4");
+    EXPECT_EQ("4", q.back());
+
+    Stack<string, RingBuffer<string, OverwriteOnOverflow>> s(RingBuffer<string, OverwriteOnOverflow>(2));
+    s.push("0");
+    s.push("1");
+    s.push("2");
+    EXPECT_EQ(size_t(2), s.size());
+    EXPECT_EQ("2", s.top());
+    s.pop();
+    EXPECT_EQ("1", s.top());
+    s.pop();
+    EXPECT_TRUE(s.empty());
+}
+
+TEST_F(TestRingBuffer, Other)
+{
+    using std::swap;
+    insert_n(a, scale);
+    c = a;
+    EXPECT_TRUE(c == a && c != b);
+    b.swap(a);
+    EXPECT_TRUE(c != a && c == b);
+    swap(a, b);
+    EXPECT_TRUE(c == a && c != b);
+
+    std::ostringstream os;
+    RingBuffer<int> x(3);
+    x.insert_back(1);
+    x.insert_back(2);
+    os << x;
+    EXPECT_EQ("1 2 ", os.str());
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Simd.h"
+#include "gtest/gtest.h"
+
+using std::string;
+using cpplib::simd::Level;
+namespace simd = cpplib::simd;
+
+class TestSimd : public testing::Test
+{
+protected:
+    std::vector<Level> levels;
+    size_t scale;
+public:
+    virtual void SetUp()
+    {
+        scale = 100;
+        for (Level level : {Level::Scalar, Level::SSE42, Level::AVX2})
+            if (level <= simd::supported_level())
+                levels.push_back(level);
+    }
+    virtual void TearDown() { simd::level() = simd::supported_level(); }
+
+    // 在每个指令集级别上，对长度为0到scale的数组检查所有算法
+    template<typename T>
+    void check()
+    {
+        for (Level level : levels)
+        {
+            simd::level() = level;
+            for (size_t n = 0; n <= scale; ++n)
+                check<T>(n);
+        }
+    }
+
+    template<typename T>
+    void check(size_t n)
+    {
+        std::vector<T> a(n + 1);
+        for (size_t i = 0; i < n; ++i)
+            a[i] = T(i % 50 + 10);
+        std::vector<T> b(a);
+        EXPECT_TRUE(simd::equal(a.data(), b.data(), n));
+        EXPECT_EQ(n, simd::find(a.data(), n, T(5)));
+        EXPECT_EQ(size_t(0), simd::count(a.data(), n, T(5)));
+        for (size_t i = 0; i < n; ++i)
+        {
+            // 只有一个位置不同、等于5、最小或最大
+            b[i] = T(5);
+            EXPECT_FALSE(simd::equal(a.data(), b.data(), n));
+            EXPECT_EQ(i, simd::find(b.data(), n, T(5)));
+            EXPECT_EQ(size_t(1), simd::count(b.data(), n, T(5)));
+            EXPECT_EQ(T(5), simd::min(b.data(), n));
+            b[i] = T(200);
+            EXPECT_EQ(T(200), simd::max(b.data(), n));
+            b[i] = a[i];
+        }
+        // 数组之外的元素不参与计算
+        a[n] = T(1);
+        if (n > 0)
+        {
+            EXPECT_EQ(T(10), simd::min(a.data(), n));
+            EXPECT_EQ(T(n < 50 ? n + 9 : 59), simd::max(a.data(), n));
+        }
+        EXPECT_EQ(simd::scalar::sum(a.data(), n), simd::sum(a.data(), n));
+        EXPECT_EQ((n + 49) / 50, simd::count(a.data(), n, T(10)));
+    }
+};
+
+TEST_F(TestSimd, Int)
+{
+    check<std::int32_t>();
+
+    // 负数和64位的和
+    std::vector<std::int32_t> v(1000, -2000000000);
+    for (Level level : levels)
+    {
+        simd::level() = level;
+        EXPECT_EQ(-2000000000LL * 1000, simd::sum(v.data(), v.size()));
+        EXPECT_EQ(-2000000000, simd::min(v.data(), v.size()));
+    }
+}
+
+TEST_F(TestSimd, Float)
+{
+    check<float>();
+
+    // 正负零相等，NaN不等于任何值
+    std::vector<float> a(40, 0.0f);
+    std::vector<float> b(40, -0.0f);
+    b[33] = std::numeric_limits<float>::quiet_NaN();
+    for (Level level : levels)
+    {
+        simd::level() = level;
+        EXPECT_TRUE(simd::equal(a.data(), b.data(), 33));
+        EXPECT_FALSE(simd::equal(b.data(), b.data(), 40));
+        EXPECT_EQ(size_t(0), simd::find(b.data(), b.size(), 0.0f));
+        EXPECT_EQ(size_t(40), simd::find(b.data(), b.size(), b[33]));
+        EXPECT_EQ(size_t(39), simd::count(b.data(), b.size(), 0.0f));
+    }
+}
+
+TEST_F(TestSimd, Byte)
+{
+    check<std::uint8_t>();
+
+    // 字节之和不会溢出
+    std::vector<std::uint8_t> v(100000, 255);
+    for (Level level : levels)
+    {
+        simd::level() = level;
+        EXPECT_EQ(255ULL * 100000, simd::sum(v.data(), v.size()));
+        EXPECT_EQ(size_t(100000), simd::count(v.data(), v.size(), std::uint8_t(255)));
+        EXPECT_EQ(std::uint8_t(255), simd::min(v.data(), v.size()));
+    }
+}
+
+TEST_F(TestSimd, Other)
+{
+    // 其他类型使用标量实现
+    EXPECT_FALSE(simd::is_accelerated<string>::value);
+    EXPECT_FALSE(simd::is_accelerated<double>::value);
+    std::vector<string> s = {"b", "a", "c", "a"};
+    EXPECT_EQ(size_t(1), simd::find(s.data(), s.size(), string("a")));
+    EXPECT_EQ(size_t(2), simd::count(s.data(), s.size(), string("a")));
+    EXPECT_EQ("a", simd::min(s.data(), s.size()));
+    EXPECT_EQ("c", simd::max(s.data(), s.size()));
+    EXPECT_TRUE(simd::equal(s.data(), s.data(), s.size()));
+    std::vector<double> d = {0.5, 1.5, 2.0};
+    EXPECT_EQ(4.0, simd::sum(d.data(), d.size()));
+}
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "SkipList.h"
+#include "gtest/gtest.h"
+
+using std::string;
+using cpplib::SkipList;
+
+class TestSkipList : public testing::Test
+{
+protected:
+    SkipList<string> list;
+    size_t scale;
+public:
+    virtual void SetUp()
+    {
+        scale = 1000;
+        for (size_t i = 0; i < scale; ++i)
+            list.insert_back(std::to_string(i));
+    }
+};
+
+TEST_F(TestSkipList, Basic)
+{
+    EXPECT_NO_THROW({
+        SkipList<string> l1;
+        SkipList<string> l2(list);
+        SkipList<string> l3(std::move(l2));
+        l1 = l3;
+        l1 = std::move(l3);
+    });
+    EXPECT_EQ(scale, list.size());
+    EXPECT_FALSE(list.empty());
+    SkipList<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST_F(TestSkipList, ElementAccess)
+{
+    EXPECT_EQ("0", list.front());
+    EXPECT_EQ(std::to_string(scale - 1), list.back());
+    for (size_t i = 0; i < scale; ++i)
+    {
+        EXPECT_EQ(std::to_string(i), list.at(i));
+        EXPECT_EQ(std::to_string(i), *list.nth(i));
+        EXPECT_EQ(i, list.index_of(list.nth(i)));
+    }
+    EXPECT_TRUE(list.nth(scale) == list.end());
+    EXPECT_EQ(scale, list.index_of(list.end()));
+    EXPECT_THROW(list.at(scale), std::out_of_range);
+    EXPECT_THROW(list.nth(scale + 1), std::out_of_range);
+    list.at(5) = "five";
+    const SkipList<string>& c = list;
+    EXPECT_EQ("five", c.at(5));
+    EXPECT_EQ("five", *c.nth(5));
+
+    SkipList<int> empty;
+    EXPECT_THROW(empty.front(), std::out_of_range);
+    EXPECT_THROW(empty.back(), std::out_of_range);
+    EXPECT_THROW(empty.at(0), std::out_of_range);
+}
+
+TEST_F(TestSkipList, Iterators)
+{
+    size_t i = 0;
+    for (auto& s : list)
+        EXPECT_EQ(std::to_string(i++), s);
+    EXPECT_EQ(scale, i);
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+        EXPECT_EQ(std::to_string(--i), *it);
+    SkipList<string>::const_iterator it = list.end();
+    --it;
+    EXPECT_EQ(size_t(3), it->size());
+    EXPECT_TRUE(list.cbegin() == list.begin());
+    EXPECT_EQ(std::ptrdiff_t(scale), std::distance(list.cbegin(), list.cend()));
+}
+
+TEST_F(TestSkipList, Modifiers)
+{
+    // 按位置和按迭代器添加、移除，迭代器在修改其他元素后仍然有效
+    auto it = list.insert(size_t(100), "new");
+    auto front = list.begin();
+    EXPECT_EQ("new", list.at(100));
+    EXPECT_EQ("100", list.at(101));
+    list.insert(it, "before");
+    EXPECT_EQ("before", list.at(100));
+    EXPECT_EQ(size_t(101), list.index_of(it));
+    list.remove(it);
+    list.remove(size_t(100));
+    EXPECT_EQ("100", list.at(100));
+    EXPECT_EQ("0", *front);
+    EXPECT_EQ(scale, list.size());
+
+    list.insert_front("front");
+    list.emplace_back(3, 'x');
+    list.emplace_at(1, 2, 'y');
+    EXPECT_EQ("front", list.front());
+    EXPECT_EQ("yy", list.at(1));
+    EXPECT_EQ("xxx", list.back());
+    list.remove_front();
+    list.remove_front();
+    list.remove_back();
+    EXPECT_EQ(scale, list.size());
+    EXPECT_THROW(list.insert(scale + 1, "x"), std::out_of_range);
+    EXPECT_THROW(list.remove(scale), std::out_of_range);
+    EXPECT_THROW(list.remove(list.end()), std::out_of_range);
+
+    while (!list.empty())
+        list.remove_back();
+    EXPECT_THROW(list.remove_back(), std::out_of_range);
+    EXPECT_THROW(list.remove_front(), std::out_of_range);
+    list.insert_back("a");
+    EXPECT_EQ("a", list.front());
+    list.clear();
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST_F(TestSkipList, RandomEdits)
+{
+    // 与std::vector比较随机位置的添加、移除和访问
+    SkipList<int> l;
+    std::vector<int> v;
+    unsigned seed = 1;
+    for (int i = 0; i < 20000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t pos = (seed >> 8) % (v.size() + 1);
+        if ((seed >> 28) < 9 || v.empty())
+        {
+            l.insert(pos, i);
+            v.insert(v.begin() + pos, i);
+        }
+        else
+        {
+            pos %= v.size();
+            EXPECT_EQ(v[pos], l.at(pos));
+            l.remove(pos);
+            v.erase(v.begin() + pos);
+        }
+    }
+    EXPECT_EQ(v.size(), l.size());
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), l.begin()));
+    for (size_t i = 0; i < v.size(); i += 7)
+    {
+        EXPECT_EQ(v[i], l.at(i));
+        EXPECT_EQ(i, l.index_of(l.nth(i)));
+    }
+
+    // 移动后每层最后一个结点指向新的哨兵结点
+    SkipList<int> moved(std::move(l));
+    EXPECT_TRUE(l.empty());
+    moved.insert_back(-1);
+    v.push_back(-1);
+    EXPECT_EQ(v.size() - 1, moved.index_of(std::prev(moved.end())));
+    while (!v.empty())
+    {
+        moved.remove_back();
+        v.pop_back();
+        if (v.size() % 1000 == 0)
+        {
+            EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), moved.rbegin()));
+        }
+    }
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST_F(TestSkipList, Other)
+{
+    SkipList<string> copy(list);
+    EXPECT_TRUE(copy == list);
+    copy.back() = "";
+    EXPECT_TRUE(copy != list);
+    copy.remove_back();
+    EXPECT_TRUE(copy != list);
+
+    copy = list;
+    copy += copy;
+    EXPECT_EQ(scale * 2, copy.size());
+    EXPECT_EQ("0", copy.at(scale));
+    SkipList<string> sum = list + list;
+    EXPECT_TRUE(sum == copy);
+
+    SkipList<string> empty;
+    using std::swap;
+    swap(empty, copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(scale * 2, empty.size());
+    EXPECT_EQ(std::to_string(scale - 1), empty.at(scale * 2 - 1));
+    copy.swap(empty);
+    EXPECT_EQ(scale * 2, copy.size());
+    EXPECT_EQ(std::to_string(scale - 1), copy.back());
+
+    SkipList<int> small;
+    for (int i = 0; i < 5; ++i)
+        small.insert_back(i);
+    std::ostringstream os;
+    os << small;
+    EXPECT_EQ("0 1 2 3 4 ", os.str());
+}
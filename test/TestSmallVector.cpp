@@ -0,0 +1,234 @@
+#include <memory>
+#include <sstream>
+#include <string>
+#include "SmallVector.h"
+#include "gtest/gtest.h"
+
+using std::string;
+using cpplib::SmallVector;
+
+class TestSmallVector : public testing::Test
+{
+protected:
+    SmallVector<string, 8> vector;
+    SmallVector<string, 8> a;
+    SmallVector<string, 8> b;
+    SmallVector<string, 8> c;
+    size_t scale;
+public:
+    virtual void SetUp() { scale = 32; }
+    virtual void TearDown() {}
+
+    template<typename T, size_t Count>
+    void insert_n(SmallVector<T, Count>& v, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            v.insert_back(std::to_string(i));
+    }
+};
+
+TEST_F(TestSmallVector, Basic)
+{
+    using Small = SmallVector<string, 4>;
+    EXPECT_NO_THROW({
+        Small v1;
+        Small v2(v1);
+        Small v3(std::move(v2));
+        Small v4(100);
+
+        v1 = v2;
+        v2 = Small();
+        v3 = v1;
+        v4 = v1;
+    });
+    EXPECT_TRUE(vector.is_inline());
+    EXPECT_EQ(size_t(8), vector.capacity());
+    EXPECT_EQ(size_t(8), (SmallVector<int, 8>::INLINE_CAPACITY));
+    EXPECT_FALSE((SmallVector<int, 8>(9).is_inline()));
+}
+
+TEST_F(TestSmallVector, ElementAccess)
+{
+    EXPECT_THROW(vector.front(), std::out_of_range);
+    EXPECT_THROW(vector.back(), std::out_of_range);
+    for (size_t i = 0; i < scale; ++i)
+    {
+        vector.insert_back(std::to_string(i));
+        EXPECT_EQ("0", vector.front());
+        EXPECT_EQ(std::to_string(i), vector.back());
+    }
+    for (size_t i = 0; i < scale; ++i)
+    {
+        EXPECT_EQ(std::to_string(i), vector.at(i));
+        EXPECT_EQ(std::to_string(i), vector[i]);
+    }
+    EXPECT_THROW(vector.at(scale), std::out_of_range);
+}
+
+TEST_F(TestSmallVector, Iterators)
+{
+    EXPECT_EQ(vector.begin(), vector.end());
+    insert_n(vector, scale);
+    size_t i = 0;
+    for (auto& s : vector)
+        EXPECT_EQ(std::to_string(i++), s);
+    for (auto it = vector.crbegin(); it != vector.crend(); ++it)
+        EXPECT_EQ(std::to_string(--i), *it);
+    EXPECT_EQ(ptrdiff_t(scale), vector.cend() - vector.cbegin());
+}
+
+TEST_F(TestSmallVector, Capacity)
+{
+    // 不超过内联容量时不分配堆空间
+    insert_n(vector, 8);
+    EXPECT_TRUE(vector.is_inline());
+    EXPECT_EQ(size_t(8), vector.capacity());
+    vector.insert_back("8");
+    EXPECT_FALSE(vector.is_inline());
+    EXPECT_LT(size_t(8), vector.capacity());
+    for (size_t i = 0; i < 9; ++i)
+        EXPECT_EQ(std::to_string(i), vector[i]);
+
+    // 收缩到内联容量以内时搬回内联空间
+    vector.remove_back();
+    vector.shrink_to_fit();
+    EXPECT_TRUE(vector.is_inline());
+    EXPECT_EQ(size_t(8), vector.size());
+    EXPECT_EQ("7", vector.back());
+    vector.reserve(4);
+    EXPECT_TRUE(vector.is_inline());
+    vector.reserve(100);
+    EXPECT_FALSE(vector.is_inline());
+    EXPECT_EQ(size_t(100), vector.capacity());
+
+    // 移除元素按增长策略收缩，收缩到内联容量以内时回到内联空间
+    insert_n(vector, scale * 4);
+    while (vector.size() > 1)
+        vector.remove_back();
+    EXPECT_GE(size_t(20), vector.capacity());
+    SmallVector<string, 16> w;
+    insert_n(w, scale * 4);
+    while (w.size() > 1)
+        w.remove_back();
+    EXPECT_TRUE(w.is_inline());
+    EXPECT_EQ("0", vector.front());
+
+    vector.resize(scale);
+    EXPECT_EQ(scale, vector.size());
+    EXPECT_EQ("", vector.back());
+    vector.resize(2);
+    EXPECT_EQ(size_t(2), vector.size());
+    vector.resize(scale, vector.front());
+    EXPECT_EQ("0", vector.back());
+    EXPECT_TRUE(vector.empty() == false);
+}
+
+TEST_F(TestSmallVector, Modifiers)
+{
+    EXPECT_THROW(vector.remove_back(), std::out_of_range);
+    EXPECT_THROW(vector.remove(vector.end()), std::out_of_range);
+    for (size_t i = 0; i < scale; ++i)
+        vector.insert(vector.begin(), std::to_string(i));
+    for (size_t i = scale; i > 0; --i)
+    {
+        EXPECT_EQ(std::to_string(i - 1), vector.front());
+        vector.remove(vector.begin());
+    }
+    EXPECT_TRUE(vector.empty());
+    EXPECT_THROW(vector.insert(vector.begin() + 1, "x"), std::out_of_range);
+
+    // 参数引用自身元素时扩容也是安全的
+    insert_n(vector, 8);
+    vector.insert_back(vector[0]);
+    EXPECT_EQ("0", vector.back());
+    vector.emplace_back(3, 'a');
+    EXPECT_EQ("aaa", vector.back());
+
+    vector.clear();
+    insert_n(vector, scale);
+    a = a + vector;
+    b += vector;
+    EXPECT_TRUE(a == b);
+    vector += vector;
+    EXPECT_EQ(scale * 2, vector.size());
+    EXPECT_EQ(std::to_string(scale - 1), vector.back());
+    EXPECT_EQ(std::to_string(scale - 1), vector[scale - 1]);
+}
+
+TEST_F(TestSmallVector, MoveAndSwap)
+{
+    // 使用堆空间时移动只接管指针
+    insert_n(a, scale);
+    const string* data = &a[0];
+    SmallVector<string, 8> d(std::move(a));
+    EXPECT_EQ(data, &d[0]);
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(a.is_inline());
+    a.insert_back("0");
+    EXPECT_EQ("0", a.front());
+
+    // 使用内联空间时逐个搬移元素
+    insert_n(b, 4);
+    SmallVector<string, 8> e(std::move(b));
+    EXPECT_TRUE(e.is_inline());
+    EXPECT_EQ(size_t(4), e.size());
+    EXPECT_EQ("3", e.back());
+    EXPECT_TRUE(b.empty());
+
+    // 交换内联和堆空间的各种组合
+    data = &d[0];
+    e.swap(d);
+    EXPECT_EQ(data, &e[0]);
+    EXPECT_TRUE(d.is_inline());
+    EXPECT_EQ(scale, e.size());
+    EXPECT_EQ(size_t(4), d.size());
+    using std::swap;
+    swap(d, e);
+    EXPECT_EQ(data, &d[0]);
+    EXPECT_EQ("3", e.back());
+    c.insert_back("c");
+    swap(c, e);
+    EXPECT_EQ(size_t(4), c.size());
+    EXPECT_EQ("c", e.front());
+    insert_n(vector, scale);
+    data = &vector[0];
+    d.swap(vector);
+    EXPECT_EQ(data, &d[0]);
+    d.swap(d);
+    EXPECT_EQ(data, &d[0]);
+
+    // 只能移动的元素
+    SmallVector<std::unique_ptr<int>, 2> u;
+    for (int i = 0; i < 4; ++i)
+        u.emplace_back(new int(i));
+    SmallVector<std::unique_ptr<int>, 2> v(std::move(u));
+    v.remove_back();
+    v.remove_back();
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(1, *v.back());
+}
+
+TEST_F(TestSmallVector, Other)
+{
+    insert_n(a, 4);
+    c = a;
+    EXPECT_TRUE(c == a && c != b);
+    EXPECT_TRUE(c.is_inline());
+    // 副本按元素个数分配容量
+    insert_n(b, scale);
+    b.shrink_to_fit();
+    while (b.size() > 4)
+        b.remove_back();
+    SmallVector<string, 8> d(b);
+    EXPECT_TRUE(d.is_inline());
+    EXPECT_TRUE(d == a);
+
+    std::ostringstream os;
+    SmallVector<int, 2> x;
+    x.insert_back(1);
+    x.insert_back(2);
+    x.insert_back(3);
+    os << x;
+    EXPECT_EQ("1 2 3 ", os.str());
+}
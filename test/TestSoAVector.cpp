@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include "SoAVector.h"
+#include "gtest/gtest.h"
+
+using std::string;
+using cpplib::SoAVector;
+
+// id、价格、数量和名称四个字段的记录
+using Records = SoAVector<int, double, std::int8_t, string>;
+
+class TestSoAVector : public testing::Test
+{
+protected:
+    Records records;
+    size_t scale;
+public:
+    virtual void SetUp()
+    {
+        scale = 1000;
+        for (size_t i = 0; i < scale; ++i)
+            records.insert_back(int(i), i * 0.5, std::int8_t(i % 100), std::to_string(i));
+    }
+
+    // 判断地址是否按alignment字节对齐
+    static bool is_aligned(const void* p, size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+};
+
+TEST_F(TestSoAVector, Basic)
+{
+    EXPECT_NO_THROW({
+        Records r1;
+        Records r2(100);
+        Records r3(r2);
+        Records r4(std::move(r3));
+        r1 = r4;
+        r1 = std::move(r4);
+    });
+    EXPECT_EQ(size_t(4), Records::COLUMNS);
+    Records r(10);
+    EXPECT_EQ(size_t(10), r.size());
+    EXPECT_EQ(0, r.get<0>(9));
+    EXPECT_EQ("", r.get<3>(9));
+
+    // 被移动的对象为空，行数与各列一致
+    Records moved(std::move(records));
+    EXPECT_EQ(scale, moved.size());
+    EXPECT_TRUE(records.empty());
+    records.insert_back(1, 2.0, std::int8_t(3), "4");
+    EXPECT_EQ(size_t(1), records.size());
+    EXPECT_EQ(size_t(1), records.column<0>().size());
+    EXPECT_EQ(2.0, records.column<1>()[0]);
+    moved = std::move(records);
+    EXPECT_TRUE(records.empty());
+    EXPECT_EQ(size_t(1), moved.size());
+    EXPECT_EQ("4", moved.get<3>(0));
+
+    // 参数引用对象中的元素，添加时需要扩容
+    while (moved.size() < scale)
+        moved.insert_back(moved.get<0>(0), moved.get<1>(0), moved.get<2>(0), moved.get<3>(0));
+    EXPECT_EQ(1, moved.get<0>(moved.size() - 1));
+    EXPECT_EQ(2.0, moved.get<1>(moved.size() - 1));
+    EXPECT_EQ("4", moved.get<3>(moved.size() - 1));
+}
+
+TEST_F(TestSoAVector, ElementAccess)
+{
+    EXPECT_EQ(scale, records.size());
+    EXPECT_GE(records.capacity(), scale);
+    for (size_t i = 0; i < scale; ++i)
+    {
+        EXPECT_EQ(int(i), std::get<0>(records[i]));
+        EXPECT_EQ(i * 0.5, std::get<1>(records[i]));
+        EXPECT_EQ(std::to_string(i), records.get<3>(i));
+    }
+
+    // 通过代理对象修改一个字段和整行
+    std::get<1>(records[5]) = -1.0;
+    EXPECT_EQ(-1.0, records.get<1>(5));
+    records[6] = std::make_tuple(-6, 6.5, std::int8_t(-6), string("six"));
+    EXPECT_EQ(-6, records.get<0>(6));
+    EXPECT_EQ("six", records.get<3>(6));
+    int id;
+    string name;
+    std::tie(id, std::ignore, std::ignore, name) = records.at(6);
+    EXPECT_EQ(-6, id);
+    EXPECT_EQ("six", name);
+    EXPECT_THROW(records.at(scale), std::out_of_range);
+    const Records& c = records;
+    EXPECT_EQ(7, std::get<0>(c.at(7)));
+    EXPECT_THROW(c.at(scale), std::out_of_range);
+}
+
+TEST_F(TestSoAVector, Columns)
+{
+    auto ids = records.column<0>();
+    auto prices = records.column<1>();
+    EXPECT_EQ(scale, ids.size());
+    EXPECT_TRUE(is_aligned(ids.data(), Records::ALIGNMENT));
+    EXPECT_TRUE(is_aligned(prices.data(), Records::ALIGNMENT));
+    EXPECT_TRUE(is_aligned(records.column<2>().data(), Records::ALIGNMENT));
+    EXPECT_EQ(long(scale) * long(scale - 1) / 2, std::accumulate(ids.begin(), ids.end(), 0L));
+
+    // 修改一列不影响其他列
+    for (size_t i = 0; i < prices.size(); ++i)
+        prices[i] *= 2;
+    EXPECT_EQ(double(scale - 1), records.get<1>(scale - 1));
+    EXPECT_EQ(int(scale - 1), records.get<0>(scale - 1));
+    const Records& c = records;
+    EXPECT_EQ(std::int8_t(99), c.column<2>()[99]);
+    EXPECT_TRUE(Records().column<0>().empty());
+}
+
+TEST_F(TestSoAVector, Modifiers)
+{
+    records.insert_back(std::make_tuple(-1, 0.25, std::int8_t(1), string("last")));
+    EXPECT_EQ(scale + 1, records.size());
+    EXPECT_EQ("last", records.get<3>(scale));
+    while (records.size() > 10)
+        records.remove_back();
+    EXPECT_EQ(size_t(10), records.column<3>().size());
+    EXPECT_LT(records.capacity(), scale);
+    records.shrink_to_fit();
+    EXPECT_EQ(9, records.get<0>(9));
+    records.reserve(scale * 2);
+    EXPECT_GE(records.capacity(), scale * 2);
+    records.resize(20);
+    EXPECT_EQ(0, records.get<0>(19));
+    records.clear();
+    EXPECT_TRUE(records.empty());
+    EXPECT_THROW(records.remove_back(), std::out_of_range);
+}
+
+TEST_F(TestSoAVector, Iterators)
+{
+    size_t i = 0;
+    for (auto row : records)
+        EXPECT_EQ(int(i++), std::get<0>(row));
+    EXPECT_EQ(scale, i);
+    EXPECT_EQ(std::ptrdiff_t(scale), records.end() - records.begin());
+    for (auto it = records.begin(); it != records.end(); ++it)
+        std::get<0>(*it) += 1;
+    Records::const_iterator it = records.begin();
+    EXPECT_EQ(1, std::get<0>(*it));
+    EXPECT_EQ(11, std::get<0>(it[10]));
+    EXPECT_EQ(int(scale), std::get<0>(*(records.cend() - 1)));
+}
+
+TEST_F(TestSoAVector, Other)
+{
+    Records copy(records);
+    EXPECT_TRUE(copy == records);
+    copy.get<2>(3) = 0;
+    EXPECT_TRUE(copy != records);
+    copy.remove_back();
+    EXPECT_TRUE(copy != records);
+
+    Records empty;
+    using std::swap;
+    swap(empty, copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(scale - 1, empty.size());
+}
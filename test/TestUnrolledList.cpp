@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "UnrolledList.h"
+#include "gtest/gtest.h"
+
+using std::string;
+using cpplib::UnrolledList;
+
+// 结点容量很小的链表，频繁触发结点的分裂、借入与合并
+using SmallList = UnrolledList<int, 4>;
+
+class TestUnrolledList : public testing::Test
+{
+protected:
+    UnrolledList<string> list;
+    size_t scale;
+public:
+    virtual void SetUp()
+    {
+        scale = 1000;
+        for (size_t i = 0; i < scale; ++i)
+            list.insert_back(std::to_string(i));
+    }
+
+    // 把链表的元素复制到std::vector
+    template<typename List>
+    static std::vector<typename List::value_type> to_vector(const List& l)
+    {
+        return std::vector<typename List::value_type>(l.begin(), l.end());
+    }
+};
+
+TEST_F(TestUnrolledList, Basic)
+{
+    EXPECT_NO_THROW({
+        UnrolledList<string> l1;
+        UnrolledList<string> l2(list);
+        UnrolledList<string> l3(std::move(l2));
+        l1 = l3;
+        l1 = std::move(l3);
+    });
+    EXPECT_EQ(size_t(16), UnrolledList<string>::NODE_CAPACITY);
+    EXPECT_EQ(size_t(64), UnrolledList<int>::NODE_CAPACITY);
+    EXPECT_EQ(size_t(32), UnrolledList<double>::NODE_CAPACITY);
+    EXPECT_EQ(scale, list.size());
+    EXPECT_FALSE(list.empty());
+    EXPECT_TRUE(UnrolledList<int>().empty());
+}
+
+TEST_F(TestUnrolledList, ElementAccess)
+{
+    EXPECT_EQ("0", list.front());
+    EXPECT_EQ(std::to_string(scale - 1), list.back());
+    for (size_t i = 0; i < scale; ++i)
+        EXPECT_EQ(std::to_string(i), list.at(i));
+    EXPECT_THROW(list.at(scale), std::out_of_range);
+    list.front() = "first";
+    list.back() = "last";
+    const UnrolledList<string>& c = list;
+    EXPECT_EQ("first", c.front());
+    EXPECT_EQ("last", c.back());
+    EXPECT_EQ("500", c.at(500));
+
+    UnrolledList<int> empty;
+    EXPECT_THROW(empty.front(), std::out_of_range);
+    EXPECT_THROW(empty.back(), std::out_of_range);
+    EXPECT_THROW(empty.at(0), std::out_of_range);
+}
+
+TEST_F(TestUnrolledList, Iterators)
+{
+    size_t i = 0;
+    for (auto& s : list)
+        EXPECT_EQ(std::to_string(i++), s);
+    EXPECT_EQ(scale, i);
+    EXPECT_EQ(std::ptrdiff_t(scale), std::distance(list.begin(), list.end()));
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+        EXPECT_EQ(std::to_string(--i), *it);
+    UnrolledList<string>::const_iterator it = list.end();
+    --it;
+    EXPECT_EQ(std::to_string(scale - 1), *it);
+    EXPECT_EQ(std::to_string(scale - 1), *list.crbegin());
+    EXPECT_EQ(size_t(3), it->size());
+    EXPECT_TRUE(list.cbegin() == list.begin());
+    std::reverse(list.begin(), list.end());
+    EXPECT_EQ("0", list.back());
+}
+
+TEST_F(TestUnrolledList, Modifiers)
+{
+    // 在中间添加使结点分裂，返回的迭代器指向新元素
+    auto it = std::next(list.begin(), 100);
+    it = list.insert(it, "new");
+    EXPECT_EQ("new", *it);
+    EXPECT_EQ("100", *std::next(it));
+    EXPECT_EQ("99", *std::prev(it));
+    EXPECT_EQ(scale + 1, list.size());
+    it = list.remove(it);
+    EXPECT_EQ("100", *it);
+    EXPECT_EQ(scale, list.size());
+
+    list.insert_front("front");
+    list.emplace_back(3, 'x');
+    EXPECT_EQ("front", list.front());
+    EXPECT_EQ("xxx", list.back());
+    list.remove_front();
+    list.remove_back();
+    EXPECT_EQ(to_vector(UnrolledList<string>(list)), to_vector(list));
+
+    // 参数引用链表中的元素
+    list.insert(list.begin(), list.back());
+    EXPECT_EQ(list.front(), list.back());
+    list.emplace(list.end(), list.front());
+    EXPECT_EQ(list.front(), list.back());
+
+    while (!list.empty())
+        list.remove_back();
+    EXPECT_THROW(list.remove_back(), std::out_of_range);
+    EXPECT_THROW(list.remove_front(), std::out_of_range);
+    EXPECT_THROW(list.remove(list.end()), std::out_of_range);
+    list.insert_back("a");
+    list.clear();
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST_F(TestUnrolledList, RandomEdits)
+{
+    // 与std::vector比较随机位置的添加和移除
+    SmallList l;
+    std::vector<int> v;
+    unsigned seed = 1;
+    for (int i = 0; i < 20000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t pos = v.empty() ? 0 : (seed >> 8) % (v.size() + 1);
+        if ((seed >> 28) < 9 || v.empty())
+        {
+            auto it = l.insert(std::next(l.cbegin(), pos), i);
+            v.insert(v.begin() + pos, i);
+            EXPECT_EQ(i, *it);
+        }
+        else
+        {
+            pos %= v.size();
+            auto it = l.remove(std::next(l.cbegin(), pos));
+            v.erase(v.begin() + pos);
+            if (pos < v.size())
+            {
+                EXPECT_EQ(v[pos], *it);
+            }
+            else
+            {
+                EXPECT_TRUE(it == l.end());
+            }
+        }
+    }
+    EXPECT_EQ(v.size(), l.size());
+    EXPECT_EQ(v, to_vector(l));
+    for (size_t i = 0; i < v.size(); i += 7)
+        EXPECT_EQ(v[i], l.at(i));
+
+    // 从头部移除直到为空，中途反复借入和合并
+    while (!v.empty())
+    {
+        l.remove_front();
+        v.erase(v.begin());
+        if (v.size() % 1000 == 0)
+        {
+            EXPECT_EQ(v, to_vector(l));
+        }
+    }
+    EXPECT_TRUE(l.empty());
+    for (int i = 0; i < 100; ++i)
+        l.insert_front(i);
+    EXPECT_EQ(99, l.front());
+    EXPECT_EQ(0, l.back());
+}
+
+TEST_F(TestUnrolledList, Other)
+{
+    UnrolledList<string> copy(list);
+    EXPECT_TRUE(copy == list);
+    copy.back() = "";
+    EXPECT_TRUE(copy != list);
+    copy.remove_back();
+    EXPECT_TRUE(copy != list);
+
+    copy = list;
+    copy += copy;
+    EXPECT_EQ(scale * 2, copy.size());
+    UnrolledList<string> sum = list + list;
+    EXPECT_TRUE(sum == copy);
+
+    UnrolledList<string> empty;
+    using std::swap;
+    swap(empty, copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(scale * 2, empty.size());
+    copy.swap(empty);
+    EXPECT_EQ(scale * 2, copy.size());
+
+    SmallList small;
+    for (int i = 0; i < 5; ++i)
+        small.insert_back(i);
+    std::ostringstream os;
+    os << small;
+    EXPECT_EQ("0 1 2 3 4 ", os.str());
+}
@@ -1,9 +1,62 @@
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
 #include <string>
 #include "Vector.h"
 #include "gtest/gtest.h"
 
 using std::string;
+using cpplib::Vector;
+using cpplib::AlignedVector;
+
+// 记录构造和析构次数的元素类型
+struct Counted
+{
+    static size_t constructed;
+    static size_t destroyed;
+    int value;
+
+    Counted() : value(0) { ++constructed; }
+    Counted(int value) : value(value) { ++constructed; }
+    Counted(const Counted& that) : value(that.value) { ++constructed; }
+    Counted(Counted&& that) noexcept : value(that.value) { ++constructed; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() { ++destroyed; }
+};
+
+size_t Counted::constructed = 0;
+size_t Counted::destroyed = 0;
+
+// 持有堆指针的元素类型，不是平凡可复制的，但可以平凡重定位
+struct Relocatable
+{
+    static int moved;
+    int* p;
+
+    Relocatable(int value) : p(new int(value)) {}
+    Relocatable(const Relocatable& that) : p(new int(*that.p)) {}
+    Relocatable(Relocatable&& that) noexcept : p(that.p) { that.p = nullptr; ++moved; }
+    Relocatable& operator=(Relocatable that) { std::swap(p, that.p); return *this; }
+    ~Relocatable() { delete p; }
+};
+
+int Relocatable::moved = 0;
+
+namespace cpplib
+{
+template<>
+struct is_trivially_relocatable<Relocatable> : std::true_type {};
+}
+
+// 判断元素空间的起始地址是否按alignment字节对齐
+template<typename V>
+bool is_aligned(const V& v, size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(v.begin()) % alignment == 0;
+}
 
 class TestVector : public testing::Test
 {
@@ -13,19 +66,21 @@ protected:
     Vector<string> b;
     Vector<string> c;
     string str;
-    int scale;
+    size_t scale;
 public:
     virtual void SetUp() { scale = 32; }
     virtual void TearDown() {}
 
-    void insert_n(Vector<string>& s, int n)
+    template<typename P, size_t A>
+    void insert_n(Vector<string, P, A>& s, size_t n)
     {
-        for (int i = 0; i < n; ++i)
+        for (size_t i = 0; i < n; ++i)
             s.insert_back(std::to_string(i));
     }
-    void remove_n(Vector<string>& s, int n)
+    template<typename T, typename P, size_t A>
+    void remove_n(Vector<T, P, A>& s, size_t n)
     {
-        for (int i = 0; i < n; ++i)
+        for (size_t i = 0; i < n; ++i)
             s.remove_back();
     }
 };
@@ -36,10 +91,11 @@ TEST_F(TestVector, Basic)
         Vector<string> s1;
         Vector<string> s2(s1);
         Vector<string> s3(30);
-        Vector<string> s4(Vector<string>());
+        Vector<string> s4(std::move(s3));
 
         s1 = s2;
         s2 = Vector<string>(15);
+        s3 = s4;
     });
 }
 
@@ -48,28 +104,29 @@ TEST_F(TestVector, ElementAccess)
     EXPECT_THROW(vector.front(), std::out_of_range);
     EXPECT_THROW(vector.back(), std::out_of_range);
     EXPECT_NO_THROW({
-        for (int i = 0; i < scale; ++i)
+        for (size_t i = 0; i < scale; ++i)
         {
             str = std::to_string(i);
             vector.insert_back(str);
             EXPECT_EQ(str, vector.back());
         }
         EXPECT_EQ(std::to_string(0), vector.front());
-        for (int i = 0; i < scale; ++i)
+        for (size_t i = scale; i-- > 0; )
         {
-            str = vector.back();
-            EXPECT_EQ(str, vector.remove_back());
+            EXPECT_EQ(std::to_string(i), vector.back());
+            vector.remove_back();
         }
     });
     EXPECT_THROW(vector.front(), std::out_of_range);
     EXPECT_THROW(vector.back(), std::out_of_range);
 
     insert_n(vector, scale);
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), vector.at(i));
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), vector[i]);
     EXPECT_THROW(vector.at(scale), std::out_of_range);
+    EXPECT_THROW(vector.at(-1), std::out_of_range);
 }
 
 TEST_F(TestVector, Iterators)
@@ -81,45 +138,35 @@ TEST_F(TestVector, Iterators)
     auto bg = vector.begin();
     auto ed = vector.end();
 
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), bg[i]);
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), *(bg + i));
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), *(ed - scale + i));
-
-    for (int i = 0; i < scale; ++i)
-    {
-        auto it = vector.begin();
-        it += i;
-        EXPECT_EQ(std::to_string(i), *it);
-    }
-    for (int i = 0; i < scale; ++i)
-    {
-        auto it = vector.end();
-        it -= (scale - i);
-        EXPECT_EQ(std::to_string(i), *it);
-    }
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
     {
         auto it = bg + i;
-        EXPECT_EQ(i, it - bg);
+        EXPECT_EQ(ptrdiff_t(i), it - bg);
     }
 
-    for (int i = 0; i < scale; ++i)
+    for (size_t i = 0; i < scale; ++i)
         EXPECT_EQ(std::to_string(i), *bg++);
     EXPECT_EQ(bg, vector.end());
-    for (int i = scale - 1; i >= 0; --i)
+    for (size_t i = scale; i-- > 0; )
         EXPECT_EQ(std::to_string(i), *--ed);
     EXPECT_EQ(ed, vector.begin());
 
+    size_t i = scale;
+    for (auto it = vector.crbegin(); it != vector.crend(); ++it)
+        EXPECT_EQ(std::to_string(--i), *it);
 }
 
 TEST_F(TestVector, Capacity)
 {
     EXPECT_TRUE(vector.empty());
-    EXPECT_EQ(0, vector.size());
-    EXPECT_EQ(10, vector.capacity());
+    EXPECT_EQ(size_t(0), vector.size());
+    EXPECT_EQ(size_t(10), vector.capacity());
 
     insert_n(vector, scale);
     EXPECT_EQ(scale, vector.size());
@@ -128,6 +175,20 @@ TEST_F(TestVector, Capacity)
 
     remove_n(vector, scale);
     EXPECT_TRUE(vector.empty());
+
+    vector.resize(scale);
+    EXPECT_EQ(scale, vector.size());
+    EXPECT_EQ("", vector.back());
+    vector.resize(scale * 2, "x");
+    EXPECT_EQ(scale * 2, vector.size());
+    EXPECT_EQ("", vector[scale - 1]);
+    EXPECT_EQ("x", vector[scale]);
+    vector.resize(1);
+    EXPECT_EQ(size_t(1), vector.size());
+    // 新增元素的值引用Vector中的元素
+    vector[0] = "y";
+    vector.resize(scale * 4, vector[0]);
+    EXPECT_EQ("y", vector.back());
 }
 
 TEST_F(TestVector, Modifiers)
@@ -135,35 +196,359 @@ TEST_F(TestVector, Modifiers)
     EXPECT_THROW(vector.remove_back(), std::out_of_range);
     EXPECT_NO_THROW({
         insert_n(vector, scale);
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), vector.remove_back());
-
-        for (int i = 0; i < scale; ++i)
-            vector.insert(0, std::to_string(i));
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), vector.remove(0));
-        for (int i = 0; i < scale; ++i)
-            vector.insert(i, std::to_string(i));
-        for (int i = scale - 1; i >= 0; --i)
-            EXPECT_EQ(std::to_string(i), vector.remove(i));
+        for (size_t i = scale; i-- > 0; )
+        {
+            EXPECT_EQ(std::to_string(i), vector.back());
+            vector.remove_back();
+        }
+
+        for (size_t i = 0; i < scale; ++i)
+            vector.insert(vector.begin(), std::to_string(i));
+        for (size_t i = scale; i-- > 0; )
+        {
+            EXPECT_EQ(std::to_string(i), vector.front());
+            vector.remove(vector.begin());
+        }
+        for (size_t i = 0; i < scale; ++i)
+            vector.insert(vector.begin() + i, std::to_string(i));
+        for (size_t i = scale; i-- > 0; )
+        {
+            EXPECT_EQ(std::to_string(i), vector[i]);
+            vector.remove(vector.begin() + i);
+        }
     });
     EXPECT_THROW(vector.remove_back(), std::out_of_range);
+    EXPECT_THROW(vector.remove(vector.end()), std::out_of_range);
+    EXPECT_THROW(vector.insert(vector.end() + 1, "x"), std::out_of_range);
 
     insert_n(a, scale);
     b = a + c;
     c += b;
-    for (int i = 0; i < scale; ++i)
-        EXPECT_EQ(b.remove_back(), c.remove_back());
+    for (size_t i = 0; i < scale; ++i)
+    {
+        EXPECT_EQ(b.back(), c.back());
+        b.remove_back();
+        c.remove_back();
+    }
 
     insert_n(vector, scale);
     vector.clear();
     EXPECT_TRUE(vector.empty());
     EXPECT_THROW(vector.remove_back(), std::out_of_range);
 
+    insert_n(vector, scale);
     c.swap(vector);
+    EXPECT_TRUE(vector.empty());
     EXPECT_EQ(scale, c.size());
-    for (int i = scale - 1; i >= 0; --i)
-        EXPECT_EQ(std::to_string(i), c.remove_back());
+    for (size_t i = scale; i-- > 0; )
+    {
+        EXPECT_EQ(std::to_string(i), c.back());
+        c.remove_back();
+    }
+
+    // 添加的元素引用Vector中的元素，扩容时仍然有效
+    Vector<string> x(1);
+    x.insert_back("0");
+    for (size_t i = 0; i < scale; ++i)
+        x.insert_back(x[0]);
+    for (size_t i = 0; i < scale; ++i)
+        x.insert(x.begin() + 1, x.back());
+    x.emplace_back(3, 'a');
+    EXPECT_EQ(scale * 2 + 2, x.size());
+    EXPECT_EQ("0", x[scale]);
+    EXPECT_EQ("aaa", x.back());
+}
+
+TEST_F(TestVector, RawStorage)
+{
+    Counted::constructed = 0;
+    Counted::destroyed = 0;
+    {
+        // 只分配容量，不构造元素
+        Vector<Counted> x(1000);
+        EXPECT_EQ(size_t(0), Counted::constructed);
+        x.emplace_back(1);
+        x.insert_back(Counted(2));
+        EXPECT_EQ(size_t(3), Counted::constructed);
+        EXPECT_EQ(size_t(1), Counted::destroyed);
+
+        // 扩容只移动已构造的元素
+        Vector<Counted> y(1);
+        for (size_t i = 0; i < scale; ++i)
+            y.emplace_back(i);
+        EXPECT_EQ(3 + scale + (scale - 1), Counted::constructed);
+
+        size_t constructed = Counted::constructed;
+        size_t destroyed = Counted::destroyed;
+        Vector<Counted> z(y);
+        EXPECT_EQ(constructed + scale, Counted::constructed);
+        z.resize(scale / 2);
+        EXPECT_EQ(destroyed + scale / 2, Counted::destroyed);
+        z.clear();
+        EXPECT_EQ(destroyed + scale, Counted::destroyed);
+        z.resize(3);
+        EXPECT_EQ(constructed + scale + 3, Counted::constructed);
+    }
+    EXPECT_EQ(Counted::constructed, Counted::destroyed);
+}
+
+TEST_F(TestVector, GrowthPolicy)
+{
+    // 预留容量不会减小容量，收缩到元素个数
+    vector.reserve(scale * 4);
+    EXPECT_EQ(scale * 4, vector.capacity());
+    vector.reserve(scale);
+    EXPECT_EQ(scale * 4, vector.capacity());
+    insert_n(vector, scale);
+    vector.shrink_to_fit();
+    EXPECT_EQ(scale, vector.capacity());
+    vector.clear();
+    vector.shrink_to_fit();
+    EXPECT_EQ(size_t(0), vector.capacity());
+    vector.insert_back("0");
+    EXPECT_EQ(size_t(10), vector.capacity());
+
+    // 默认策略在元素个数降到1/4容量时收缩到一半，但不小于最小容量
+    Vector<int> x;
+    for (size_t i = 0; i < 80; ++i)
+        x.insert_back(i);
+    EXPECT_EQ(size_t(80), x.capacity());
+    remove_n(x, 60);
+    EXPECT_EQ(size_t(40), x.capacity());
+    remove_n(x, 20);
+    EXPECT_EQ(size_t(10), x.capacity());
+
+    // 从不收缩的策略
+    Vector<int, cpplib::NeverShrink> y;
+    for (size_t i = 0; i < 80; ++i)
+        y.insert_back(i);
+    remove_n(y, 80);
+    EXPECT_EQ(size_t(80), y.capacity());
+    y.shrink_to_fit();
+    EXPECT_EQ(size_t(0), y.capacity());
+
+    // 1.5倍扩容，最小容量为4，降到1/8容量时收缩
+    Vector<int, cpplib::GrowthFactor<3, 2, 4, 8>> z;
+    EXPECT_EQ(size_t(4), z.capacity());
+    for (size_t i = 0; i < 5; ++i)
+        z.insert_back(i);
+    EXPECT_EQ(size_t(6), z.capacity());
+    for (size_t i = 5; i < 20; ++i)
+        z.insert_back(i);
+    EXPECT_EQ(size_t(28), z.capacity());
+    remove_n(z, 16);
+    EXPECT_EQ(size_t(28), z.capacity());
+    z.remove_back();
+    EXPECT_EQ(size_t(14), z.capacity());
+    for (size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(int(i), z[i]);
+}
+
+TEST_F(TestVector, Relocation)
+{
+    // 扩容按字节搬移，不调用移动构造
+    Relocatable::moved = 0;
+    Vector<Relocatable> x(1);
+    for (size_t i = 0; i < scale; ++i)
+        x.emplace_back(i);
+    for (size_t i = 0; i < scale; ++i)
+        x.insert_back(x[i]);
+    EXPECT_EQ(0, Relocatable::moved);
+    for (size_t i = 0; i < scale * 2; ++i)
+        EXPECT_EQ(int(i % scale), *x[i].p);
+    remove_n(x, scale * 2 - 1);
+    EXPECT_EQ(0, *x.back().p);
+    Vector<Relocatable> y(x);
+    EXPECT_EQ(0, *y.front().p);
+
+    // 大于映射阈值的空间在映射空间和普通空间之间转换
+    Vector<int> z;
+    size_t count = (1 << 23) + 1;
+    for (size_t i = 0; i < count; ++i)
+        z.insert_back(i);
+    EXPECT_EQ(count, z.size());
+    z.resize(count * 2, -1);
+    EXPECT_EQ(int(count - 1), z[count - 1]);
+    EXPECT_EQ(-1, z.back());
+    remove_n(z, count * 2 - scale);
+    EXPECT_GE(scale * 4, z.capacity());
+    for (size_t i = 0; i < scale; ++i)
+        EXPECT_EQ(int(i), z[i]);
+}
+
+TEST_F(TestVector, Alignment)
+{
+    // 容量按向量通道数向上取整
+    AlignedVector<float, 32> x;
+    EXPECT_EQ(size_t(8), (AlignedVector<float, 32>::LANES));
+    EXPECT_EQ(size_t(16), x.capacity());
+    EXPECT_TRUE(is_aligned(x, 32));
+    for (size_t i = 0; i < scale * 3 + 1; ++i)
+    {
+        x.insert_back(float(i));
+        EXPECT_TRUE(is_aligned(x, 32));
+        EXPECT_EQ(size_t(0), x.capacity() % 8);
+    }
+    remove_n(x, scale * 3);
+    EXPECT_EQ(0.0f, x[0]);
+    x.shrink_to_fit();
+    EXPECT_EQ(size_t(8), x.capacity());
+    EXPECT_TRUE(is_aligned(x, 32));
+    AlignedVector<float, 32> y(x);
+    EXPECT_TRUE(is_aligned(y, 32));
+    EXPECT_TRUE(x == y);
+
+    AlignedVector<int> z(1);
+    EXPECT_EQ(size_t(16), z.capacity());
+    z.resize(100, 7);
+    EXPECT_EQ(size_t(0), z.capacity() % 16);
+    EXPECT_TRUE(is_aligned(z, 64));
+    EXPECT_EQ(7, z[99]);
+
+    // 按页对齐，超过映射阈值时使用映射空间
+    AlignedVector<uint8_t, 4096> p;
+    EXPECT_EQ(size_t(4096), p.capacity());
+    EXPECT_TRUE(is_aligned(p, 4096));
+    p.resize((1 << 25) + 1, 1);
+    EXPECT_TRUE(is_aligned(p, 4096));
+    EXPECT_EQ(size_t(0), p.capacity() % 4096);
+    p.resize(10);
+    p.shrink_to_fit();
+    EXPECT_TRUE(is_aligned(p, 4096));
+    EXPECT_EQ(1, p[9]);
+
+    // 不能平凡重定位的元素也按要求对齐
+    AlignedVector<string, 128> s;
+    insert_n(s, scale);
+    EXPECT_TRUE(is_aligned(s, 128));
+    for (size_t i = 0; i < scale; ++i)
+        EXPECT_EQ(std::to_string(i), s[i]);
+}
+
+TEST_F(TestVector, Algorithms)
+{
+    EXPECT_THROW(Vector<int>().min(), std::out_of_range);
+    EXPECT_THROW(Vector<int>().max(), std::out_of_range);
+    EXPECT_EQ(0LL, Vector<int>().sum());
+
+    Vector<int> x;
+    for (size_t i = 0; i < scale * 3; ++i)
+        x.insert_back(int(i % scale) - 8);
+    EXPECT_EQ(x.begin() + 8, x.find(0));
+    EXPECT_EQ(x.end(), x.find(-100));
+    EXPECT_EQ(size_t(3), x.count(0));
+    EXPECT_EQ(-8, x.min());
+    EXPECT_EQ(int(scale) - 9, x.max());
+    EXPECT_EQ(3LL * (int(scale) * int(scale - 1) / 2 - 8 * int(scale)), x.sum());
+    *x.find(0) = 1;
+    EXPECT_EQ(size_t(2), x.count(0));
+    Vector<int> y(x);
+    EXPECT_TRUE(x == y);
+    y[scale * 3 - 1] = 0;
+    EXPECT_TRUE(x != y);
+
+    AlignedVector<uint8_t, 32> z;
+    for (size_t i = 0; i < scale * 4; ++i)
+        z.insert_back(255);
+    EXPECT_EQ(255ULL * scale * 4, z.sum());
+    EXPECT_EQ(scale * 4, z.count(255));
+
+    insert_n(vector, scale);
+    EXPECT_EQ(vector.begin() + 5, vector.find("5"));
+    EXPECT_EQ(size_t(1), vector.count("31"));
+    EXPECT_EQ("0", vector.min());
+    EXPECT_EQ("9", vector.max());
+}
+
+TEST_F(TestVector, RangeInsert)
+{
+    // 前向迭代器范围，在头部、中间和尾部添加
+    std::list<string> l = {"a", "b", "c"};
+    insert_n(vector, 4);
+    EXPECT_EQ(vector.begin(), vector.insert(vector.begin(), l.begin(), l.end()));
+    EXPECT_EQ(vector.begin() + 7, vector.insert(vector.end(), l.begin(), l.end()));
+    EXPECT_EQ(vector.begin() + 5, vector.insert(vector.begin() + 5, l.begin(), l.end()));
+    EXPECT_EQ(vector.begin() + 1, vector.insert(vector.begin() + 1, l.begin(), l.begin()));
+    EXPECT_EQ(vector.begin() + 11, vector.insert(vector.end() - 2, l.begin(), l.end()));
+    std::ostringstream os;
+    os << vector;
+    EXPECT_EQ("a b c 0 1 a b c 2 3 a a b c b c ", os.str());
+    EXPECT_THROW(vector.insert(vector.end() + 1, l.begin(), l.end()), std::out_of_range);
+
+    // 单遍输入迭代器范围
+    std::istringstream is("4 5 6");
+    Vector<int> x;
+    x.insert_back(1);
+    x.insert_back(2);
+    x.insert(x.begin() + 1, std::istream_iterator<int>(is), std::istream_iterator<int>());
+    EXPECT_EQ(size_t(5), x.size());
+    EXPECT_EQ(4, x[1]);
+    EXPECT_EQ(2, x.back());
+    int a[] = {7, 8, 9};
+    x.append(a, a + 3);
+    x.append(std::begin(a), std::begin(a));
+    EXPECT_EQ(size_t(8), x.size());
+    EXPECT_EQ(9, x.back());
+
+    // 反复添加按增长策略扩容，容量足够时不重新分配
+    Vector<int> chunk;
+    for (int i = 0; i < 7; ++i)
+        chunk.insert_back(i);
+    Vector<int> y;
+    size_t reallocations = 0;
+    const int* data = y.begin();
+    for (size_t i = 0; i < scale * 32; ++i)
+    {
+        y += chunk;
+        if (y.begin() != data)
+            ++reallocations;
+        data = y.begin();
+    }
+    EXPECT_EQ(scale * 32 * 7, y.size());
+    EXPECT_GE(size_t(12), reallocations);
+    EXPECT_EQ(6, y.back());
+    y += y;
+    EXPECT_EQ(scale * 64 * 7, y.size());
+    EXPECT_EQ(6, y.back());
+}
+
+TEST_F(TestVector, RvalueConcatenation)
+{
+    insert_n(a, scale);
+    insert_n(b, scale);
+    // 移动添加，当前对象为空时接管空间
+    const string* data = b.begin();
+    c += std::move(b);
+    EXPECT_EQ(data, c.begin());
+    EXPECT_TRUE(b.empty());
+    c += std::move(a);
+    EXPECT_EQ(scale * 2, c.size());
+    EXPECT_EQ(std::to_string(scale - 1), c.back());
+    EXPECT_TRUE(a.empty());
+
+    // 临时对象复用自身的空间
+    insert_n(a, 3);
+    Vector<string> d(scale * 4);
+    insert_n(d, 3);
+    data = d.begin();
+    Vector<string> e = std::move(d) + a;
+    EXPECT_EQ(data, e.begin());
+    EXPECT_EQ(size_t(6), e.size());
+    Vector<string> f(scale * 4);
+    insert_n(f, 2);
+    data = f.begin();
+    Vector<string> g = a + std::move(f);
+    EXPECT_EQ(data, g.begin());
+    std::ostringstream os;
+    os << g;
+    EXPECT_EQ("0 1 2 0 1 ", os.str());
+    data = g.begin();
+    Vector<string> h = std::move(g) + std::move(e);
+    EXPECT_EQ(data, h.begin());
+    EXPECT_EQ(size_t(11), h.size());
+    Vector<string> k = a + a;
+    EXPECT_EQ(size_t(6), k.capacity());
+    EXPECT_EQ("2", k.back());
 }
 
 TEST_F(TestVector, Other)
@@ -176,4 +561,11 @@ TEST_F(TestVector, Other)
     EXPECT_TRUE(c != a && c == b);
     swap(a, b);
     EXPECT_TRUE(c == a && c != b);
-}
\ No newline at end of file
+
+    std::ostringstream os;
+    Vector<int> x;
+    x.insert_back(1);
+    x.insert_back(2);
+    os << x;
+    EXPECT_EQ("1 2 ", os.str());
+}